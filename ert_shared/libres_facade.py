@@ -66,10 +66,10 @@ class LibresFacade:
         return self._enkf_main.getModelConfig().getRunpathAsString()
 
     def load_from_forward_model(
-        self, case: str, realisations: List[bool], iteration: int
+        self, case: str, realisations: List[bool], iteration: int, force: bool = False
     ) -> int:
         fs = self._enkf_main.getEnkfFsManager().getFileSystem(case)
-        return self._enkf_main.loadFromForwardModel(realisations, iteration, fs)
+        return self._enkf_main.loadFromForwardModel(realisations, iteration, fs, force)
 
     def get_observations(self):
         return self._enkf_main.getObservations()
@@ -163,8 +163,8 @@ class LibresFacade:
 
     def gather_summary_data(self, case, key, realization_index=None):
         """:rtype: pandas.DataFrame"""
-        data = SummaryCollector.loadAllSummaryData(
-            self._enkf_main, case, [key], realization_index
+        data = SummaryCollector.loadSummaryMatrix(
+            self._enkf_main, case, key, realization_index
         )
         if not data.empty:
             idx = data.index.duplicated()
@@ -0,0 +1,115 @@
+#include <random>
+
+#include <Eigen/Dense>
+
+#include <ert/analysis/enkf_linalg.hpp>
+#include <ert/analysis/ies/ies.hpp>
+#include <ert/analysis/ies/ies_config.hpp>
+#include <ert/analysis/ies/ies_data.hpp>
+#include <ert/enkf/row_scaling.hpp>
+
+#include "../benchmark.hpp"
+
+namespace {
+constexpr int ens_size = 100;
+
+Eigen::MatrixXd random_matrix(std::mt19937 &generator, int rows, int cols) {
+    std::normal_distribution<double> normal;
+    Eigen::MatrixXd matrix(rows, cols);
+    for (int col = 0; col < cols; col++)
+        for (int row = 0; row < rows; row++)
+            matrix(row, col) = normal(generator);
+    return matrix;
+}
+
+/** The matrices of one update step, built as in analysis::smoother_update */
+struct update_fixture {
+    Eigen::MatrixXd A;
+    Eigen::MatrixXd S;
+    Eigen::MatrixXd R;
+    Eigen::MatrixXd E;
+    Eigen::MatrixXd D;
+
+    update_fixture(int parameters, int observations) {
+        std::mt19937 generator(parameters + observations);
+        A = random_matrix(generator, parameters, ens_size);
+        S = random_matrix(generator, observations, ens_size);
+        R = Eigen::MatrixXd::Identity(observations, observations);
+
+        Eigen::VectorXd obs_values = random_matrix(generator, observations, 1);
+        Eigen::VectorXd obs_errors = Eigen::VectorXd::Ones(observations);
+        E = ies::makeE(obs_errors,
+                       random_matrix(generator, observations, ens_size));
+        D = ies::makeD(obs_values, E, S);
+    }
+};
+
+void bench_makeX(ert::benchmark::State &state) {
+    update_fixture fixture(1000, state.size());
+    ies::Config config(false);
+
+    state.measure([&] {
+        Eigen::MatrixXd W0 = Eigen::MatrixXd::Zero(ens_size, ens_size);
+        Eigen::MatrixXd X =
+            ies::makeX(fixture.A, fixture.S, fixture.R, fixture.E, fixture.D,
+                       config.inversion, config.get_truncation(), W0, 1, 1);
+        ert::benchmark::keep(X);
+    });
+}
+
+void bench_updateA(ert::benchmark::State &state) {
+    update_fixture fixture(state.size(), 1000);
+    ies::Config config(true);
+    std::vector<bool> ens_mask(ens_size, true);
+    std::vector<bool> obs_mask(fixture.S.rows(), true);
+
+    state.set_items_processed(state.size() * ens_size);
+    state.measure([&] {
+        ies::Data data(ens_size);
+        ies::init_update(data, ens_mask, obs_mask);
+        Eigen::MatrixXd A = fixture.A;
+        ies::updateA(data, A, fixture.S, fixture.R, fixture.E, fixture.D,
+                     config.inversion, config.get_truncation(),
+                     config.get_steplength(data.iteration_nr));
+        ert::benchmark::keep(A);
+    });
+}
+
+void bench_lowrankE(ert::benchmark::State &state) {
+    update_fixture fixture(1, state.size());
+    const std::variant<double, int> truncation = 0.98;
+
+    state.measure([&] {
+        Eigen::MatrixXd W;
+        Eigen::VectorXd eig;
+        enkf_linalg_lowrankE(fixture.S, fixture.E, W, eig, truncation);
+        ert::benchmark::keep(W);
+    });
+}
+
+void bench_row_scaling_multiply(ert::benchmark::State &state) {
+    std::mt19937 generator(state.size());
+    Eigen::MatrixXd A0 = random_matrix(generator, state.size(), ens_size);
+    Eigen::MatrixXd X0 = Eigen::MatrixXd::Identity(ens_size, ens_size) +
+                         0.1 * random_matrix(generator, ens_size, ens_size);
+
+    RowScaling row_scaling;
+    std::uniform_real_distribution<double> uniform(0, 1);
+    for (int row = 0; row < state.size(); row++)
+        row_scaling.assign(row, uniform(generator));
+
+    Eigen::MatrixXd A;
+    state.set_items_processed(state.size() * ens_size);
+    state.measure([&] {
+        A = A0;
+        row_scaling.multiply(A, X0);
+        ert::benchmark::keep(A);
+    });
+}
+} // namespace
+
+ERT_BENCHMARK("ies/makeX", bench_makeX, 100, 1000, 5000);
+ERT_BENCHMARK("ies/updateA", bench_updateA, 1000, 10000, 100000);
+ERT_BENCHMARK("enkf_linalg/lowrankE", bench_lowrankE, 100, 1000, 5000);
+ERT_BENCHMARK("row_scaling/multiply", bench_row_scaling_multiply, 1000, 10000,
+              100000);
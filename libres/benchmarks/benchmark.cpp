@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <numeric>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/os.h>
+
+#include "benchmark.hpp"
+
+namespace fs = std::filesystem;
+
+namespace ert::benchmark {
+namespace {
+/** Batches shorter than this are not recorded, but repeated with more calls */
+constexpr std::chrono::milliseconds min_batch_time{10};
+constexpr int min_samples = 3;
+
+struct benchmark_type {
+    std::string name;
+    benchmark_func *func;
+    std::vector<std::int64_t> sizes;
+};
+
+std::vector<benchmark_type> &registry() {
+    static std::vector<benchmark_type> benchmarks;
+    return benchmarks;
+}
+
+struct result_type {
+    std::string name;
+    std::int64_t size;
+    std::int64_t iterations;
+    double mean;
+    double median;
+    double min;
+    double max;
+    std::int64_t bytes;
+    std::int64_t items;
+};
+
+result_type run(const benchmark_type &benchmark, std::int64_t size,
+                std::chrono::nanoseconds min_time,
+                const fs::path &scratch_root) {
+    fs::path scratch_dir = scratch_root / fmt::format("{}", size);
+    fs::create_directories(scratch_dir);
+    State state(size, min_time, scratch_dir);
+    benchmark.func(state);
+    fs::remove_all(scratch_dir);
+
+    std::vector<double> samples = state.samples();
+    if (samples.empty())
+        throw std::logic_error("The benchmark " + benchmark.name +
+                               " never called measure()");
+
+    std::sort(samples.begin(), samples.end());
+    double mean = std::accumulate(samples.begin(), samples.end(), 0.0) /
+                  samples.size();
+    double median = samples[samples.size() / 2];
+    if (samples.size() % 2 == 0)
+        median = (median + samples[samples.size() / 2 - 1]) / 2;
+
+    return {benchmark.name,
+            size,
+            state.iterations(),
+            mean,
+            median,
+            samples.front(),
+            samples.back(),
+            state.bytes_processed(),
+            state.items_processed()};
+}
+
+std::string json_string(const std::string &value) {
+    std::string json = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\')
+            json += '\\';
+        json += c;
+    }
+    return json + "\"";
+}
+
+std::string json_result(const result_type &result) {
+    std::string json = fmt::format(
+        "{{\"name\": {}, \"size\": {}, \"iterations\": {}, "
+        "\"mean_ns\": {:.1f}, \"median_ns\": {:.1f}, \"min_ns\": {:.1f}, "
+        "\"max_ns\": {:.1f}",
+        json_string(result.name), result.size, result.iterations, result.mean,
+        result.median, result.min, result.max);
+    if (result.bytes > 0)
+        json += fmt::format(", \"bytes_per_second\": {:.1f}",
+                            result.bytes * 1e9 / result.mean);
+    if (result.items > 0)
+        json += fmt::format(", \"items_per_second\": {:.1f}",
+                            result.items * 1e9 / result.mean);
+    return json + "}";
+}
+
+std::string json_report(const std::vector<result_type> &results,
+                        std::chrono::nanoseconds min_time) {
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof date, "%Y-%m-%dT%H:%M:%S", std::gmtime(&now));
+
+    std::string json = "{\n  \"context\": {";
+    json += fmt::format("\"date\": \"{}\", \"hardware_concurrency\": {}, "
+                        "\"min_time_ns\": {}",
+                        date, std::thread::hardware_concurrency(),
+                        min_time.count());
+    json += "},\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++)
+        json += (i == 0 ? "\n    " : ",\n    ") + json_result(results[i]);
+    return json + "\n  ]\n}\n";
+}
+
+void usage(const char *program) {
+    fmt::print(stderr,
+               "Usage: {} [--filter REGEX] [--min-time SECONDS] "
+               "[--output FILE] [--list]\n\n"
+               "Runs the benchmarks whose name matches REGEX, each for at "
+               "least SECONDS (default 0.5) per size, and writes the results "
+               "as JSON to FILE or stdout.\n",
+               program);
+}
+} // namespace
+
+int State::record_batch(int batch_size, clock::duration elapsed) {
+    if (elapsed < min_batch_time && m_samples.empty())
+        return elapsed * 10 < min_batch_time ? batch_size * 10 : batch_size * 2;
+
+    m_samples.push_back(
+        std::chrono::duration<double, std::nano>(elapsed).count() / batch_size);
+    m_iterations += batch_size;
+    m_total_time += elapsed;
+
+    bool done = m_total_time >= m_min_time && m_samples.size() >= min_samples;
+    // Slow benchmarks stop at a fixed multiple of the minimum time
+    if (done || m_total_time >= 10 * m_min_time)
+        return 0;
+    return batch_size;
+}
+
+int register_benchmark(const char *name, benchmark_func *func,
+                       const std::vector<std::int64_t> &sizes) {
+    registry().push_back({name, func, sizes});
+    return registry().size();
+}
+} // namespace ert::benchmark
+
+int main(int argc, char **argv) {
+    using namespace ert::benchmark;
+
+    std::regex filter(".*");
+    std::chrono::nanoseconds min_time = std::chrono::milliseconds(500);
+    std::string output;
+    bool list = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value)
+            filter = std::regex(argv[++i]);
+        else if (arg == "--min-time" && has_value)
+            min_time = std::chrono::nanoseconds(
+                static_cast<std::int64_t>(std::atof(argv[++i]) * 1e9));
+        else if (arg == "--output" && has_value)
+            output = argv[++i];
+        else if (arg == "--list")
+            list = true;
+        else {
+            usage(argv[0]);
+            return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    fs::path scratch_root = fs::temp_directory_path() /
+                            fmt::format("ert_benchmarks-{}", now.count());
+
+    auto &benchmarks = registry();
+    std::sort(benchmarks.begin(), benchmarks.end(),
+              [](const auto &a, const auto &b) { return a.name < b.name; });
+
+    std::vector<result_type> results;
+    for (const auto &benchmark : benchmarks) {
+        if (!std::regex_search(benchmark.name, filter))
+            continue;
+
+        if (list) {
+            fmt::print("{}\n", benchmark.name);
+            continue;
+        }
+
+        for (auto size : benchmark.sizes) {
+            fmt::print(stderr, "{}/{} ...", benchmark.name, size);
+            std::fflush(stderr);
+            results.push_back(run(benchmark, size, min_time, scratch_root));
+            fmt::print(stderr, " {:.0f} ns\n", results.back().median);
+        }
+    }
+    fs::remove_all(scratch_root);
+    if (list)
+        return EXIT_SUCCESS;
+
+    std::string report = json_report(results, min_time);
+    if (output.empty())
+        fmt::print("{}", report);
+    else
+        fmt::output_file(output).print("{}", report);
+    return EXIT_SUCCESS;
+}
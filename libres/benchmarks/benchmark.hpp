@@ -0,0 +1,98 @@
+#ifndef __BENCHMARK_HPP__
+#define __BENCHMARK_HPP__
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * A minimal harness for timing the C++ core without the Python bindings.
+ *
+ * A benchmark is a function taking a State. It builds its fixture for
+ * state.size(), which must be deterministic, and then passes the operation
+ * to be timed to state.measure():
+ *
+ *     void bench_something(ert::benchmark::State &state) {
+ *         auto input = make_input(state.size());
+ *         state.measure([&] { ert::benchmark::keep(process(input)); });
+ *     }
+ *     ERT_BENCHMARK("something", bench_something, 10, 1000);
+ *
+ * The benchmark is run once for every size, and the results are written as
+ * JSON by the ert_benchmarks executable.
+ */
+namespace ert::benchmark {
+
+class State {
+public:
+    State(std::int64_t size, std::chrono::nanoseconds min_time,
+          const std::filesystem::path &scratch_dir)
+        : m_size(size), m_min_time(min_time), m_scratch_dir(scratch_dir) {}
+
+    std::int64_t size() const { return m_size; }
+
+    /** An empty directory which is removed after the benchmark has run. */
+    const std::filesystem::path &scratch_dir() const { return m_scratch_dir; }
+
+    /**
+     * Runs @body repeatedly, in batches of increasing size until a batch
+     * takes a measurable time, and then until the minimum time has passed.
+     * The first call is a warm up and is not recorded.
+     */
+    template <typename Func> void measure(Func &&body) {
+        body();
+        int batch_size = 1;
+        while (batch_size > 0) {
+            auto start = clock::now();
+            for (int i = 0; i < batch_size; i++)
+                body();
+            batch_size = record_batch(batch_size, clock::now() - start);
+        }
+    }
+
+    /** The bytes processed by one call of the measured body. */
+    void set_bytes_processed(std::int64_t bytes) { m_bytes = bytes; }
+    /** The items processed by one call of the measured body. */
+    void set_items_processed(std::int64_t items) { m_items = items; }
+
+    std::int64_t iterations() const { return m_iterations; }
+    std::int64_t bytes_processed() const { return m_bytes; }
+    std::int64_t items_processed() const { return m_items; }
+    /** The time of one iteration in each recorded batch, in nanoseconds. */
+    const std::vector<double> &samples() const { return m_samples; }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    int record_batch(int batch_size, clock::duration elapsed);
+
+    std::int64_t m_size;
+    std::chrono::nanoseconds m_min_time;
+    std::filesystem::path m_scratch_dir;
+
+    std::chrono::nanoseconds m_total_time{0};
+    std::int64_t m_iterations = 0;
+    std::int64_t m_bytes = 0;
+    std::int64_t m_items = 0;
+    std::vector<double> m_samples;
+};
+
+typedef void(benchmark_func)(State &);
+
+int register_benchmark(const char *name, benchmark_func *func,
+                       const std::vector<std::int64_t> &sizes);
+
+/** Prevents the compiler from optimizing away the computation of @value. */
+template <typename T> void keep(const T &value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace ert::benchmark
+
+#define ERT_BENCHMARK(name, func, ...)                                         \
+    static const int func##_registered =                                       \
+        ert::benchmark::register_benchmark(name, func, {__VA_ARGS__})
+
+#endif //__BENCHMARK_HPP__
@@ -0,0 +1,87 @@
+#include <string>
+#include <vector>
+
+#include <ert/util/stringlist.h>
+
+#include <ert/enkf/ext_param.hpp>
+#include <ert/enkf/ext_param_config.hpp>
+
+#include "../benchmark.hpp"
+
+namespace {
+const std::vector<std::string> suffixes = {"A", "B", "C"};
+
+/**
+   state.size() keys, where every fourth key has the suffixes A, B and C,
+   with all the values set.
+*/
+struct ext_param_fixture {
+    ext_param_config_type *config;
+    ext_param_type *param;
+    std::vector<std::string> keys;
+
+    explicit ext_param_fixture(int size) {
+        stringlist_type *key_list = stringlist_alloc_new();
+        for (int ikey = 0; ikey < size; ikey++) {
+            keys.push_back("KEY" + std::to_string(ikey));
+            stringlist_append_copy(key_list, keys.back().c_str());
+        }
+        config = ext_param_config_alloc("CONTROLS", key_list);
+        stringlist_free(key_list);
+
+        stringlist_type *suffix_list = stringlist_alloc_new();
+        for (const auto &suffix : suffixes)
+            stringlist_append_copy(suffix_list, suffix.c_str());
+        for (int ikey = 0; ikey < size; ikey += 4)
+            ext_param_config_ikey_set_suffixes(config, ikey, suffix_list);
+        stringlist_free(suffix_list);
+
+        param = ext_param_alloc(config);
+        set_by_key();
+    }
+
+    ~ext_param_fixture() {
+        ext_param_free(param);
+        ext_param_config_free(config);
+    }
+
+    /** Sets every value by key and suffix; returns the number of values */
+    int set_by_key() {
+        int count = 0;
+        for (size_t ikey = 0; ikey < keys.size(); ikey++) {
+            if (ikey % 4 == 0)
+                for (const auto &suffix : suffixes)
+                    count += ext_param_key_suffix_set(
+                        param, keys[ikey].c_str(), suffix.c_str(), ikey);
+            else
+                count += ext_param_key_set(param, keys[ikey].c_str(), ikey);
+        }
+        return count;
+    }
+};
+
+/** Every value set through ext_param_key_set() and its suffix variant */
+void bench_key_set(ert::benchmark::State &state) {
+    ext_param_fixture fixture(state.size());
+
+    state.set_items_processed(fixture.set_by_key());
+    state.measure([&] { ert::benchmark::keep(fixture.set_by_key()); });
+}
+
+/** ext_param_set_from_json() of a file with all the values */
+void bench_set_from_json(ert::benchmark::State &state) {
+    ext_param_fixture fixture(state.size());
+    auto json_file = (state.scratch_dir() / "controls.json").string();
+    ext_param_json_export(fixture.param, json_file.c_str());
+
+    state.set_items_processed(fixture.set_by_key());
+    state.measure([&] {
+        ert::benchmark::keep(
+            ext_param_set_from_json(fixture.param, json_file.c_str()));
+    });
+}
+} // namespace
+
+ERT_BENCHMARK("ext_param/key_set", bench_key_set, 5000, 20000, 80000);
+ERT_BENCHMARK("ext_param/set_from_json", bench_set_from_json, 5000, 20000,
+              80000);
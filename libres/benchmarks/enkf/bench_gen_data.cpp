@@ -0,0 +1,34 @@
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include <ert/enkf/gen_common.hpp>
+
+#include "../benchmark.hpp"
+
+namespace {
+/** Parses an ASCII GEN_DATA result file with state.size() values */
+void bench_gen_data_parse(ert::benchmark::State &state) {
+    std::string file = (state.scratch_dir() / "gen_data_0.txt").string();
+    {
+        std::mt19937 generator(state.size());
+        std::normal_distribution<double> normal;
+        std::ofstream stream{file};
+        for (int i = 0; i < state.size(); i++)
+            stream << normal(generator) << "\n";
+    }
+
+    state.set_items_processed(state.size());
+    state.measure([&] {
+        int size = 0;
+        ecl_type_enum load_type;
+        void *values = gen_common_fload_alloc(file.c_str(), ASCII, ECL_DOUBLE,
+                                              &load_type, &size);
+        ert::benchmark::keep(values);
+        free(values);
+    });
+}
+} // namespace
+
+ERT_BENCHMARK("gen_data/parse", bench_gen_data_parse, 100, 10000, 1000000);
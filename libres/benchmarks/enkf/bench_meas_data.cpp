@@ -0,0 +1,38 @@
+#include <random>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include <ert/enkf/meas_data.hpp>
+
+#include "../benchmark.hpp"
+
+namespace {
+constexpr int ens_size = 100;
+constexpr int block_size = 10;
+
+/** Measured data for state.size() observations in blocks of block_size */
+void bench_makeS(ert::benchmark::State &state) {
+    std::vector<bool> ens_mask(ens_size, true);
+    meas_data_type *meas_data = meas_data_alloc(ens_mask);
+
+    std::mt19937 generator(state.size());
+    std::normal_distribution<double> normal;
+    for (int block = 0; block < state.size() / block_size; block++) {
+        meas_block_type *meas_block =
+            meas_data_add_block(meas_data, "OBS", block, block_size);
+        for (int iobs = 0; iobs < block_size; iobs++)
+            for (int iens = 0; iens < ens_size; iens++)
+                meas_block_iset(meas_block, iens, iobs, normal(generator));
+    }
+
+    state.set_items_processed(state.size() * ens_size);
+    state.measure([&] {
+        Eigen::MatrixXd S = meas_data_makeS(meas_data);
+        ert::benchmark::keep(S);
+    });
+    meas_data_free(meas_data);
+}
+} // namespace
+
+ERT_BENCHMARK("meas_data/makeS", bench_makeS, 100, 1000, 10000);
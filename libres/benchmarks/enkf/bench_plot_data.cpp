@@ -0,0 +1,76 @@
+#include <vector>
+
+#include <ert/enkf/enkf_config_node.hpp>
+#include <ert/enkf/enkf_fs.hpp>
+#include <ert/enkf/enkf_node.hpp>
+#include <ert/enkf/enkf_plot_data.hpp>
+#include <ert/enkf/ensemble_config.hpp>
+#include <ert/enkf/summary.hpp>
+
+#include "../benchmark.hpp"
+
+namespace {
+constexpr int step_count = 500;
+
+/** A summary vector of step_count steps for state.size() realizations */
+struct plot_data_fixture {
+    enkf_fs_type *fs;
+    ensemble_config_type *ensemble_config;
+    enkf_config_node_type *config_node;
+
+    explicit plot_data_fixture(ert::benchmark::State &state) {
+        auto mount_point = state.scratch_dir() / "storage";
+        fs = enkf_fs_create_fs(mount_point.c_str(), BLOCK_FS_DRIVER_ID, true);
+        ensemble_config = ensemble_config_alloc_full("name");
+        config_node = ensemble_config_add_summary(ensemble_config, "FOPR",
+                                                  LOAD_FAIL_SILENT);
+
+        time_map_type *time_map = enkf_fs_get_time_map(fs);
+        for (int step = 0; step < step_count; step++)
+            time_map_update(time_map, step, 1000000 + step * 86400);
+
+        state_map_type *state_map = enkf_fs_get_state_map(fs);
+        for (int iens = 0; iens < state.size(); iens++) {
+            enkf_node_type *node = enkf_node_alloc(config_node);
+            auto *summary =
+                static_cast<summary_type *>(enkf_node_value_ptr(node));
+            for (int step = 0; step < step_count; step++)
+                summary_set(summary, step, iens + step * 0.5);
+            enkf_node_store_vector(node, fs, iens);
+            enkf_node_free(node);
+            state_map_iset(state_map, iens, STATE_HAS_DATA);
+        }
+    }
+
+    ~plot_data_fixture() {
+        ensemble_config_free(ensemble_config);
+        enkf_fs_decref(fs);
+    }
+};
+
+/** One enkf_plot_tvector per realization, loaded serially */
+void bench_load(ert::benchmark::State &state) {
+    plot_data_fixture fixture(state);
+    enkf_plot_data_type *plot_data = enkf_plot_data_alloc(fixture.config_node);
+
+    state.set_items_processed(state.size() * step_count);
+    state.measure([&] { enkf_plot_data_load(plot_data, fixture.fs, NULL); });
+    enkf_plot_data_free(plot_data);
+}
+
+/** The [realization x step] matrix, loaded by a pool of threads */
+void bench_load_matrix(ert::benchmark::State &state) {
+    plot_data_fixture fixture(state);
+    std::vector<double> matrix(state.size() * step_count);
+
+    state.set_items_processed(state.size() * step_count);
+    state.measure([&] {
+        enkf_plot_data_load_matrix(fixture.config_node, fixture.fs, NULL,
+                                   matrix.data());
+        ert::benchmark::keep(matrix);
+    });
+}
+} // namespace
+
+ERT_BENCHMARK("plot_data/load", bench_load, 10, 100);
+ERT_BENCHMARK("plot_data/load_matrix", bench_load_matrix, 10, 100);
@@ -0,0 +1,89 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ert/util/stringlist.h>
+
+#include <ert/enkf/trans_func.hpp>
+
+#include "../benchmark.hpp"
+
+namespace {
+constexpr int parameter_count = 1000;
+
+/**
+   parameter_count GEN_KW parameters, cycling through the distributions,
+   with the values of state.size() realizations for each of them.
+*/
+struct trans_func_fixture {
+    std::vector<trans_func_type *> trans_funcs;
+    std::vector<double> values;
+
+    explicit trans_func_fixture(int ens_size)
+        : values((size_t)parameter_count * ens_size) {
+        const std::vector<std::vector<const char *>> distributions = {
+            {"NORMAL", "0", "1"},
+            {"LOGNORMAL", "1", "0.5"},
+            {"UNIFORM", "0", "1"},
+            {"LOGUNIF", "0.1", "10"},
+            {"TRIANGULAR", "0", "1", "3"},
+            {"ERRF", "0", "1", "0", "1"},
+            {"DERRF", "5", "0", "1", "0", "1"},
+            {"TRUNCATED_NORMAL", "0", "1", "-1", "1"}};
+        for (int i = 0; i < parameter_count; i++) {
+            stringlist_type *args = stringlist_alloc_new();
+            for (const char *arg : distributions[i % distributions.size()])
+                stringlist_append_copy(args, arg);
+            trans_funcs.push_back(trans_func_alloc(args));
+            stringlist_free(args);
+        }
+
+        std::mt19937 generator(ens_size);
+        std::normal_distribution<double> normal;
+        for (auto &value : values)
+            value = normal(generator);
+    }
+
+    ~trans_func_fixture() {
+        for (auto *trans_func : trans_funcs)
+            trans_func_free(trans_func);
+    }
+};
+
+/** One trans_func_eval() call per parameter and realization */
+void bench_eval(ert::benchmark::State &state) {
+    trans_func_fixture fixture(state.size());
+    std::vector<double> result(fixture.values.size());
+
+    state.set_items_processed(fixture.values.size());
+    state.measure([&] {
+        for (int i = 0; i < parameter_count; i++)
+            for (int iens = 0; iens < state.size(); iens++) {
+                size_t index = (size_t)i * state.size() + iens;
+                result[index] = trans_func_eval(fixture.trans_funcs[i],
+                                                fixture.values[index]);
+            }
+        ert::benchmark::keep(result);
+    });
+}
+
+/** One trans_func_eval_many() call per parameter for the whole ensemble */
+void bench_eval_many(ert::benchmark::State &state) {
+    trans_func_fixture fixture(state.size());
+    std::vector<double> result(fixture.values.size());
+
+    state.set_items_processed(fixture.values.size());
+    state.measure([&] {
+        for (int i = 0; i < parameter_count; i++) {
+            size_t offset = (size_t)i * state.size();
+            trans_func_eval_many(fixture.trans_funcs[i],
+                                 fixture.values.data() + offset,
+                                 result.data() + offset, state.size());
+        }
+        ert::benchmark::keep(result);
+    });
+}
+} // namespace
+
+ERT_BENCHMARK("trans_func/eval", bench_eval, 100, 10000);
+ERT_BENCHMARK("trans_func/eval_many", bench_eval_many, 100, 10000);
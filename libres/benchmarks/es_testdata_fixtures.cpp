@@ -0,0 +1,75 @@
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <ert/res_util/es_testdata.hpp>
+
+namespace fs = std::filesystem;
+
+namespace {
+const int ens_sizes[] = {100, 1000};
+const int state_sizes[] = {1000, 10000, 100000};
+
+void usage(const char *program) {
+    fmt::print(stderr,
+               "Usage: {} OUTPUT_DIR [--obs-size N] [--text]\n\n"
+               "Writes es_testdata fixtures for the update benchmarks to "
+               "OUTPUT_DIR/ens_<ENS>-state_<STATE>, for ensemble sizes 100 "
+               "and 1000 and prior state sizes 1000, 10000 and 100000. The "
+               "fixtures have N observations (default 1000) and are written "
+               "in the binary format unless --text is given.\n",
+               program);
+}
+} // namespace
+
+/**
+  The observation error covariance R is dense, obs_size x obs_size, so the
+  fixtures grow to the large sizes through the prior state, which is stored
+  as "prior" in each fixture and loaded with es_testdata::make_state().
+*/
+int main(int argc, char **argv) {
+    std::string output;
+    int obs_size = 1000;
+    auto format = res::es_testdata::format::binary;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--obs-size" && i + 1 < argc)
+            obs_size = std::atoi(argv[++i]);
+        else if (arg == "--text")
+            format = res::es_testdata::format::text;
+        else if (output.empty() && arg[0] != '-')
+            output = arg;
+        else {
+            usage(argv[0]);
+            return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if (output.empty() || obs_size <= 0) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (int ens_size : ens_sizes) {
+        for (int state_size : state_sizes) {
+            auto path = fs::absolute(fs::path(output) /
+                                     fmt::format("ens_{}-state_{}", ens_size,
+                                                 state_size))
+                            .string();
+            auto testdata = res::es_testdata::random(
+                ens_size, obs_size, ens_size + state_size);
+            testdata.save(path, format);
+
+            std::mt19937 generator(state_size);
+            testdata.path = path;
+            testdata.save_matrix("prior",
+                                 res::es_testdata::random_matrix(
+                                     state_size, ens_size, generator),
+                                 format);
+            fmt::print("{}\n", path);
+        }
+    }
+    return EXIT_SUCCESS;
+}
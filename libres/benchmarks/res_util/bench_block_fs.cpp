@@ -0,0 +1,84 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ert/res_util/block_fs.hpp>
+#include <ert/util/buffer.h>
+
+#include "../benchmark.hpp"
+
+namespace {
+constexpr int fsync_interval = 10;
+constexpr int file_count = 100;
+
+std::vector<char> random_payload(std::int64_t size) {
+    std::mt19937 generator(size);
+    std::vector<char> payload(size);
+    for (auto &byte : payload)
+        byte = static_cast<char>(generator());
+    return payload;
+}
+
+std::string file_name(int index) {
+    return "PARAMETER.0." + std::to_string(index);
+}
+
+/** Overwrites files of state.size() bytes, as when a case is rerun */
+void bench_write(ert::benchmark::State &state) {
+    auto payload = random_payload(state.size());
+    block_fs_type *block_fs = block_fs_mount(state.scratch_dir() / "bfs",
+                                             fsync_interval, false);
+
+    int index = 0;
+    state.set_bytes_processed(state.size());
+    state.measure([&] {
+        block_fs_fwrite_file(block_fs, file_name(index).c_str(),
+                             payload.data(), payload.size());
+        index = (index + 1) % file_count;
+    });
+    block_fs_close(block_fs);
+}
+
+void bench_read(ert::benchmark::State &state) {
+    auto payload = random_payload(state.size());
+    block_fs_type *block_fs = block_fs_mount(state.scratch_dir() / "bfs",
+                                             fsync_interval, false);
+    for (int index = 0; index < file_count; index++)
+        block_fs_fwrite_file(block_fs, file_name(index).c_str(),
+                             payload.data(), payload.size());
+
+    int index = 0;
+    buffer_type *buffer = buffer_alloc(state.size());
+    state.set_bytes_processed(state.size());
+    state.measure([&] {
+        block_fs_fread_realloc_buffer(block_fs, file_name(index).c_str(),
+                                      buffer);
+        index = (index + 1) % file_count;
+    });
+    buffer_free(buffer);
+    block_fs_close(block_fs);
+}
+
+/** Mounting rebuilds the index of a data file holding state.size() files */
+void bench_mount(ert::benchmark::State &state) {
+    auto mount_file = state.scratch_dir() / "bfs";
+    auto payload = random_payload(1024);
+    {
+        block_fs_type *block_fs =
+            block_fs_mount(mount_file, fsync_interval, false);
+        for (int index = 0; index < state.size(); index++)
+            block_fs_fwrite_file(block_fs, file_name(index).c_str(),
+                                 payload.data(), payload.size());
+        block_fs_close(block_fs);
+    }
+
+    state.set_items_processed(state.size());
+    state.measure([&] {
+        block_fs_close(block_fs_mount(mount_file, fsync_interval, true));
+    });
+}
+} // namespace
+
+ERT_BENCHMARK("block_fs/write", bench_write, 1024, 65536, 1048576);
+ERT_BENCHMARK("block_fs/read", bench_read, 1024, 65536, 1048576);
+ERT_BENCHMARK("block_fs/mount", bench_mount, 100, 10000);
@@ -0,0 +1,31 @@
+#include <ert/res_util/es_testdata.hpp>
+
+#include "../benchmark.hpp"
+
+namespace {
+constexpr int ens_size = 100;
+
+void bench_load(ert::benchmark::State &state, res::es_testdata::format fmt) {
+    int obs_size = state.size();
+    auto path = (state.scratch_dir() / "testdata").string();
+    res::es_testdata::random(ens_size, obs_size, obs_size).save(path, fmt);
+
+    state.set_bytes_processed(
+        sizeof(double) * (3 * obs_size * ens_size + obs_size * obs_size));
+    state.measure([&] {
+        res::es_testdata testdata(path.c_str());
+        ert::benchmark::keep(testdata);
+    });
+}
+
+void bench_load_text(ert::benchmark::State &state) {
+    bench_load(state, res::es_testdata::format::text);
+}
+
+void bench_load_binary(ert::benchmark::State &state) {
+    bench_load(state, res::es_testdata::format::binary);
+}
+} // namespace
+
+ERT_BENCHMARK("es_testdata/load_text", bench_load_text, 100, 1000);
+ERT_BENCHMARK("es_testdata/load_binary", bench_load_binary, 100, 1000);
@@ -0,0 +1,64 @@
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <ert/res_util/subst_list.hpp>
+
+#include "../benchmark.hpp"
+
+namespace {
+constexpr int key_count = 50;
+
+/**
+   A substitution list with key_count keys, and a template of state.size()
+   lines where every tenth line refers to one of the keys.
+*/
+struct subst_fixture {
+    subst_list_type *subst_list = subst_list_alloc(nullptr);
+    std::string text;
+
+    explicit subst_fixture(std::int64_t lines) {
+        for (int key = 0; key < key_count; key++)
+            subst_list_append_copy(subst_list,
+                                   ("<KEY" + std::to_string(key) + ">").c_str(),
+                                   std::to_string(key * 1.5).c_str(), nullptr);
+
+        for (std::int64_t line = 0; line < lines; line++) {
+            if (line % 10 == 0)
+                text += "VALUE <KEY" + std::to_string(line % key_count) + ">\n";
+            else
+                text += "-- a line of the template without any keys\n";
+        }
+    }
+
+    ~subst_fixture() { subst_list_free(subst_list); }
+};
+
+void bench_filtered_string(ert::benchmark::State &state) {
+    subst_fixture fixture(state.size());
+
+    state.set_bytes_processed(fixture.text.size());
+    state.measure([&] {
+        char *filtered = subst_list_alloc_filtered_string(fixture.subst_list,
+                                                          fixture.text.c_str());
+        ert::benchmark::keep(filtered);
+        free(filtered);
+    });
+}
+
+void bench_filter_file(ert::benchmark::State &state) {
+    subst_fixture fixture(state.size());
+    std::string src_file = (state.scratch_dir() / "template").string();
+    std::string target_file = (state.scratch_dir() / "target").string();
+    std::ofstream{src_file} << fixture.text;
+
+    state.set_bytes_processed(fixture.text.size());
+    state.measure([&] {
+        subst_list_filter_file(fixture.subst_list, src_file.c_str(),
+                               target_file.c_str());
+    });
+}
+} // namespace
+
+ERT_BENCHMARK("subst_list/filtered_string", bench_filtered_string, 100, 10000);
+ERT_BENCHMARK("subst_list/filter_file", bench_filter_file, 100, 10000);
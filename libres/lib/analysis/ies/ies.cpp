@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include <ert/python.hpp>
+#include <ert/res_util/metric.hpp>
 
 #include <ert/analysis/enkf_linalg.hpp>
 
@@ -78,6 +79,8 @@ ies::makeX(const Eigen::MatrixXd &A, const Eigen::MatrixXd &Y0,
            double ies_steplength, int iteration_nr)
 
 {
+    static const ert::metrics::Timer make_x_timer("analysis.make_X");
+    auto timing = make_x_timer.time();
     const int ens_size = Y0.cols();
 
     Eigen::MatrixXd Y = Y0;
@@ -183,6 +186,8 @@ void ies::updateA(Data &data,
                   const ies::inversion_type ies_inversion,
                   const std::variant<double, int> &truncation,
                   double ies_steplength) {
+    static const ert::metrics::Timer update_a_timer("analysis.update_A");
+    auto timing = update_a_timer.time();
 
     // Number of active realizations in current iteration
     int ens_size = Yin.cols();
@@ -1,4 +1,5 @@
 #include <Eigen/Dense>
+#include <algorithm>
 #include <assert.h>
 #include <cerrno>
 #include <fmt/format.h>
@@ -63,11 +64,26 @@ void serialize_node(enkf_fs_type *fs, const enkf_config_node_type *config_node,
     enkf_node_free(node);
 }
 
+/**
+ The nodes serialize to double precision; a single precision matrix is
+ filled one node at a time through a double precision column.
+*/
+void serialize_node(enkf_fs_type *fs, const enkf_config_node_type *config_node,
+                    int iens, int row_offset, int column,
+                    const ActiveList *active_list, Eigen::MatrixXf &A) {
+    int active_size = active_list->active_size(
+        enkf_config_node_get_data_size(config_node, 0));
+    Eigen::MatrixXd values = Eigen::MatrixXd::Zero(active_size, 1);
+    serialize_node(fs, config_node, iens, 0, 0, active_list, values);
+    A.block(row_offset, column, active_size, 1) = values.cast<float>();
+}
+
+template <typename Matrix>
 void serialize_parameter(const ensemble_config_type *ens_config,
                          const std::vector<Parameter> &parameters,
                          enkf_fs_type *target_fs,
                          const std::vector<int> &iens_active_index,
-                         Eigen::MatrixXd &A) {
+                         Matrix &A) {
 
     int ens_size = A.cols();
     int current_row = 0;
@@ -113,6 +129,18 @@ void deserialize_node(enkf_fs_type *target_fs, enkf_fs_type *src_fs,
     enkf_node_free(node);
 }
 
+void deserialize_node(enkf_fs_type *target_fs, enkf_fs_type *src_fs,
+                      const enkf_config_node_type *config_node, int iens,
+                      int row_offset, int column, const ActiveList *active_list,
+                      const Eigen::MatrixXf &A) {
+    int active_size = active_list->active_size(
+        enkf_config_node_get_data_size(config_node, 0));
+    Eigen::MatrixXd values =
+        A.block(row_offset, column, active_size, 1).cast<double>();
+    deserialize_node(target_fs, src_fs, config_node, iens, 0, 0, active_list,
+                     values);
+}
+
 void assert_matrix_size(const Eigen::MatrixXd &m, const char *name, int rows,
                         int columns) {
     if (!((m.rows() == rows) && (m.cols() == columns)))
@@ -123,20 +151,19 @@ void assert_matrix_size(const Eigen::MatrixXd &m, const char *name, int rows,
                                     "," + std::to_string(columns) + "]");
 }
 
-/**
-load a set of parameters from a enkf_fs_type storage into a set of
-matrices.
-*/
-std::optional<Eigen::MatrixXd>
-load_parameters(enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
-                const std::vector<int> &iens_active_index,
-                const std::vector<Parameter> &parameters) {
+template <typename Matrix>
+std::optional<Matrix>
+load_parameter_matrix(enkf_fs_type *target_fs,
+                      ensemble_config_type *ensemble_config,
+                      const std::vector<int> &iens_active_index,
+                      const std::vector<Parameter> &parameters) {
+    static const ert::metrics::Timer load_timer("analysis.load_parameters");
+    auto timing = load_timer.time();
 
     int active_ens_size = iens_active_index.size();
     if (!parameters.empty()) {
         int matrix_start_size = 250000;
-        Eigen::MatrixXd A =
-            Eigen::MatrixXd::Zero(matrix_start_size, active_ens_size);
+        Matrix A = Matrix::Zero(matrix_start_size, active_ens_size);
 
         serialize_parameter(ensemble_config, parameters, target_fs,
                             iens_active_index, A);
@@ -146,11 +173,40 @@ load_parameters(enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
     return {};
 }
 
-void save_parameters(enkf_fs_type *target_fs,
-                     ensemble_config_type *ensemble_config,
-                     const std::vector<int> &iens_active_index,
-                     const std::vector<Parameter> &parameters,
-                     const Eigen::MatrixXd &A) {
+/**
+load a set of parameters from a enkf_fs_type storage into a set of
+matrices.
+*/
+std::optional<Eigen::MatrixXd>
+load_parameters(enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
+                const std::vector<int> &iens_active_index,
+                const std::vector<Parameter> &parameters) {
+    return load_parameter_matrix<Eigen::MatrixXd>(
+        target_fs, ensemble_config, iens_active_index, parameters);
+}
+
+/**
+As load_parameters(), but the matrix is stored in single precision; this
+halves the memory of large FIELD and SURFACE parameters, which are stored
+as float anyway.
+*/
+std::optional<Eigen::MatrixXf>
+load_parameters_float(enkf_fs_type *target_fs,
+                      ensemble_config_type *ensemble_config,
+                      const std::vector<int> &iens_active_index,
+                      const std::vector<Parameter> &parameters) {
+    return load_parameter_matrix<Eigen::MatrixXf>(
+        target_fs, ensemble_config, iens_active_index, parameters);
+}
+
+template <typename Matrix>
+void save_parameter_matrix(enkf_fs_type *target_fs,
+                           ensemble_config_type *ensemble_config,
+                           const std::vector<int> &iens_active_index,
+                           const std::vector<Parameter> &parameters,
+                           const Matrix &A) {
+    static const ert::metrics::Timer save_timer("analysis.save_parameters");
+    auto timing = save_timer.time();
 
     int ens_size = iens_active_index.size();
     int current_row = 0;
@@ -172,15 +228,35 @@ void save_parameters(enkf_fs_type *target_fs,
     }
 }
 
-/**
-Store a parameters into a enkf_fs_type storage
-*/
-void save_row_scaling_parameters(
+void save_parameters(enkf_fs_type *target_fs,
+                     ensemble_config_type *ensemble_config,
+                     const std::vector<int> &iens_active_index,
+                     const std::vector<Parameter> &parameters,
+                     const Eigen::MatrixXd &A) {
+    save_parameter_matrix(target_fs, ensemble_config, iens_active_index,
+                          parameters, A);
+}
+
+void save_parameters(enkf_fs_type *target_fs,
+                     ensemble_config_type *ensemble_config,
+                     const std::vector<int> &iens_active_index,
+                     const std::vector<Parameter> &parameters,
+                     const Eigen::MatrixXf &A) {
+    save_parameter_matrix(target_fs, ensemble_config, iens_active_index,
+                          parameters, A);
+}
+
+template <typename Matrix>
+void save_row_scaling_matrices(
     enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
     const std::vector<int> &iens_active_index,
     const std::vector<RowScalingParameter> &scaled_parameters,
-    const std::vector<std::pair<Eigen::MatrixXd, std::shared_ptr<RowScaling>>>
+    const std::vector<std::pair<Matrix, std::shared_ptr<RowScaling>>>
         &scaled_A) {
+    static const ert::metrics::Timer save_timer(
+        "analysis.save_row_scaling_parameters");
+    auto timing = save_timer.time();
+
     if (scaled_A.size() > 0) {
         int ikw = 0;
         for (auto &scaled_parameter : scaled_parameters) {
@@ -199,21 +275,43 @@ void save_row_scaling_parameters(
 }
 
 /**
-load a set of parameters from a enkf_fs_type storage into a set of
-matrices with the corresponding row-scaling object.
+Store a parameters into a enkf_fs_type storage
 */
-std::vector<std::pair<Eigen::MatrixXd, std::shared_ptr<RowScaling>>>
-load_row_scaling_parameters(
+void save_row_scaling_parameters(
+    enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
+    const std::vector<int> &iens_active_index,
+    const std::vector<RowScalingParameter> &scaled_parameters,
+    const std::vector<std::pair<Eigen::MatrixXd, std::shared_ptr<RowScaling>>>
+        &scaled_A) {
+    save_row_scaling_matrices(target_fs, ensemble_config, iens_active_index,
+                              scaled_parameters, scaled_A);
+}
+
+void save_row_scaling_parameters(
+    enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
+    const std::vector<int> &iens_active_index,
+    const std::vector<RowScalingParameter> &scaled_parameters,
+    const std::vector<std::pair<Eigen::MatrixXf, std::shared_ptr<RowScaling>>>
+        &scaled_A) {
+    save_row_scaling_matrices(target_fs, ensemble_config, iens_active_index,
+                              scaled_parameters, scaled_A);
+}
+
+template <typename Matrix>
+std::vector<std::pair<Matrix, std::shared_ptr<RowScaling>>>
+load_row_scaling_matrices(
     enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
     const std::vector<int> &iens_active_index,
     const std::vector<RowScalingParameter> &config_parameters) {
+    static const ert::metrics::Timer load_timer(
+        "analysis.load_row_scaling_parameters");
+    auto timing = load_timer.time();
 
-    std::vector<std::pair<Eigen::MatrixXd, std::shared_ptr<RowScaling>>>
-        parameters;
+    std::vector<std::pair<Matrix, std::shared_ptr<RowScaling>>> parameters;
     int active_ens_size = iens_active_index.size();
     if (!config_parameters.empty()) {
         int matrix_start_size = 250000;
-        Eigen::MatrixXd A = Eigen::MatrixXd::Zero(250000, active_ens_size);
+        Matrix A = Matrix::Zero(250000, active_ens_size);
 
         for (const auto &parameter : config_parameters) {
             const auto *config_node = ensemble_config_get_node(
@@ -237,36 +335,87 @@ load_row_scaling_parameters(
     return parameters;
 }
 
+/**
+load a set of parameters from a enkf_fs_type storage into a set of
+matrices with the corresponding row-scaling object.
+*/
+std::vector<std::pair<Eigen::MatrixXd, std::shared_ptr<RowScaling>>>
+load_row_scaling_parameters(
+    enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
+    const std::vector<int> &iens_active_index,
+    const std::vector<RowScalingParameter> &config_parameters) {
+    return load_row_scaling_matrices<Eigen::MatrixXd>(
+        target_fs, ensemble_config, iens_active_index, config_parameters);
+}
+
+std::vector<std::pair<Eigen::MatrixXf, std::shared_ptr<RowScaling>>>
+load_row_scaling_parameters_float(
+    enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
+    const std::vector<int> &iens_active_index,
+    const std::vector<RowScalingParameter> &config_parameters) {
+    return load_row_scaling_matrices<Eigen::MatrixXf>(
+        target_fs, ensemble_config, iens_active_index, config_parameters);
+}
+
+/**
+The update A = A * X of a single precision A. X is computed in double
+precision, and so are the products: A is converted to double precision a
+block of rows at a time, so the full A is never held in double precision.
+*/
+void multiply(Eigen::Ref<Eigen::MatrixXf> A, const Eigen::MatrixXd &X) {
+    static const ert::metrics::Timer multiply_timer("analysis.multiply");
+    auto timing = multiply_timer.time();
+
+    if (A.cols() != X.rows() || X.rows() != X.cols())
+        throw std::invalid_argument("Size mismatch between X and A matrix");
+
+    const Eigen::Index block_rows = 1024;
+    for (Eigen::Index row = 0; row < A.rows(); row += block_rows) {
+        Eigen::Index rows = std::min(block_rows, A.rows() - row);
+        Eigen::MatrixXd block = A.middleRows(row, rows).cast<double>();
+        A.middleRows(row, rows) = (block * X).cast<float>();
+    }
+}
+
 /**
 Copy all parameters from source_fs to target_fs
 */
 void copy_parameters(enkf_fs_type *source_fs, enkf_fs_type *target_fs,
                      const ensemble_config_type *ensemble_config,
                      const std::vector<bool> &ens_mask) {
+    static const ert::metrics::Timer copy_timer("analysis.copy_parameters");
+    auto timing = copy_timer.time();
 
     /*
       Copy all the parameter nodes from source case to target case;
       nodes which are updated will be fetched from the new target
       case, and nodes which are not updated will be manually copied
       over there.
+
+      When all the realizations are active and nothing has been stored in
+      the target case yet, the target case becomes a snapshot of the
+      parameters in the source case instead.
     */
     if (target_fs != source_fs) {
+        bool all_active = std::all_of(ens_mask.begin(), ens_mask.end(),
+                                      [](bool active) { return active; });
         std::vector<int> ens_active_list = bool_vector_to_active_list(ens_mask);
         std::vector<std::string> param_keys =
             ensemble_config_keylist_from_var_type(ensemble_config, PARAMETER);
+        if (all_active && enkf_fs_snapshot_parameters(source_fs, target_fs))
+            param_keys.clear();
+
         for (auto &key : param_keys) {
             enkf_config_node_type *config_node =
                 ensemble_config_get_node(ensemble_config, key.c_str());
-            enkf_node_type *data_node = enkf_node_alloc(config_node);
             for (int j : ens_active_list) {
                 node_id_type node_id;
                 node_id.iens = j;
                 node_id.report_step = 0;
 
-                enkf_node_load(data_node, source_fs, node_id);
-                enkf_node_store(data_node, target_fs, node_id);
+                enkf_node_copy(config_node, source_fs, target_fs, node_id,
+                               node_id);
             }
-            enkf_node_free(data_node);
         }
 
         state_map_type *target_state_map = enkf_fs_get_state_map(target_fs);
@@ -283,6 +432,10 @@ std::pair<Eigen::MatrixXd, ObservationHandler> load_observations_and_responses(
     const std::vector<bool> &ens_mask,
     const std::vector<std::pair<std::string, std::vector<int>>>
         &selected_observations) {
+    static const ert::metrics::Timer load_timer(
+        "analysis.load_observations_and_responses");
+    auto timing = load_timer.time();
+
     /*
     Observations and measurements are collected in these temporary
     structures. obs_data is a precursor for the 'd' vector, and
@@ -375,6 +528,20 @@ load_row_scaling_parameters_pybind(
         target_fs_, ensemble_config_, iens_active_index, config_parameters);
 }
 
+static std::vector<std::pair<Eigen::MatrixXf, std::shared_ptr<RowScaling>>>
+load_row_scaling_parameters_float32_pybind(
+    py::object target_fs, py::object ensemble_config,
+    const std::vector<int> &iens_active_index,
+    const std::vector<analysis::RowScalingParameter> &config_parameters) {
+
+    auto target_fs_ = ert::from_cwrap<enkf_fs_type>(target_fs);
+    auto ensemble_config_ =
+        ert::from_cwrap<ensemble_config_type>(ensemble_config);
+
+    return analysis::load_row_scaling_parameters_float(
+        target_fs_, ensemble_config_, iens_active_index, config_parameters);
+}
+
 static std::optional<Eigen::MatrixXd>
 load_parameters_pybind(py::object target_fs, py::object ensemble_config,
                        const std::vector<int> &iens_active_index,
@@ -388,11 +555,25 @@ load_parameters_pybind(py::object target_fs, py::object ensemble_config,
                                      iens_active_index, parameters);
 }
 
+static std::optional<Eigen::MatrixXf> load_parameters_float32_pybind(
+    py::object target_fs, py::object ensemble_config,
+    const std::vector<int> &iens_active_index,
+    const std::vector<analysis::Parameter> &parameters) {
+
+    auto target_fs_ = ert::from_cwrap<enkf_fs_type>(target_fs);
+    auto ensemble_config_ =
+        ert::from_cwrap<ensemble_config_type>(ensemble_config);
+
+    return analysis::load_parameters_float(target_fs_, ensemble_config_,
+                                           iens_active_index, parameters);
+}
+
+template <typename Matrix>
 static void save_parameters_pybind(py::object target_fs,
                                    py::object ensemble_config,
                                    std::vector<int> iens_active_index,
                                    std::vector<analysis::Parameter> &parameters,
-                                   const Eigen::MatrixXd &A) {
+                                   const Matrix &A) {
     auto target_fs_ = ert::from_cwrap<enkf_fs_type>(target_fs);
     auto ensemble_config_ =
         ert::from_cwrap<ensemble_config_type>(ensemble_config);
@@ -400,11 +581,12 @@ static void save_parameters_pybind(py::object target_fs,
     analysis::save_parameters(target_fs_, ensemble_config_, iens_active_index,
                               parameters, A);
 }
+template <typename Matrix>
 static void save_row_scaling_parameters_pybind(
     py::object target_fs, py::object ensemble_config,
     std::vector<int> iens_active_index,
     const std::vector<analysis::RowScalingParameter> &config_parameters,
-    const std::vector<std::pair<Eigen::MatrixXd, std::shared_ptr<RowScaling>>>
+    const std::vector<std::pair<Matrix, std::shared_ptr<RowScaling>>>
         scaled_A) {
     auto target_fs_ = ert::from_cwrap<enkf_fs_type>(target_fs);
     auto ensemble_config_ =
@@ -461,9 +643,17 @@ RES_LIB_SUBMODULE("update", m) {
     m.def("copy_parameters", copy_parameters_pybind);
     m.def("load_observations_and_responses",
           load_observations_and_responses_pybind);
-    m.def("save_parameters", save_parameters_pybind);
-    m.def("save_row_scaling_parameters", save_row_scaling_parameters_pybind);
+    m.def("save_parameters", save_parameters_pybind<Eigen::MatrixXd>);
+    m.def("save_parameters", save_parameters_pybind<Eigen::MatrixXf>);
+    m.def("save_row_scaling_parameters",
+          save_row_scaling_parameters_pybind<Eigen::MatrixXd>);
+    m.def("save_row_scaling_parameters",
+          save_row_scaling_parameters_pybind<Eigen::MatrixXf>);
     m.def("load_parameters", load_parameters_pybind);
+    m.def("load_parameters_float32", load_parameters_float32_pybind);
     m.def("load_row_scaling_parameters", load_row_scaling_parameters_pybind);
+    m.def("load_row_scaling_parameters_float32",
+          load_row_scaling_parameters_float32_pybind);
+    m.def("multiply", analysis::multiply, py::arg("A"), py::arg("X"));
     m.def("generate_noise", generate_noise);
 }
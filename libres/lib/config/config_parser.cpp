@@ -31,6 +31,7 @@
 #include <ert/util/type_macros.hpp>
 
 #include <ert/config/config_parser.hpp>
+#include <ert/config/config_snapshot.hpp>
 
 static auto logger = ert::get_logger("config");
 
@@ -456,6 +457,48 @@ bool config_parser_add_key_values(
     return new_node != NULL;
 }
 
+/**
+   The tokens of all the non-empty lines of @config_file, from the config
+   snapshots if the file has been tokenized before.
+*/
+static std::shared_ptr<const config_token_lines>
+config_alloc_token_lines(const char *config_file, const char *comment_string) {
+    auto snapshot = config_snapshot_load(config_file, comment_string);
+    if (snapshot)
+        return snapshot;
+
+    const char *comment_end = comment_string ? "\n" : NULL;
+    basic_parser_type *parser = basic_parser_alloc(" \t", "\"", NULL, NULL,
+                                                   comment_string, comment_end);
+    auto lines = std::make_shared<config_token_lines>();
+
+    FILE *stream = util_fopen(config_file, "r");
+    bool at_eof = false;
+    while (!at_eof) {
+        char *line_buffer = util_fscanf_alloc_line(stream, &at_eof);
+        if (!line_buffer)
+            continue;
+
+        stringlist_type *token_list =
+            basic_parser_tokenize_buffer(parser, line_buffer, true);
+        int active_tokens = stringlist_get_size(token_list);
+        if (active_tokens > 0) {
+            auto &tokens = lines->emplace_back();
+            for (int i = 0; i < active_tokens; i++)
+                tokens.emplace_back(stringlist_iget(token_list, i));
+        }
+
+        stringlist_free(token_list);
+        free(line_buffer);
+    }
+
+    fclose(stream);
+    basic_parser_free(parser);
+
+    config_snapshot_store(config_file, comment_string, lines);
+    return lines;
+}
+
 /**
    This function parses the config file 'filename', and updated the
    internal state of the config object as parsing proceeds. If
@@ -544,80 +587,62 @@ config_parse__(config_parser_type *config, config_content_type *content,
         config_relocate(config_path, content, path_stack);
     free(config_path);
 
-    // Setup config parsing
-    const char *comment_end = comment_string ? "\n" : NULL;
-    basic_parser_type *parser = basic_parser_alloc(" \t", "\"", NULL, NULL,
-                                                   comment_string, comment_end);
-
-    FILE *stream = util_fopen(config_file, "r");
-    bool at_eof = false;
-
-    while (!at_eof) {
-        char *line_buffer = util_fscanf_alloc_line(stream, &at_eof);
-        if (!line_buffer)
-            continue;
-
-        stringlist_type *token_list =
-            basic_parser_tokenize_buffer(parser, line_buffer, true);
+    auto lines = config_alloc_token_lines(config_file, comment_string);
+    for (const auto &tokens : *lines) {
+        stringlist_type *token_list = stringlist_alloc_new();
+        for (const auto &token : tokens)
+            stringlist_append_copy(token_list, token.c_str());
         int active_tokens = stringlist_get_size(token_list);
+        const char *kw = stringlist_iget(token_list, 0);
 
-        if (active_tokens > 0) {
-            const char *kw = stringlist_iget(token_list, 0);
-
-            // Include config file
-            if (include_kw && (strcmp(include_kw, kw) == 0)) {
-                if (active_tokens != 2)
-                    util_abort(
-                        "%s: keyword:%s must have exactly one argument. \n",
-                        __func__, include_kw);
-
-                const char *include_file = stringlist_iget(token_list, 1);
-
-                if (!fs::exists(include_file)) {
-                    char *error_message = (char *)util_alloc_sprintf(
-                        "%s file:%s not found", include_kw, include_file);
-                    config_error_add(config_content_get_errors(content),
-                                     error_message);
-                    free(error_message);
-                }
+        // Include config file
+        if (include_kw && (strcmp(include_kw, kw) == 0)) {
+            if (active_tokens != 2)
+                util_abort("%s: keyword:%s must have exactly one argument. \n",
+                           __func__, include_kw);
+
+            const char *include_file = stringlist_iget(token_list, 1);
 
-                config_parse__(config, content, path_stack, include_file,
-                               comment_string, include_kw, define_kw,
-                               unrecognized, false);
+            if (!fs::exists(include_file)) {
+                char *error_message = (char *)util_alloc_sprintf(
+                    "%s file:%s not found", include_kw, include_file);
+                config_error_add(config_content_get_errors(content),
+                                 error_message);
+                free(error_message);
             }
 
-            // Add define
-            else if (define_kw && (strcmp(define_kw, kw) == 0)) {
-                if (active_tokens < 3)
-                    util_abort("%s: keyword:%s must have exactly one (or more) "
-                               "arguments. \n",
-                               __func__, define_kw);
+            config_parse__(config, content, path_stack, include_file,
+                           comment_string, include_kw, define_kw, unrecognized,
+                           false);
+        }
 
-                char *key = (char *)util_alloc_string_copy(
-                    stringlist_iget(token_list, 1));
-                char *value = stringlist_alloc_joined_substring(
-                    token_list, 2, active_tokens, " ");
+        // Add define
+        else if (define_kw && (strcmp(define_kw, kw) == 0)) {
+            if (active_tokens < 3)
+                util_abort("%s: keyword:%s must have exactly one (or more) "
+                           "arguments. \n",
+                           __func__, define_kw);
 
-                config_content_add_define(content, key, value);
+            char *key =
+                (char *)util_alloc_string_copy(stringlist_iget(token_list, 1));
+            char *value = stringlist_alloc_joined_substring(token_list, 2,
+                                                            active_tokens, " ");
 
-                free(key);
-                free(value);
-            }
+            config_content_add_define(content, key, value);
 
-            // Add keyword
-            else
-                config_parser_add_key_values(config, content, kw, token_list,
-                                             current_path_elm, config_file,
-                                             unrecognized);
+            free(key);
+            free(value);
         }
 
+        // Add keyword
+        else
+            config_parser_add_key_values(config, content, kw, token_list,
+                                         current_path_elm, config_file,
+                                         unrecognized);
+
         stringlist_free(token_list);
-        free(line_buffer);
     }
 
-    fclose(stream);
-    basic_parser_free(parser);
-
     if (validate)
         config_validate(config, content);
 
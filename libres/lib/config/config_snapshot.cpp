@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include <ert/logging.hpp>
+
+#include <ert/config/config_snapshot.hpp>
+
+namespace fs = std::filesystem;
+
+static auto logger = ert::get_logger("config");
+
+namespace {
+const char snapshot_magic[8] = {'E', 'R', 'T', 'C', 'S', 'N', 'P', '2'};
+
+struct file_stamp {
+    std::int64_t mtime;
+    std::uint64_t size;
+    std::uint64_t hash;
+
+    bool operator==(const file_stamp &other) const {
+        return mtime == other.mtime && size == other.size &&
+               hash == other.hash;
+    }
+};
+
+struct snapshot_type {
+    file_stamp stamp;
+    std::shared_ptr<const config_token_lines> lines;
+};
+
+std::mutex snapshot_mutex;
+std::unordered_map<std::string, snapshot_type> snapshots;
+
+/**
+   FNV-1a hash of the content of @path. Returns false if the file could not
+   be read.
+*/
+bool hash_file(const fs::path &path, std::uint64_t &hash) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+        return false;
+
+    hash = 14695981039346656037ULL;
+    char buffer[65536];
+    while (stream) {
+        stream.read(buffer, sizeof buffer);
+        for (std::streamsize i = 0; i < stream.gcount(); i++) {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 1099511628211ULL;
+        }
+    }
+    return stream.eof();
+}
+
+/**
+   The key of the snapshot of @config_file, or an empty string if the file
+   does not exist. The comment string is part of the key since it changes
+   the tokens. The modification time, size and content hash of the file are
+   returned in @stamp.
+*/
+std::string snapshot_key(const char *config_file, const char *comment_string,
+                         file_stamp &stamp) {
+    std::error_code ec;
+    fs::path path = fs::canonical(config_file, ec);
+    if (ec)
+        return "";
+
+    auto mtime = fs::last_write_time(path, ec);
+    if (ec)
+        return "";
+    auto size = fs::file_size(path, ec);
+    if (ec)
+        return "";
+    std::uint64_t hash;
+    if (!hash_file(path, hash))
+        return "";
+
+    stamp = {static_cast<std::int64_t>(mtime.time_since_epoch().count()),
+             static_cast<std::uint64_t>(size), hash};
+
+    std::string key = path.string();
+    key.push_back('\0');
+    if (comment_string) {
+        key.push_back('#');
+        key += comment_string;
+    }
+    return key;
+}
+
+/** The snapshot file of @key, or an empty path if there is no cache dir. */
+fs::path snapshot_file(const std::string &key) {
+    const char *cache_dir = getenv("ERT_CONFIG_CACHE_DIR");
+    if (!cache_dir || cache_dir[0] == '\0')
+        return {};
+
+    return fs::path(cache_dir) /
+           fmt::format("{:016x}.snapshot", std::hash<std::string>{}(key));
+}
+
+template <typename T> void write_value(std::ostream &stream, const T &value) {
+    stream.write(reinterpret_cast<const char *>(&value), sizeof value);
+}
+
+template <typename T> bool read_value(std::istream &stream, T &value) {
+    return bool(stream.read(reinterpret_cast<char *>(&value), sizeof value));
+}
+
+void write_string(std::ostream &stream, const std::string &value) {
+    write_value(stream, static_cast<std::uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+}
+
+bool read_string(std::istream &stream, std::string &value) {
+    std::uint32_t size;
+    if (!read_value(stream, size))
+        return false;
+    value.resize(size);
+    return bool(stream.read(value.data(), size));
+}
+
+std::shared_ptr<const config_token_lines>
+read_snapshot_file(const fs::path &file, const std::string &key,
+                   const file_stamp &stamp) {
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream)
+        return nullptr;
+
+    char magic[sizeof snapshot_magic];
+    std::string file_key;
+    file_stamp stored_stamp;
+    std::uint64_t line_count;
+    if (!stream.read(magic, sizeof magic) ||
+        !std::equal(magic, magic + sizeof magic, snapshot_magic) ||
+        !read_string(stream, file_key) || file_key != key ||
+        !read_value(stream, stored_stamp.mtime) ||
+        !read_value(stream, stored_stamp.size) ||
+        !read_value(stream, stored_stamp.hash) || !(stored_stamp == stamp) ||
+        !read_value(stream, line_count))
+        return nullptr;
+
+    auto lines = std::make_shared<config_token_lines>(line_count);
+    for (auto &tokens : *lines) {
+        std::uint32_t token_count;
+        if (!read_value(stream, token_count))
+            return nullptr;
+
+        tokens.resize(token_count);
+        for (auto &token : tokens)
+            if (!read_string(stream, token))
+                return nullptr;
+    }
+    return lines;
+}
+
+/**
+   The snapshot file is written to a temporary file and renamed into place,
+   so that concurrent ERT processes never see a partially written file.
+*/
+void write_snapshot_file(const fs::path &file, const std::string &key,
+                         const file_stamp &stamp,
+                         const config_token_lines &lines) {
+    std::error_code ec;
+    fs::create_directories(file.parent_path(), ec);
+
+    fs::path tmp_file = file;
+    tmp_file += fmt::format(".{}.tmp", getpid());
+    {
+        std::ofstream stream(tmp_file, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            logger->debug("Could not write config snapshot: {}",
+                          tmp_file.string());
+            return;
+        }
+
+        stream.write(snapshot_magic, sizeof snapshot_magic);
+        write_string(stream, key);
+        write_value(stream, stamp.mtime);
+        write_value(stream, stamp.size);
+        write_value(stream, stamp.hash);
+        write_value(stream, static_cast<std::uint64_t>(lines.size()));
+        for (const auto &tokens : lines) {
+            write_value(stream, static_cast<std::uint32_t>(tokens.size()));
+            for (const auto &token : tokens)
+                write_string(stream, token);
+        }
+        if (!stream) {
+            stream.close();
+            fs::remove(tmp_file, ec);
+            return;
+        }
+    }
+    fs::rename(tmp_file, file, ec);
+    if (ec)
+        fs::remove(tmp_file, ec);
+}
+} // namespace
+
+std::shared_ptr<const config_token_lines>
+config_snapshot_load(const char *config_file, const char *comment_string) {
+    file_stamp stamp;
+    std::string key = snapshot_key(config_file, comment_string, stamp);
+    if (key.empty())
+        return nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        auto iter = snapshots.find(key);
+        if (iter != snapshots.end()) {
+            if (iter->second.stamp == stamp)
+                return iter->second.lines;
+            snapshots.erase(iter);
+        }
+    }
+
+    fs::path file = snapshot_file(key);
+    if (file.empty())
+        return nullptr;
+
+    auto lines = read_snapshot_file(file, key, stamp);
+    if (lines) {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        snapshots[key] = {stamp, lines};
+    }
+    return lines;
+}
+
+void config_snapshot_store(const char *config_file, const char *comment_string,
+                           std::shared_ptr<const config_token_lines> lines) {
+    file_stamp stamp;
+    std::string key = snapshot_key(config_file, comment_string, stamp);
+    if (key.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        snapshots[key] = {stamp, lines};
+    }
+
+    fs::path file = snapshot_file(key);
+    if (!file.empty())
+        write_snapshot_file(file, key, stamp, *lines);
+}
+
+void config_snapshot_clear() {
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    snapshots.clear();
+}
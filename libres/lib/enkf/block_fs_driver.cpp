@@ -153,6 +153,25 @@ void ert::block_fs_driver::save_vector(const char *node_key, int iens,
     free(key);
 }
 
+/**
+   Copy the stored bytes of a node to @target without decoding them.
+   Returns false if the node is not stored in this driver.
+*/
+bool ert::block_fs_driver::copy_node(block_fs_driver *target,
+                                     const char *node_key, int src_report_step,
+                                     int target_report_step, int iens) {
+    char *src_key = block_fs_driver_alloc_node_key(node_key, src_report_step,
+                                                   iens);
+    char *target_key =
+        block_fs_driver_alloc_node_key(node_key, target_report_step, iens);
+    bool copied = block_fs_copy_file(this->get_fs(iens)->block_fs, src_key,
+                                     target->get_fs(iens)->block_fs,
+                                     target_key);
+    free(target_key);
+    free(src_key);
+    return copied;
+}
+
 bool ert::block_fs_driver::has_node(const char *node_key, int report_step,
                                     int iens) {
     char *key = block_fs_driver_alloc_node_key(node_key, report_step, iens);
@@ -195,6 +214,29 @@ void ert::block_fs_driver::fsync() {
         bfs_fsync(this->fs_list[driver_nr]);
 }
 
+/**
+   Replace the content of this driver, which must be empty, with a
+   copy-on-write snapshot of @src; see block_fs_snapshot(). Returns false,
+   without changing anything, if this driver is not empty or does not have
+   the same number of files as @src.
+*/
+bool ert::block_fs_driver::snapshot(block_fs_driver *src) {
+    if (this->config->read_only || src->num_fs != this->num_fs)
+        return false;
+
+    for (int driver_nr = 0; driver_nr < this->num_fs; driver_nr++)
+        if (!block_fs_is_empty(this->fs_list[driver_nr]->block_fs))
+            return false;
+
+    for (int driver_nr = 0; driver_nr < this->num_fs; driver_nr++) {
+        bfs_type *bfs = this->fs_list[driver_nr];
+        block_fs_close(bfs->block_fs);
+        block_fs_snapshot(src->fs_list[driver_nr]->block_fs, bfs->mountfile);
+        bfs_mount(bfs);
+    }
+    return true;
+}
+
 ert::block_fs_driver::block_fs_driver(int num_fs) : num_fs(num_fs) {
     this->fs_list = (bfs_type **)util_calloc(this->num_fs, sizeof(bfs_type *));
 }
@@ -135,6 +135,7 @@ static auto logger = ert::get_logger("enkf");
 #define SUMMARY_KEY_SET_FILE "summary-key-set"
 #define TIME_MAP_FILE "time-map"
 #define STATE_MAP_FILE "state-map"
+#define REALIZATION_MANIFEST_FILE "realization-manifest"
 #define MISFIT_ENSEMBLE_FILE "misfit-ensemble"
 #define CASE_CONFIG_FILE "case_config"
 
@@ -154,6 +155,7 @@ struct enkf_fs_struct {
     bool read_only;
     time_map_type *time_map;
     state_map_type *state_map;
+    realization_manifest_type *realization_manifest;
     summary_key_set_type *summary_key_set;
     /* The variables below here are for storing arbitrary files within the
      * enkf_fs storage directory, but not as serialized enkf_nodes. */
@@ -212,6 +214,7 @@ enkf_fs_type *enkf_fs_alloc_empty(const char *mount_point) {
     UTIL_TYPE_ID_INIT(fs, ENKF_FS_TYPE_ID);
     fs->time_map = time_map_alloc();
     fs->state_map = state_map_alloc();
+    fs->realization_manifest = realization_manifest_alloc();
     fs->summary_key_set = summary_key_set_alloc();
     fs->misfit_ensemble = misfit_ensemble_alloc();
     fs->read_only = true;
@@ -355,6 +358,13 @@ static void enkf_fs_fsync_state_map(enkf_fs_type *fs) {
     free(filename);
 }
 
+static void enkf_fs_fsync_realization_manifest(enkf_fs_type *fs) {
+    char *filename =
+        enkf_fs_alloc_case_filename(fs, REALIZATION_MANIFEST_FILE);
+    realization_manifest_fwrite(fs->realization_manifest, filename);
+    free(filename);
+}
+
 static void enkf_fs_fsync_summary_key_set(enkf_fs_type *fs) {
     char *filename = enkf_fs_alloc_case_filename(fs, SUMMARY_KEY_SET_FILE);
     summary_key_set_fwrite(fs->summary_key_set, filename);
@@ -367,6 +377,13 @@ static void enkf_fs_fread_state_map(enkf_fs_type *fs) {
     free(filename);
 }
 
+static void enkf_fs_fread_realization_manifest(enkf_fs_type *fs) {
+    char *filename =
+        enkf_fs_alloc_case_filename(fs, REALIZATION_MANIFEST_FILE);
+    realization_manifest_fread(fs->realization_manifest, filename);
+    free(filename);
+}
+
 static void enkf_fs_fread_summary_key_set(enkf_fs_type *fs) {
     char *filename = enkf_fs_alloc_case_filename(fs, SUMMARY_KEY_SET_FILE);
     summary_key_set_fread(fs->summary_key_set, filename);
@@ -456,6 +473,7 @@ enkf_fs_type *enkf_fs_mount(const char *mount_point) {
     enkf_fs_init_path_fmt(fs);
     enkf_fs_fread_time_map(fs);
     enkf_fs_fread_state_map(fs);
+    enkf_fs_fread_realization_manifest(fs);
     enkf_fs_fread_summary_key_set(fs);
     enkf_fs_fread_misfit(fs);
 
@@ -506,6 +524,7 @@ void enkf_fs_umount(enkf_fs_type *fs) {
     path_fmt_free(fs->case_tstep_member_fmt);
 
     state_map_free(fs->state_map);
+    realization_manifest_free(fs->realization_manifest);
     summary_key_set_free(fs->summary_key_set);
     time_map_free(fs->time_map);
     misfit_ensemble_free(fs->misfit_ensemble);
@@ -537,6 +556,7 @@ void enkf_fs_fsync(enkf_fs_type *fs) {
 
     enkf_fs_fsync_time_map(fs);
     enkf_fs_fsync_state_map(fs);
+    enkf_fs_fsync_realization_manifest(fs);
     enkf_fs_fsync_summary_key_set(fs);
 }
 
@@ -567,6 +587,52 @@ void enkf_fs_fread_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
     driver->load_vector(node_key, iens, buffer);
 }
 
+/**
+   Let @target_fs share all the parameters stored in @src_fs, as a
+   copy-on-write snapshot, instead of copying them. This is only possible
+   when no parameters have been stored in @target_fs; returns false
+   otherwise.
+*/
+bool enkf_fs_snapshot_parameters(enkf_fs_type *src_fs,
+                                 enkf_fs_type *target_fs) {
+    if (target_fs->read_only)
+        util_abort("%s: attempt to write to read_only filesystem mounted at:%s "
+                   "- aborting. \n",
+                   __func__, target_fs->mount_point);
+
+    return target_fs->parameter->snapshot(src_fs->parameter.get());
+}
+
+/**
+   Copy the stored node verbatim from @src_fs to @target_fs, without
+   decoding and encoding it. Returns false if @src_fs does not have the
+   node.
+*/
+bool enkf_fs_copy_node(enkf_fs_type *src_fs, enkf_fs_type *target_fs,
+                       const char *node_key, enkf_var_type var_type,
+                       int src_report_step, int target_report_step, int iens) {
+    if (target_fs->read_only)
+        util_abort("%s: attempt to write to read_only filesystem mounted at:%s "
+                   "- aborting. \n",
+                   __func__, target_fs->mount_point);
+
+    if (var_type == PARAMETER) {
+        /* Parameters are *ONLY* stored at report_step == 0 */
+        src_report_step = 0;
+        if (target_report_step > 0)
+            util_abort("%s: Parameters can only be saved for report_step = 0 "
+                       "  %s:%d\n",
+                       __func__, node_key, target_report_step);
+    }
+
+    ert::block_fs_driver *src_driver =
+        enkf_fs_select_driver(src_fs, var_type, node_key);
+    ert::block_fs_driver *target_driver =
+        enkf_fs_select_driver(target_fs, var_type, node_key);
+    return src_driver->copy_node(target_driver, node_key, src_report_step,
+                                 target_report_step, iens);
+}
+
 bool enkf_fs_has_node(enkf_fs_type *enkf_fs, const char *node_key,
                       enkf_var_type var_type, int report_step, int iens) {
     ert::block_fs_driver *driver =
@@ -686,6 +752,11 @@ state_map_type *enkf_fs_get_state_map(const enkf_fs_type *fs) {
     return fs->state_map;
 }
 
+realization_manifest_type *
+enkf_fs_get_realization_manifest(const enkf_fs_type *fs) {
+    return fs->realization_manifest;
+}
+
 summary_key_set_type *enkf_fs_get_summary_key_set(const enkf_fs_type *fs) {
     return fs->summary_key_set;
 }
@@ -19,8 +19,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <future>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
@@ -193,9 +195,13 @@ bool enkf_main_load_obs(enkf_main_type *enkf_main, const char *obs_config_file,
         return false;
     }
 
+    const analysis_config_type *analysis_config =
+        enkf_main_get_analysis_config(enkf_main);
+    const model_config_type *model_config =
+        enkf_main_get_model_config(enkf_main);
     enkf_obs_load(enkf_main->obs, obs_config_file,
-                  analysis_config_get_std_cutoff(
-                      enkf_main_get_analysis_config(enkf_main)));
+                  analysis_config_get_std_cutoff(analysis_config),
+                  model_config_get_enspath(model_config));
     return true;
 }
 
@@ -372,21 +378,27 @@ ert_workflow_list_type *enkf_main_get_workflow_list(enkf_main_type *enkf_main) {
 int enkf_main_load_from_forward_model_with_fs(enkf_main_type *enkf_main,
                                               int iter,
                                               bool_vector_type *iactive,
-                                              enkf_fs_type *fs) {
+                                              enkf_fs_type *fs, bool force) {
     model_config_type *model_config = enkf_main_get_model_config(enkf_main);
     ert_run_context_type *run_context =
         ert_run_context_alloc_ENSEMBLE_EXPERIMENT(
             fs, iactive, model_config_get_runpath_fmt(model_config),
             model_config_get_jobname_fmt(model_config),
             enkf_main_get_data_kw(enkf_main), iter);
-    int loaded = enkf_main_load_from_run_context(enkf_main, run_context, fs);
+    int loaded =
+        enkf_main_load_from_run_context(enkf_main, run_context, fs, force);
     ert_run_context_free(run_context);
     return loaded;
 }
 
+/**
+   Loads the results of the active realizations of @run_context. Unless
+   @force is set, realizations whose runpath files are unchanged since they
+   were last loaded are skipped, and counted as loaded.
+*/
 int enkf_main_load_from_run_context(enkf_main_type *enkf_main,
                                     ert_run_context_type *run_context,
-                                    enkf_fs_type *fs) {
+                                    enkf_fs_type *fs, bool force) {
     auto const ens_size = enkf_main_get_ensemble_size(enkf_main);
     auto const *iactive = ert_run_context_get_iactive(run_context);
 
@@ -430,7 +442,8 @@ int enkf_main_load_from_run_context(enkf_main_type *enkf_main,
                                                    STATE_INITIALIZED);
                         auto status = enkf_state_load_from_forward_model(
                             enkf_main_iget_state(enkf_main, realisation),
-                            ert_run_context_iget_arg(run_context, realisation));
+                            ert_run_context_iget_arg(run_context, realisation),
+                            force);
                         if (status.first == LOAD_SUCCESSFUL) {
                             state_map_iset(state_map, realisation,
                                            STATE_HAS_DATA);
@@ -488,7 +501,6 @@ bool enkf_main_export_field_with_fs(const enkf_main_type *enkf_main,
     if (util_int_format_count(path) < 1)
         return false;
 
-    enkf_node_type *node = enkf_node_alloc(config_node);
     model_config_type *mc = enkf_main_get_model_config(enkf_main);
     path_fmt_type *runpath_fmt = model_config_get_runpath_fmt(mc);
     const char *init_file =
@@ -501,33 +513,46 @@ bool enkf_main_export_field_with_fs(const enkf_main_type *enkf_main,
         printf("no init_file found, exporting 0 or fill value for inactive "
                "cells\n");
 
-    for (int iens = 0; iens < bool_vector_size(iactive); ++iens) {
-        if (!bool_vector_iget(iactive, iens))
-            continue;
-
-        node_id_type node_id = {.report_step = report_step, .iens = iens};
-        if (!enkf_node_try_load(node, fs, node_id))
-            continue;
+    std::vector<int> realizations;
+    for (int iens = 0; iens < bool_vector_size(iactive); ++iens)
+        if (bool_vector_iget(iactive, iens))
+            realizations.push_back(iens);
+
+    // The realizations are split in one block per thread, and every block
+    // loads and transforms the field in its own node.
+    path_fmt_type *export_path = path_fmt_alloc_path_fmt(path);
+    const int realization_count = realizations.size();
+    const int block_count = std::clamp<int>(
+        std::thread::hardware_concurrency(), 1, std::max(realization_count, 1));
+    ert::parallel_for(block_count, [&](int block) {
+        enkf_node_type *node = enkf_node_alloc(config_node);
+        int begin = block * realization_count / block_count;
+        int end = (block + 1) * realization_count / block_count;
+        for (int index = begin; index < end; index++) {
+            int iens = realizations[index];
+            node_id_type node_id = {.report_step = report_step, .iens = iens};
+            if (!enkf_node_try_load(node, fs, node_id))
+                continue;
+
+            char *filename = path_fmt_alloc_path(export_path, false, iens);
+            char *path;
+            util_alloc_file_components(filename, &path, NULL, NULL);
+            if (path) {
+                util_make_path(path);
+                free(path);
+            }
 
-        path_fmt_type *export_path = path_fmt_alloc_path_fmt(path);
-        char *filename = path_fmt_alloc_path(export_path, false, iens);
-        path_fmt_free(export_path);
+            const field_type *field =
+                (const field_type *)enkf_node_value_ptr(node);
+            field_export(field, filename, NULL, file_type,
+                         true, //output_transform
+                         init_file);
 
-        char *path;
-        util_alloc_file_components(filename, &path, NULL, NULL);
-        if (path) {
-            util_make_path(path);
-            free(path);
+            free(filename);
         }
-
-        const field_type *field = (const field_type *)enkf_node_value_ptr(node);
-        field_export(field, filename, NULL, file_type,
-                     true, //output_transform
-                     init_file);
-
-        free(filename);
-    }
-    enkf_node_free(node);
+        enkf_node_free(node);
+    });
+    path_fmt_free(export_path);
 
     return true;
 }
@@ -570,12 +595,13 @@ std::vector<std::string> get_parameter_keys(py::object self) {
 }
 
 int load_from_forward_model_with_fs_pybind(py::object self, int iter,
-                                           py::object iactive, py::object fs) {
+                                           py::object iactive, py::object fs,
+                                           bool force) {
     auto enkf_main = ert::from_cwrap<enkf_main_type>(self);
     auto iactive_ = ert::from_cwrap<bool_vector_type>(iactive);
     auto fs_ = ert::from_cwrap<enkf_fs_type>(fs);
     return enkf_main_load_from_forward_model_with_fs(enkf_main, iter, iactive_,
-                                                     fs_);
+                                                     fs_, force);
 }
 
 namespace enkf_main {
@@ -747,7 +773,8 @@ RES_LIB_SUBMODULE("enkf_main", m) {
         },
         py::arg("self"), py::arg("run_context"));
     m.def("load_from_forward_model", load_from_forward_model_with_fs_pybind,
-          py::arg("self"), py::arg("iter"), py::arg("iactive"), py::arg("fs"));
+          py::arg("self"), py::arg("iter"), py::arg("iactive"), py::arg("fs"),
+          py::arg("force") = false);
 }
 
 #include "enkf_main_ensemble.cpp"
@@ -134,9 +134,31 @@ void enkf_main_init_case_from_existing(const enkf_main_type *enkf_main,
         enkf_main_get_ensemble_config(enkf_main),
         PARAMETER); /* Select only paramters - will fail for GEN_DATA of type DYNAMIC_STATE. */
     std::vector<bool> iactive(enkf_main_get_ensemble_size(enkf_main), true);
-    enkf_main_copy_ensemble(enkf_main_get_ensemble_config(enkf_main),
-                            source_case_fs, source_report_step, target_case_fs,
-                            iactive, param_list);
+
+    // Parameters are only stored at report step 0, so an empty target case
+    // can be initialized as a snapshot of the source case.
+    if (source_report_step == 0 &&
+        enkf_fs_snapshot_parameters(source_case_fs, target_case_fs)) {
+        // The snapshot has the parameters of exactly the realizations which
+        // had them in the source case.
+        const state_map_type *source_state_map =
+            enkf_fs_get_state_map(source_case_fs);
+        state_map_type *target_state_map =
+            enkf_fs_get_state_map(target_case_fs);
+        for (int iens = 0; iens < enkf_main_get_ensemble_size(enkf_main);
+             iens++) {
+            realisation_state_enum state =
+                state_map_iget(source_state_map, iens);
+            if (state == STATE_PARENT_FAILURE)
+                state_map_iset(target_state_map, iens, STATE_PARENT_FAILURE);
+            else if (state & (STATE_INITIALIZED | STATE_HAS_DATA |
+                              STATE_LOAD_FAILURE))
+                state_map_iset(target_state_map, iens, STATE_INITIALIZED);
+        }
+    } else
+        enkf_main_copy_ensemble(enkf_main_get_ensemble_config(enkf_main),
+                                source_case_fs, source_report_step,
+                                target_case_fs, iactive, param_list);
 
     enkf_fs_fsync(target_case_fs);
 }
@@ -25,6 +25,8 @@
 #include <ert/util/util.h>
 #include <ert/util/vector.h>
 
+#include <ert/res_util/metric.hpp>
+
 #include <ert/enkf/container.hpp>
 #include <ert/enkf/enkf_node.hpp>
 #include <ert/enkf/ext_param.hpp>
@@ -408,6 +410,8 @@ bool enkf_node_forward_load_vector(
 static bool enkf_node_store_buffer(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                    int report_step, int iens) {
     FUNC_ASSERT(enkf_node->write_to_buffer);
+    static const ert::metrics::Timer store_timer("enkf_node.store");
+    auto timing = store_timer.time();
     {
         bool data_written;
         buffer_type *buffer = buffer_alloc(100);
@@ -466,6 +470,8 @@ bool enkf_node_try_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
 static void enkf_node_buffer_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                   int report_step, int iens) {
     FUNC_ASSERT(enkf_node->read_from_buffer);
+    static const ert::metrics::Timer load_timer("enkf_node.load");
+    auto timing = load_timer.time();
     {
         buffer_type *buffer = buffer_alloc(100);
         const enkf_config_node_type *config_node =
@@ -524,6 +530,17 @@ bool enkf_node_try_load_vector(enkf_node_type *enkf_node, enkf_fs_type *fs,
         return false;
 }
 
+/**
+   Whether the vector currently loaded in @enkf_node, e.g. with
+   enkf_node_try_load_vector(), has data for @report_step. Unlike
+   enkf_node_has_data() this does not touch the storage.
+*/
+bool enkf_node_vector_has_data(const enkf_node_type *enkf_node,
+                               int report_step) {
+    FUNC_ASSERT(enkf_node->has_data);
+    return enkf_node->has_data(enkf_node->data, report_step);
+}
+
 /**
   In the case of nodes with vector storage this function
   will load the entire vector.
@@ -554,17 +571,34 @@ enkf_node_type *enkf_node_load_alloc(const enkf_config_node_type *config_node,
     }
 }
 
+/**
+   Copy a node from @src_case to @target_case. Nodes which are stored as a
+   single block, which is most parameters, are copied verbatim on the
+   storage level. The remaining nodes, and nodes missing in @src_case, go
+   through enkf_node_load() and enkf_node_store(); for GEN_DATA that also
+   enforces the size at the target report step.
+*/
 void enkf_node_copy(const enkf_config_node_type *config_node,
                     enkf_fs_type *src_case, enkf_fs_type *target_case,
                     node_id_type src_id, node_id_type target_id) {
 
+    ert_impl_type impl_type = enkf_config_node_get_impl_type(config_node);
+    if (impl_type != GEN_DATA && impl_type != CONTAINER &&
+        !enkf_config_node_vector_storage(config_node) &&
+        src_id.iens == target_id.iens &&
+        enkf_fs_copy_node(src_case, target_case,
+                          enkf_config_node_get_key(config_node),
+                          enkf_config_node_get_var_type(config_node),
+                          src_id.report_step, target_id.report_step,
+                          src_id.iens))
+        return;
+
     enkf_node_type *enkf_node =
         enkf_node_load_alloc(config_node, src_case, src_id);
 
     /* Hack to ensure that size is set for the gen_data instances.
      This sneeks low level stuff into a high level scope. BAD. */
     {
-        ert_impl_type impl_type = enkf_node_get_impl_type(enkf_node);
         if (impl_type == GEN_DATA) {
             /* Read the size at report_step_from */
             gen_data_type *gen_data =
@@ -17,10 +17,19 @@
 */
 
 #include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
 #include <ert/util/hash.h>
 #include <ert/util/type_vector_functions.h>
 #include <ert/util/vector.h>
 
+#include <ert/concurrency.hpp>
+#include <ert/logging.hpp>
 #include <ert/res_util/string.hpp>
 
 #include <ert/config/conf.hpp>
@@ -33,9 +42,13 @@
 #include <ert/enkf/enkf_analysis.hpp>
 #include <ert/enkf/enkf_fs.hpp>
 #include <ert/enkf/enkf_obs.hpp>
+#include <ert/enkf/obs_cache.hpp>
 #include <ert/enkf/obs_vector.hpp>
 #include <ert/enkf/summary_obs.hpp>
 
+namespace fs = std::filesystem;
+static auto logger = ert::get_logger("enkf");
+
 #define ENKF_OBS_TYPE_ID 637297
 /**
 
@@ -303,29 +316,14 @@ static void enkf_obs_get_obs_and_measure_summary(
     enkf_fs_type *fs, const std::vector<int> &ens_active_list,
     meas_data_type *meas_data, obs_data_type *obs_data) {
 
-    int active_count = 0;
-    int last_step = -1;
-    int step = -1;
-
-    /*1: Determine which report_steps have active observations; and collect the observed values. */
-    std::vector<std::pair<double, double>> observations;
-    while (true) {
-        step = obs_vector_get_next_active_step(obs_vector, step);
-        if (step < 0)
-            break;
-
-        const summary_obs_type *summary_obs =
-            (const summary_obs_type *)obs_vector_iget_node(obs_vector, step);
-        observations.push_back({summary_obs_get_value(summary_obs),
-                                summary_obs_get_std(summary_obs) *
-                                    summary_obs_get_std_scaling(summary_obs)});
-        last_step = step;
-        active_count++;
-    }
-
-    if (active_count <= 0)
+    /*1: The observations are stored sorted on the active report steps. */
+    const SummaryObsStore *summary_obs = obs_vector_get_summary_obs(obs_vector);
+    if (!summary_obs || summary_obs->size() <= 0)
         return;
 
+    int active_count = summary_obs->size();
+    int last_step = summary_obs->step.back();
+
     /*
     3: Fill up the obs_block and meas_block structures with this
     time-aggregated summary observation.
@@ -342,17 +340,13 @@ static void enkf_obs_get_obs_and_measure_summary(
             enkf_node_alloc(obs_vector_get_config_node(obs_vector));
 
         for (int i = 0; i < active_count; i++)
-            obs_block_iset(obs_block, i, observations[i].first,
-                           observations[i].second);
+            obs_block_iset(obs_block, i, summary_obs->value[i],
+                           summary_obs->stddev[i] *
+                               summary_obs->std_scaling[i]);
 
         int active_size = ens_active_list.size();
         active_count = 0;
-        step = -1;
-        while (true) {
-            step = obs_vector_get_next_active_step(obs_vector, step);
-            if (step < 0)
-                break;
-
+        for (int step : summary_obs->step) {
             for (int iens_index = 0; iens_index < active_size; iens_index++) {
                 const int iens = ens_active_list[iens_index];
                 node_id_type node_id = {.report_step = step, .iens = iens};
@@ -464,15 +458,25 @@ static void enkf_obs_update_keys(enkf_obs_type *enkf_obs) {
     }
 }
 
-/** Handle HISTORY_OBSERVATION instances. */
+/**
+   Handle HISTORY_OBSERVATION instances.
+
+   The obs_vectors are allocated serially, since that updates the ensemble
+   config, whereas extracting the observations from the history is done in
+   parallel. When @cache_hit is true the observations are taken from @cache
+   instead of the history, otherwise @cache is updated with the
+   observations.
+*/
 static void handle_history_observation(enkf_obs_type *enkf_obs,
                                        conf_instance_type *enkf_conf,
-                                       int last_report, double std_cutoff) {
+                                       int last_report, double std_cutoff,
+                                       HistoryObsCache &cache, bool cache_hit) {
     stringlist_type *hist_obs_keys =
         conf_instance_alloc_list_of_sub_instances_of_class_by_name(
             enkf_conf, "HISTORY_OBSERVATION");
     int num_hist_obs = stringlist_get_size(hist_obs_keys);
 
+    std::vector<obs_vector_type *> obs_vectors;
     for (int i = 0; i < num_hist_obs; i++) {
         const char *obs_key = stringlist_iget(hist_obs_keys, i);
 
@@ -483,9 +487,6 @@ static void handle_history_observation(enkf_obs_type *enkf_obs,
                     obs_key);
             break;
         }
-        const conf_instance_type *hist_obs_conf =
-            conf_instance_get_sub_instance_ref(enkf_conf, obs_key);
-        obs_vector_type *obs_vector;
         enkf_config_node_type *config_node;
         config_node = ensemble_config_add_summary_observation(
             enkf_obs->ensemble_config, obs_key, LOAD_FAIL_WARN);
@@ -497,22 +498,58 @@ static void handle_history_observation(enkf_obs_type *enkf_obs,
             break;
         }
 
-        obs_vector = obs_vector_alloc(
+        obs_vectors.push_back(obs_vector_alloc(
             SUMMARY_OBS, obs_key,
             ensemble_config_get_node(enkf_obs->ensemble_config, obs_key),
-            last_report);
-        if (obs_vector != NULL) {
-            if (obs_vector_load_from_HISTORY_OBSERVATION(
-                    obs_vector, hist_obs_conf, enkf_obs->obs_time,
-                    enkf_obs->history, enkf_obs->ensemble_config, std_cutoff)) {
-                enkf_obs_add_obs_vector(enkf_obs, obs_vector);
-            } else {
-                fprintf(stderr,
-                        "** Could not load historical data for observation:%s "
-                        "- ignored\n",
-                        obs_key);
-                obs_vector_free(obs_vector);
+            last_report));
+    }
+
+    std::vector<char> loaded(obs_vectors.size(), false);
+    ert::parallel_for(obs_vectors.size(), [&](int i) {
+        obs_vector_type *obs_vector = obs_vectors[i];
+        const char *obs_key = obs_vector_get_key(obs_vector);
+        if (cache_hit) {
+            const history_obs_cache_entry *entry = cache.get(obs_key);
+            if (entry && entry->valid) {
+                for (std::size_t j = 0; j < entry->step.size(); j++)
+                    obs_vector_add_summary_obs(obs_vector, entry->step[j],
+                                               obs_key, obs_key,
+                                               entry->value[j],
+                                               entry->stddev[j]);
+                loaded[i] = true;
             }
+        } else {
+            const conf_instance_type *hist_obs_conf =
+                conf_instance_get_sub_instance_ref(enkf_conf, obs_key);
+            loaded[i] = obs_vector_load_from_HISTORY_OBSERVATION(
+                obs_vector, hist_obs_conf, enkf_obs->obs_time,
+                enkf_obs->history, enkf_obs->ensemble_config, std_cutoff);
+        }
+    });
+
+    for (std::size_t i = 0; i < obs_vectors.size(); i++) {
+        obs_vector_type *obs_vector = obs_vectors[i];
+        const char *obs_key = obs_vector_get_key(obs_vector);
+        if (!cache_hit) {
+            history_obs_cache_entry entry{bool(loaded[i])};
+            const SummaryObsStore *store =
+                obs_vector_get_summary_obs(obs_vector);
+            if (store) {
+                entry.step = store->step;
+                entry.value = store->value;
+                entry.stddev = store->stddev;
+            }
+            cache.set(obs_key, std::move(entry));
+        }
+
+        if (loaded[i])
+            enkf_obs_add_obs_vector(enkf_obs, obs_vector);
+        else {
+            fprintf(stderr,
+                    "** Could not load historical data for observation:%s "
+                    "- ignored\n",
+                    obs_key);
+            obs_vector_free(obs_vector);
         }
     }
     stringlist_free(hist_obs_keys);
@@ -591,16 +628,21 @@ static void handle_general_observation(enkf_obs_type *enkf_obs,
             enkf_conf, "GENERAL_OBSERVATION");
     int num_block_obs = stringlist_get_size(block_obs_keys);
 
-    for (int i = 0; i < num_block_obs; i++) {
+    // Loading the observation files is done in parallel, the obs_vectors are
+    // added in the order of the configuration.
+    std::vector<obs_vector_type *> obs_vectors(num_block_obs, NULL);
+    ert::parallel_for(num_block_obs, [&](int i) {
         const char *obs_key = stringlist_iget(block_obs_keys, i);
         const conf_instance_type *gen_obs_conf =
             conf_instance_get_sub_instance_ref(enkf_conf, obs_key);
 
-        obs_vector_type *obs_vector = obs_vector_alloc_from_GENERAL_OBSERVATION(
+        obs_vectors[i] = obs_vector_alloc_from_GENERAL_OBSERVATION(
             gen_obs_conf, enkf_obs->obs_time, enkf_obs->ensemble_config);
+    });
+
+    for (auto obs_vector : obs_vectors)
         if (obs_vector != NULL)
             enkf_obs_add_obs_vector(enkf_obs, obs_vector);
-    }
     stringlist_free(block_obs_keys);
 }
 
@@ -615,15 +657,72 @@ static void enkf_obs_reinterpret_DT_FILE(const char *errors) {
     // clang-format on
 }
 
+/**
+   The key of the HISTORY_OBSERVATION cache: a hash of the observation
+   configuration, the refcase files and all other input used when building
+   the observations. Returns 0 - i.e. no caching - if the refcase files can
+   not be found.
+*/
+static std::uint64_t enkf_obs_cache_key(const enkf_obs_type *enkf_obs,
+                                        const char *config_file,
+                                        double std_cutoff) {
+    std::uint64_t hash = obs_cache_hash_bytes(NULL, 0, 0);
+    if (!obs_cache_hash_file(config_file, hash))
+        return 0;
+
+    hash = obs_cache_hash_bytes(&std_cutoff, sizeof std_cutoff, hash);
+    for (int step = 0; step < time_map_get_size(enkf_obs->obs_time); step++) {
+        time_t obs_time = time_map_iget(enkf_obs->obs_time, step);
+        hash = obs_cache_hash_bytes(&obs_time, sizeof obs_time, hash);
+    }
+
+    if (enkf_obs->history) {
+        history_source_type source = history_get_source(enkf_obs->history);
+        hash = obs_cache_hash_bytes(&source, sizeof source, hash);
+
+        if (!enkf_obs->refcase)
+            return 0;
+
+        std::string refcase = ecl_sum_get_case(enkf_obs->refcase);
+        if (!(obs_cache_hash_file((refcase + ".SMSPEC").c_str(), hash) &&
+              obs_cache_hash_file((refcase + ".UNSMRY").c_str(), hash)) &&
+            !(obs_cache_hash_file((refcase + ".FSMSPEC").c_str(), hash) &&
+              obs_cache_hash_file((refcase + ".FUNSMRY").c_str(), hash)))
+            return 0;
+    }
+    return hash;
+}
+
+/**
+   The cache is stored as a hidden file in @cache_dir, named from the
+   absolute path of the observation configuration file, so that several
+   configurations sharing the directory do not overwrite each other.
+*/
+static std::string enkf_obs_cache_file(const char *cache_dir,
+                                       const char *config_file) {
+    std::string config_path =
+        fs::absolute(config_file).lexically_normal().string();
+    std::uint64_t hash =
+        obs_cache_hash_bytes(config_path.data(), config_path.size(), 0);
+    return (fs::path(cache_dir) /
+            fmt::format(".history_obs_{:016x}.cache", hash))
+        .string();
+}
+
 /**
  This function will load an observation configuration from the
    observation file @config_file.
 
+   The observations built from HISTORY_OBSERVATION keywords are cached in a
+   file in @cache_dir - normally the storage directory - and reused as long
+   as neither the configuration nor the refcase has changed. Nothing is
+   cached if @cache_dir is NULL.
+
    If called several times during one invocation the function will
    start by clearing the current content.
 */
 void enkf_obs_load(enkf_obs_type *enkf_obs, const char *config_file,
-                   double std_cutoff) {
+                   double std_cutoff, const char *cache_dir) {
 
     if (!enkf_obs_is_valid(enkf_obs))
         util_abort("%s cannot load invalid enkf observation config %s.\n",
@@ -644,7 +743,20 @@ void enkf_obs_load(enkf_obs_type *enkf_obs, const char *config_file,
         util_abort("%s: Can not proceed with this configuration: %s\n",
                    __func__, config_file);
 
-    handle_history_observation(enkf_obs, enkf_conf, last_report, std_cutoff);
+    std::uint64_t cache_key =
+        cache_dir ? enkf_obs_cache_key(enkf_obs, config_file, std_cutoff) : 0;
+    std::string cache_file =
+        cache_dir ? enkf_obs_cache_file(cache_dir, config_file) : "";
+    HistoryObsCache cache(cache_key);
+    bool cache_hit = cache_key != 0 && cache.load(cache_file);
+    if (cache_hit)
+        logger->info("Using cached history observations from: {}",
+                     cache_file);
+
+    handle_history_observation(enkf_obs, enkf_conf, last_report, std_cutoff,
+                               cache, cache_hit);
+    if (cache_key != 0 && !cache_hit)
+        cache.save(cache_file);
     handle_summary_observation(enkf_obs, enkf_conf, last_report);
     handle_block_observation(enkf_obs, enkf_conf);
     handle_general_observation(enkf_obs, enkf_conf);
@@ -15,9 +15,23 @@
    See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
    for more details.
 */
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ert/concurrency.hpp>
+#include <ert/python.hpp>
+
 #include <ert/enkf/enkf_fs.hpp>
+#include <ert/enkf/enkf_node.hpp>
 #include <ert/enkf/enkf_plot_data.hpp>
 #include <ert/enkf/enkf_plot_tvector.hpp>
+#include <ert/enkf/summary.hpp>
 
 #define ENKF_PLOT_DATA_TYPE_ID 3331063
 
@@ -109,3 +123,154 @@ void enkf_plot_data_load(enkf_plot_data_type *plot_data, enkf_fs_type *fs,
         }
     }
 }
+
+namespace {
+/**
+   Loads the realizations @realizations[begin, end) into their rows of @data
+   with one work node.
+*/
+void load_matrix_rows(const enkf_config_node_type *config_node,
+                      enkf_fs_type *fs, const char *index_key,
+                      const std::vector<bool> &mask,
+                      const std::vector<int> &realizations, int begin, int end,
+                      int step_count, double *data) {
+    const bool summary_mode =
+        enkf_config_node_get_impl_type(config_node) == SUMMARY;
+    enkf_node_type *node = enkf_node_alloc(config_node);
+    double_vector_type *work = double_vector_alloc(0, 0);
+
+    for (int index = begin; index < end; index++) {
+        int iens = realizations[index];
+        if (iens < 0 || iens >= static_cast<int>(mask.size()) || !mask[iens])
+            continue;
+
+        double *row = data + (size_t)index * step_count;
+        if (enkf_node_vector_storage(node)) {
+            if (!enkf_node_user_get_vector(node, fs, index_key, iens, work))
+                continue;
+
+            int size = std::min(double_vector_size(work), step_count);
+            for (int step = 0; step < size; step++)
+                row[step] = double_vector_iget(work, step);
+        } else {
+            for (int step = 0; step < step_count; step++) {
+                node_id_type node_id = {.report_step = step, .iens = iens};
+                double value;
+                if (enkf_node_user_get(node, fs, index_key, node_id, &value))
+                    row[step] = value;
+            }
+        }
+
+        /* The holes in the summary vector storage, as in enkf_plot_tvector */
+        if (summary_mode)
+            for (int step = 0; step < step_count; step++)
+                if (!summary_active_value(row[step]))
+                    row[step] = NAN;
+    }
+
+    double_vector_free(work);
+    enkf_node_free(node);
+}
+} // namespace
+
+/**
+   The number of steps in the matrix of enkf_plot_data_load_matrix(), i.e.
+   the report steps 0 to the last step of the time map of @fs.
+*/
+int enkf_plot_data_get_step_count(enkf_fs_type *fs) {
+    return time_map_get_last_step(enkf_fs_get_time_map(fs)) + 1;
+}
+
+/**
+   Loads @config_node for the realizations @realizations of @fs into @data,
+   a row major [realizations.size() x step_count] matrix with one row per
+   realization in the order of @realizations, where step_count is given by
+   enkf_plot_data_get_step_count(). The values are the ones
+   enkf_plot_data_load() gives; the values which are missing or inactive,
+   and the rows of realizations without data, are NAN.
+
+   The realizations are split in one block per thread, and every block is
+   loaded with its own work node.
+*/
+void enkf_plot_data_load_matrix(const enkf_config_node_type *config_node,
+                                enkf_fs_type *fs, const char *index_key,
+                                const std::vector<int> &realizations,
+                                double *data) {
+    state_map_type *state_map = enkf_fs_get_state_map(fs);
+    const int realization_count = realizations.size();
+    const int step_count = enkf_plot_data_get_step_count(fs);
+    std::fill_n(data, (size_t)realization_count * step_count, NAN);
+    if (realization_count == 0 || step_count == 0)
+        return;
+
+    std::vector<bool> mask =
+        state_map_select_matching(state_map, STATE_HAS_DATA, true);
+    const int block_count = std::clamp<int>(std::thread::hardware_concurrency(),
+                                            1, realization_count);
+    ert::parallel_for(block_count, [&](int block) {
+        load_matrix_rows(config_node, fs, index_key, mask, realizations,
+                         block * realization_count / block_count,
+                         (block + 1) * realization_count / block_count,
+                         step_count, data);
+    });
+}
+
+/**
+   Loads @config_node for the whole ensemble of @fs into @data, a row major
+   [ens_size x step_count] matrix where ens_size is the size of the state
+   map, see above.
+*/
+void enkf_plot_data_load_matrix(const enkf_config_node_type *config_node,
+                                enkf_fs_type *fs, const char *index_key,
+                                double *data) {
+    std::vector<int> realizations(
+        state_map_get_size(enkf_fs_get_state_map(fs)));
+    std::iota(realizations.begin(), realizations.end(), 0);
+    enkf_plot_data_load_matrix(config_node, fs, index_key, realizations, data);
+}
+
+RES_LIB_SUBMODULE("enkf_plot_data", m) {
+    m.def(
+        "load_matrix",
+        [](py::object config_node, py::object fs,
+           std::optional<std::string> index_key,
+           std::optional<std::vector<int>> realizations) {
+            auto enkf_config_node =
+                ert::from_cwrap<enkf_config_node_type>(config_node);
+            auto enkf_fs = ert::from_cwrap<enkf_fs_type>(fs);
+
+            if (!realizations) {
+                realizations.emplace(
+                    state_map_get_size(enkf_fs_get_state_map(enkf_fs)));
+                std::iota(realizations->begin(), realizations->end(), 0);
+            }
+            const int rows = realizations->size();
+            const int step_count = enkf_plot_data_get_step_count(enkf_fs);
+            // Owned by the unique_ptr until it is handed to numpy, so the
+            // matrix is not leaked if loading a realization throws
+            auto matrix = std::make_unique<double[]>((size_t)rows * step_count);
+            {
+                py::gil_scoped_release release;
+                enkf_plot_data_load_matrix(
+                    enkf_config_node, enkf_fs,
+                    index_key ? index_key->c_str() : NULL, *realizations,
+                    matrix.get());
+            }
+
+            double *data = matrix.get();
+            py::capsule free_when_done(matrix.release(), [](void *f) {
+                double *data = reinterpret_cast<double *>(f);
+                delete[] data;
+            });
+
+            return py::array_t<double>(
+                {rows, step_count}, // shape
+                {step_count * sizeof(double),
+                 sizeof(double)}, // C-style contiguous strides for double
+                data,             // the data pointer
+                free_when_done);  // numpy array references this parent
+        },
+        py::arg("config_node"), py::arg("fs"),
+        py::arg("index_key") = py::none(),
+        py::arg("realizations") = py::none());
+}
@@ -16,6 +16,8 @@
    for more details.
 */
 #include <assert.h>
+#include <vector>
+
 #include <ert/util/bool_vector.h>
 
 #include <ert/enkf/enkf_config_node.hpp>
@@ -110,17 +112,37 @@ void enkf_plot_gen_kw_load(enkf_plot_gen_kw_type *plot_gen_kw, enkf_fs_type *fs,
         mask = bool_vector_alloc(ens_size, true);
 
     enkf_plot_gen_kw_resize(plot_gen_kw, ens_size);
+    std::vector<enkf_plot_gen_kw_vector_type *> loaded;
     {
         int iens;
         for (iens = 0; iens < ens_size; ++iens) {
             if (bool_vector_iget(mask, iens)) {
                 enkf_plot_gen_kw_vector_type *vector =
                     enkf_plot_gen_kw_iget(plot_gen_kw, iens);
-                enkf_plot_gen_kw_vector_load(vector, fs, transform_data,
-                                             report_step);
+                enkf_plot_gen_kw_vector_load(vector, fs, false, report_step);
+                if (enkf_plot_gen_kw_vector_get_size(vector) > 0)
+                    loaded.push_back(vector);
             }
         }
     }
+    bool_vector_free(mask);
+
+    /* Each keyword is transformed for all the loaded realizations at once */
+    if (transform_data && !loaded.empty()) {
+        const gen_kw_config_type *gen_kw_config =
+            (const gen_kw_config_type *)enkf_config_node_get_ref(
+                plot_gen_kw->config_node);
+        std::vector<double> values(loaded.size());
+        for (int i_kw = 0; i_kw < gen_kw_config_get_data_size(gen_kw_config);
+             i_kw++) {
+            for (size_t i = 0; i < loaded.size(); i++)
+                values[i] = enkf_plot_gen_kw_vector_iget(loaded[i], i_kw);
+            gen_kw_config_transform_many(gen_kw_config, i_kw, values.data(),
+                                         values.data(), values.size());
+            for (size_t i = 0; i < loaded.size(); i++)
+                enkf_plot_gen_kw_vector_iset(loaded[i], i_kw, values[i]);
+        }
+    }
 }
 
 const char *enkf_plot_gen_kw_iget_key(const enkf_plot_gen_kw_type *plot_gen_kw,
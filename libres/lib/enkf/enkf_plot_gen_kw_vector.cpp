@@ -62,6 +62,11 @@ double enkf_plot_gen_kw_vector_iget(const enkf_plot_gen_kw_vector_type *vector,
     return double_vector_iget(vector->data, index);
 }
 
+void enkf_plot_gen_kw_vector_iset(enkf_plot_gen_kw_vector_type *vector,
+                                  int index, double value) {
+    double_vector_iset(vector->data, index, value);
+}
+
 void enkf_plot_gen_kw_vector_reset(enkf_plot_gen_kw_vector_type *vector) {
     double_vector_reset(vector->data);
 }
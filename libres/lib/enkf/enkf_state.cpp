@@ -16,6 +16,7 @@
    for more details.
 */
 
+#include <algorithm>
 #include <stdexcept>
 #include <stdio.h>
 #include <string.h>
@@ -24,12 +25,14 @@
 #include <vector>
 
 #include <ert/python.hpp>
+#include <ert/res_util/metric.hpp>
 #include <ert/res_util/subst_list.hpp>
 #include <ert/util/hash.h>
 #include <ert/util/rng.h>
 
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_util.h>
 
 #include <ert/job_queue/environment_varlist.hpp>
 #include <ert/job_queue/forward_model.hpp>
@@ -38,11 +41,19 @@
 #include <ert/enkf/enkf_node.hpp>
 #include <ert/enkf/enkf_state.hpp>
 #include <ert/enkf/gen_data.hpp>
+#include <ert/enkf/realization_manifest.hpp>
+#include <ert/enkf/summary.hpp>
 #include <ert/logging.hpp>
 
 static auto logger = ert::get_logger("enkf");
 #define ENKF_STATE_TYPE_ID 78132
 
+/*
+  The largest number of summary nodes of one realization which are held in
+  memory at the same time while the summary results are internalized.
+*/
+#define ENKF_STATE_SUMMARY_BATCH_SIZE 256
+
 /**
    This struct contains various objects which the enkf_state needs
    during operation, which the enkf_state_object *DOES NOT* own. The
@@ -276,6 +287,7 @@ enkf_state_internalize_dynamic_eclipse_results(
 
                 const ecl_smspec_type *smspec = ecl_sum_get_smspec(summary);
 
+                std::vector<enkf_config_node_type *> config_nodes;
                 for (int i = 0; i < ecl_smspec_num_nodes(smspec); i++) {
                     const ecl::smspec_node &smspec_node =
                         ecl_smspec_iget_node_w_node_index(smspec, i);
@@ -286,17 +298,36 @@ enkf_state_internalize_dynamic_eclipse_results(
                             enkf_fs_get_summary_key_set(sim_fs);
                         summary_key_set_add_summary_key(key_set, key);
 
-                        enkf_config_node_type *config_node =
+                        config_nodes.push_back(
                             ensemble_config_get_or_create_summary_node(
-                                ens_config, key);
-                        enkf_node_type *node = enkf_node_alloc(config_node);
+                                ens_config, key));
+                    }
+                }
+
+                // The keys are internalized in batches, with one pass over
+                // the ecl_sum instance per batch; only the nodes of one
+                // batch are held in memory at a time.
+                const std::size_t batch_size = ENKF_STATE_SUMMARY_BATCH_SIZE;
+                for (std::size_t begin = 0; begin < config_nodes.size();
+                     begin += batch_size) {
+                    std::size_t end =
+                        std::min(begin + batch_size, config_nodes.size());
+                    std::vector<enkf_node_type *> nodes;
+                    std::vector<summary_type *> summaries;
+                    for (std::size_t i = begin; i < end; i++) {
+                        enkf_node_type *node = enkf_node_alloc(config_nodes[i]);
 
                         // Ensure that what is currently on file is loaded
                         // before we update.
                         enkf_node_try_load_vector(node, sim_fs, iens);
+                        nodes.push_back(node);
+                        summaries.push_back(
+                            summary_safe_cast(enkf_node_value_ptr(node)));
+                    }
 
-                        enkf_node_forward_load_vector(node, load_context,
-                                                      time_index);
+                    summary_forward_load_vectors(summaries, summary,
+                                                 time_index);
+                    for (enkf_node_type *node : nodes) {
                         enkf_node_store_vector(node, sim_fs, iens);
                         enkf_node_free(node);
                     }
@@ -451,11 +482,129 @@ static std::pair<fw_load_status, std::string> enkf_state_internalize_results(
     return {result, ""};
 }
 
-static std::pair<fw_load_status, std::string>
+/**
+   The files in the runpath of @run_arg which loading the realization reads,
+   with their size and modification time. The configured keys - with the
+   summary patterns, the init and result files and the report steps to
+   load - are returned in @keys. A realization is reloaded when either has
+   changed since it was last loaded.
+*/
+static std::vector<realization_manifest_file_type>
+enkf_state_stat_manifest(const ensemble_config_type *ens_config,
+                         const model_config_type *model_config,
+                         const ecl_config_type *ecl_config,
+                         const run_arg_type *run_arg, std::string &keys) {
+    const summary_key_matcher_type *matcher =
+        ensemble_config_get_summary_key_matcher(ens_config);
+    std::vector<std::string> key_lines;
+    std::vector<std::string> paths;
+
+    stringlist_type *patterns = summary_key_matcher_get_keys(matcher);
+    for (int i = 0; i < stringlist_get_size(patterns); i++)
+        key_lines.push_back(stringlist_iget(patterns, i));
+    stringlist_free(patterns);
+
+    bool load_summary = summary_key_matcher_get_size(matcher) > 0 ||
+                        ensemble_config_require_summary(ens_config);
+    if (load_summary && ecl_config && ecl_config_active(ecl_config)) {
+        const bool fmt_file = ecl_config_get_formatted(ecl_config);
+        for (auto file_type :
+             {ECL_SUMMARY_HEADER_FILE, ECL_UNIFIED_SUMMARY_FILE}) {
+            char *file = ecl_util_alloc_filename(
+                NULL, run_arg_get_job_name(run_arg), file_type, fmt_file, -1);
+            paths.push_back(file);
+            free(file);
+        }
+    }
+
+    // The same report steps as enkf_state_internalize_GEN_DATA() loads.
+    enkf_fs_type *sim_fs = run_arg_get_sim_fs(run_arg);
+    int last_report = time_map_get_last_step(enkf_fs_get_time_map(sim_fs));
+    if (last_report < 0)
+        last_report = model_config_get_last_history_restart(model_config);
+    int start = run_arg_get_load_start(run_arg);
+    int stop = util_int_max(0, last_report);
+    int iens = run_arg_get_iens(run_arg);
+
+    stringlist_type *keylist = ensemble_config_alloc_keylist(ens_config);
+    for (int i = 0; i < stringlist_get_size(keylist); i++) {
+        const enkf_config_node_type *config_node =
+            ensemble_config_get_node(ens_config, stringlist_iget(keylist, i));
+        std::string key_line = stringlist_iget(keylist, i);
+
+        if (enkf_config_node_use_forward_init(config_node) &&
+            run_arg_get_step1(run_arg) == 0) {
+            char *init_file =
+                enkf_config_node_alloc_initfile(config_node, NULL, iens);
+            if (init_file) {
+                key_line += fmt::format(" init:{}", init_file);
+                paths.push_back(init_file);
+                free(init_file);
+            }
+        }
+
+        if (enkf_config_node_get_impl_type(config_node) == GEN_DATA) {
+            for (int report_step = start; report_step <= stop; report_step++) {
+                if (!enkf_config_node_internalize(config_node, report_step))
+                    continue;
+
+                char *input_file =
+                    enkf_config_node_alloc_infile(config_node, report_step);
+                key_line += fmt::format(" {}:{}", report_step,
+                                        input_file ? input_file : "");
+                if (input_file) {
+                    paths.push_back(input_file);
+                    paths.push_back(std::string(input_file) + "_active");
+                }
+                free(input_file);
+            }
+        }
+        key_lines.push_back(key_line);
+    }
+    stringlist_free(keylist);
+
+    std::sort(key_lines.begin(), key_lines.end());
+    keys.clear();
+    for (const auto &key_line : key_lines)
+        keys += key_line + '\n';
+
+    return realization_manifest_stat(run_arg_get_runpath(run_arg), paths);
+}
+
+/**
+   Unless @force is set, a realization which has data and whose runpath
+   files and configured keys are unchanged since it was last loaded, as
+   recorded in the realization manifest of the case, is not loaded again.
+   Only the files the loaders read are checked.
+
+   The files are stat'ed before the results are internalized, and that
+   snapshot is recorded when the load succeeds: a file which is rewritten
+   during the load then differs from the manifest, and the realization is
+   loaded again the next time.
+*/
+std::pair<fw_load_status, std::string>
 enkf_state_load_from_forward_model__(ensemble_config_type *ens_config,
                                      model_config_type *model_config,
                                      const ecl_config_type *ecl_config,
-                                     const run_arg_type *run_arg) {
+                                     const run_arg_type *run_arg, bool force) {
+    enkf_fs_type *sim_fs = run_arg_get_sim_fs(run_arg);
+    state_map_type *state_map = enkf_fs_get_state_map(sim_fs);
+    realization_manifest_type *manifest =
+        enkf_fs_get_realization_manifest(sim_fs);
+    int iens = run_arg_get_iens(run_arg);
+    const char *runpath = run_arg_get_runpath(run_arg);
+
+    std::string keys;
+    std::vector<realization_manifest_file_type> files =
+        enkf_state_stat_manifest(ens_config, model_config, ecl_config, run_arg,
+                                 keys);
+    if (!force && state_map_iget(state_map, iens) == STATE_HAS_DATA &&
+        realization_manifest_is_current(manifest, iens, runpath, keys, files))
+        return {LOAD_SUCCESSFUL, ""};
+
+    static const ert::metrics::Timer load_timer("forward_model.load");
+    auto timing = load_timer.time();
+
     std::pair<fw_load_status, std::string> result;
     if (ensemble_config_have_forward_init(ens_config))
         result = ensemble_config_forward_init(ens_config, run_arg);
@@ -463,27 +612,27 @@ enkf_state_load_from_forward_model__(ensemble_config_type *ens_config,
         result = enkf_state_internalize_results(ens_config, model_config,
                                                 ecl_config, run_arg);
     }
-    state_map_type *state_map =
-        enkf_fs_get_state_map(run_arg_get_sim_fs(run_arg));
-    int iens = run_arg_get_iens(run_arg);
-    if (result.first != LOAD_SUCCESSFUL)
+    if (result.first != LOAD_SUCCESSFUL) {
         state_map_iset(state_map, iens, STATE_LOAD_FAILURE);
-    else
+        realization_manifest_clear(manifest, iens);
+    } else {
         state_map_iset(state_map, iens, STATE_HAS_DATA);
+        realization_manifest_iset(manifest, iens, runpath, keys, files);
+    }
 
     return result;
 }
 
 std::pair<fw_load_status, std::string>
 enkf_state_load_from_forward_model(enkf_state_type *enkf_state,
-                                   run_arg_type *run_arg) {
+                                   run_arg_type *run_arg, bool force) {
 
     ensemble_config_type *ens_config = enkf_state->ensemble_config;
     model_config_type *model_config = enkf_state->shared_info->model_config;
     const ecl_config_type *ecl_config = enkf_state->shared_info->ecl_config;
 
     return enkf_state_load_from_forward_model__(ens_config, model_config,
-                                                ecl_config, run_arg);
+                                                ecl_config, run_arg, force);
 }
 
 void enkf_state_free(enkf_state_type *enkf_state) {
@@ -520,8 +669,8 @@ enkf_state_complete_forward_modelOK(const res_config_type *res_config,
         res_config_get_ensemble_config(res_config);
     const ecl_config_type *ecl_config = res_config_get_ecl_config(res_config);
     model_config_type *model_config = res_config_get_model_config(res_config);
-    auto result = enkf_state_load_from_forward_model__(ens_config, model_config,
-                                                       ecl_config, run_arg);
+    auto result = enkf_state_load_from_forward_model__(
+        ens_config, model_config, ecl_config, run_arg, true);
 
     if (result.first == LOAD_SUCCESSFUL) {
         result.second = "Results loaded successfully.";
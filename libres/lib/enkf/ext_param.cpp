@@ -22,6 +22,8 @@
 #include <stdlib.h>
 #include <vector>
 
+#include <cjson/cJSON.h>
+
 #include <ert/res_util/file_utils.hpp>
 #include <ert/util/util.h>
 
@@ -196,6 +198,73 @@ void ext_param_json_export(const ext_param_type *ext_param,
     fclose(stream);
 }
 
+/**
+   Sets the values in the JSON text @json_text, in the format written by
+   ext_param_json_export(): an object with a number for each key without
+   suffixes and an object with a number for each suffix otherwise.
+
+   The text is parsed once and every key and suffix is found through the
+   hash indexes of the config, so that setting the values is linear in the
+   number of values. Keys missing from the text keep their values. Returns
+   false if the text can not be parsed or has unknown keys, suffixes or
+   values which are not numbers; the values before the offending key are
+   then set.
+*/
+bool ext_param_set_from_json_string(ext_param_type *param,
+                                    const char *json_text) {
+    cJSON *json = cJSON_Parse(json_text);
+    if (!cJSON_IsObject(json)) {
+        cJSON_Delete(json);
+        return false;
+    }
+
+    bool ok = true;
+    const cJSON *item;
+    cJSON_ArrayForEach(item, json) {
+        int ikey = ext_param_config_get_key_index(param->config, item->string);
+        if (ikey < 0) {
+            ok = false;
+            break;
+        }
+
+        if (ext_param_config_ikey_get_suffix_count(param->config, ikey) == 0) {
+            ok = cJSON_IsNumber(item);
+            if (ok)
+                param->data[ikey][0] = item->valuedouble;
+        } else if (cJSON_IsObject(item)) {
+            const cJSON *suffix_item;
+            cJSON_ArrayForEach(suffix_item, item) {
+                int isuffix = ext_param_config_ikey_get_suffix_index(
+                    param->config, ikey, suffix_item->string);
+                ok = isuffix >= 0 && cJSON_IsNumber(suffix_item);
+                if (!ok)
+                    break;
+                param->data[ikey][isuffix] = suffix_item->valuedouble;
+            }
+        } else
+            ok = false;
+
+        if (!ok)
+            break;
+    }
+    cJSON_Delete(json);
+    return ok;
+}
+
+/**
+   As ext_param_set_from_json_string() for the content of the file
+   @json_file; returns false if the file does not exist.
+*/
+bool ext_param_set_from_json(ext_param_type *param, const char *json_file) {
+    if (!fs::is_regular_file(json_file))
+        return false;
+
+    char *content = util_fread_alloc_file_content(json_file, NULL);
+    bool ok = ext_param_set_from_json_string(param, content);
+    free(content);
+    return ok;
+}
+
 void ext_param_ecl_write(const ext_param_type *ext_param, const char *run_path,
                          const char *base_file, value_export_type *unused) {
     char *target_file;
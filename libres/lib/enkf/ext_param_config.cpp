@@ -18,8 +18,8 @@
 
 #include <stdlib.h>
 
-#include <algorithm>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <ert/util/type_macros.h>
@@ -34,6 +34,10 @@ struct ext_param_config_struct {
     std::string key;
     std::vector<std::string> keys;
     std::vector<std::vector<std::string>> suffixes;
+    /** From key to the index in keys */
+    std::unordered_map<std::string, int> key_index;
+    /** From suffix to the index in suffixes[ikey], for each key */
+    std::vector<std::unordered_map<std::string, int>> suffix_index;
 };
 
 UTIL_SAFE_CAST_FUNCTION(ext_param_config, EXT_PARAM_CONFIG_ID)
@@ -52,15 +56,13 @@ const char *ext_param_config_iget_key(const ext_param_config_type *config,
 
 int ext_param_config_get_key_index(const ext_param_config_type *config,
                                    const char *key) {
-    const auto it = std::find(config->keys.begin(), config->keys.end(), key);
-    return it == config->keys.end() ? -1
-                                    : std::distance(config->keys.begin(), it);
+    const auto it = config->key_index.find(key);
+    return it == config->key_index.end() ? -1 : it->second;
 }
 
 bool ext_param_config_has_key(const ext_param_config_type *config,
                               const char *key) {
-    return std::find(config->keys.begin(), config->keys.end(), key) !=
-           config->keys.end();
+    return config->key_index.count(key) > 0;
 }
 
 ext_param_config_type *ext_param_config_alloc(const char *key,
@@ -77,17 +79,23 @@ ext_param_config_type *ext_param_config_alloc(const char *key,
 
     for (int i = 0; i < stringlist_get_size(keys); i++) {
         config->keys.push_back(stringlist_iget(keys, i));
+        config->key_index.emplace(config->keys.back(), i);
     }
     config->suffixes.resize(stringlist_get_size(keys));
+    config->suffix_index.resize(stringlist_get_size(keys));
     return config;
 }
 
 void ext_param_config_ikey_set_suffixes(ext_param_config_type *config, int ikey,
                                         const stringlist_type *suffixes) {
     auto tmp = std::vector<std::string>(stringlist_get_size(suffixes));
-    for (int isuffix = 0; isuffix < stringlist_get_size(suffixes); isuffix++)
+    std::unordered_map<std::string, int> index;
+    for (int isuffix = 0; isuffix < stringlist_get_size(suffixes); isuffix++) {
         tmp[isuffix] = stringlist_iget(suffixes, isuffix);
+        index.emplace(tmp[isuffix], isuffix);
+    }
     config->suffixes[ikey] = std::move(tmp);
+    config->suffix_index[ikey] = std::move(index);
 }
 
 int ext_param_config_ikey_get_suffix_count(const ext_param_config_type *config,
@@ -103,11 +111,9 @@ ext_param_config_ikey_iget_suffix(const ext_param_config_type *config, int ikey,
 
 int ext_param_config_ikey_get_suffix_index(const ext_param_config_type *config,
                                            int ikey, const char *suffix) {
-    const auto it = std::find(config->suffixes[ikey].begin(),
-                              config->suffixes[ikey].end(), suffix);
-    return it == config->suffixes[ikey].end()
-               ? -1
-               : std::distance(config->suffixes[ikey].begin(), it);
+    const auto &index = config->suffix_index[ikey];
+    const auto it = index.find(suffix);
+    return it == index.end() ? -1 : it->second;
 }
 
 VOID_FREE(ext_param_config)
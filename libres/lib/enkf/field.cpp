@@ -16,6 +16,7 @@
    for more details.
 */
 
+#include <algorithm>
 #include <filesystem>
 
 #include <Eigen/Dense>
@@ -33,9 +34,11 @@
 #include <ert/ecl/fortio.h>
 
 #include <ert/rms/rms_file.hpp>
+#include <ert/rms/rms_index.hpp>
 #include <ert/rms/rms_util.hpp>
 
 #include <ert/enkf/field.hpp>
+#include <ert/enkf/node_codec.hpp>
 
 namespace fs = std::filesystem;
 
@@ -72,55 +75,42 @@ struct field_struct {
     char *__data;
 };
 
-#define EXPORT_MACRO                                                           \
-    {                                                                          \
-        int nx, ny, nz;                                                        \
-        field_config_get_dims(field->config, &nx, &ny, &nz);                   \
-        int i, j, k;                                                           \
-        for (k = 0; k < nz; k++) {                                             \
-            for (j = 0; j < ny; j++) {                                         \
-                for (i = 0; i < nx; i++) {                                     \
-                    bool active_cell =                                         \
-                        field_config_active_cell(config, i, j, k);             \
-                    bool use_initial_value = false;                            \
-                                                                               \
-                    if (init_file && !active_cell)                             \
-                        use_initial_value = true;                              \
-                                                                               \
-                    int source_index = 0;                                      \
-                    if (use_initial_value)                                     \
-                        source_index =                                         \
-                            field_config_global_index(config, i, j, k);        \
-                    else                                                       \
-                        source_index =                                         \
-                            field_config_active_index(config, i, j, k);        \
-                                                                               \
-                    int target_index;                                          \
-                    if (rms_index_order)                                       \
-                        target_index = rms_util_global_index_from_eclipse_ijk( \
-                            nx, ny, nz, i, j, k);                              \
-                    else                                                       \
-                        target_index = i + j * nx + k * nx * ny;               \
-                                                                               \
-                    if (use_initial_value)                                     \
-                        target_data[target_index] =                            \
-                            initial_src_data[source_index];                    \
-                    else if (active_cell)                                      \
-                        target_data[target_index] = src_data[source_index];    \
-                    else                                                       \
-                        memcpy(&target_data[target_index], fill_value,         \
-                               sizeof_ctype_target);                           \
-                }                                                              \
-            }                                                                  \
-        }                                                                      \
+/**
+   Writes all the cells of the grid to @target_data, in the order of
+   @rms_index_order, gathering the active cells from @src_data. Inactive
+   cells are taken from @initial_src_data, which holds all the cells in
+   the eclipse order, if it is given, and are set to @fill_value otherwise.
+*/
+template <typename S, typename T>
+static void field_export3D__(const field_config_type *config,
+                             const S *src_data, const S *initial_src_data,
+                             T *target_data, bool rms_index_order,
+                             const void *fill_value) {
+    const int volume = field_config_get_volume(config);
+    const int *active_index =
+        field_config_get_active_permutation(config, rms_index_order);
+    const int *global_index =
+        initial_src_data && rms_index_order
+            ? field_config_get_rms_global_permutation(config)
+            : NULL;
+
+    for (int index = 0; index < volume; index++) {
+        int source_index = active_index[index];
+        if (source_index >= 0)
+            target_data[index] = src_data[source_index];
+        else if (initial_src_data)
+            target_data[index] =
+                initial_src_data[global_index ? global_index[index] : index];
+        else
+            memcpy(&target_data[index], fill_value, sizeof(T));
     }
+}
 
 void field_export3D(const field_type *field, void *_target_data,
                     bool rms_index_order, ecl_data_type target_data_type,
                     void *fill_value, const char *init_file) {
     const field_config_type *config = field->config;
     ecl_data_type data_type = field_config_get_ecl_data_type(config);
-    int sizeof_ctype_target = ecl_type_get_sizeof_ctype(target_data_type);
 
     field_type *initial_field = NULL;
     field_config_type *initial_field_config = NULL;
@@ -141,10 +131,12 @@ void field_export3D(const field_type *field, void *_target_data,
 
         if (ecl_type_is_float(target_data_type)) {
             float *target_data = (float *)_target_data;
-            EXPORT_MACRO;
+            field_export3D__(config, src_data, initial_src_data, target_data,
+                             rms_index_order, fill_value);
         } else if (ecl_type_is_double(target_data_type)) {
             double *target_data = (double *)_target_data;
-            EXPORT_MACRO;
+            field_export3D__(config, src_data, initial_src_data, target_data,
+                             rms_index_order, fill_value);
         } else {
             fprintf(stderr,
                     "%s: double field can only export to double/float\n",
@@ -158,10 +150,12 @@ void field_export3D(const field_type *field, void *_target_data,
             initial_field ? (const float *)initial_field->data : NULL;
         if (ecl_type_is_float(target_data_type)) {
             float *target_data = (float *)_target_data;
-            EXPORT_MACRO;
+            field_export3D__(config, src_data, initial_src_data, target_data,
+                             rms_index_order, fill_value);
         } else if (ecl_type_is_double(target_data_type)) {
             double *target_data = (double *)_target_data;
-            EXPORT_MACRO;
+            field_export3D__(config, src_data, initial_src_data, target_data,
+                             rms_index_order, fill_value);
         } else {
             fprintf(stderr, "%s: float field can only export to double/float\n",
                     __func__);
@@ -174,13 +168,16 @@ void field_export3D(const field_type *field, void *_target_data,
             initial_field ? (const int *)initial_field->data : NULL;
         if (ecl_type_is_float(target_data_type)) {
             float *target_data = (float *)_target_data;
-            EXPORT_MACRO;
+            field_export3D__(config, src_data, initial_src_data, target_data,
+                             rms_index_order, fill_value);
         } else if (ecl_type_is_double(target_data_type)) {
             double *target_data = (double *)_target_data;
-            EXPORT_MACRO;
+            field_export3D__(config, src_data, initial_src_data, target_data,
+                             rms_index_order, fill_value);
         } else if (ecl_type_is_int(target_data_type)) {
             int *target_data = (int *)_target_data;
-            EXPORT_MACRO;
+            field_export3D__(config, src_data, initial_src_data, target_data,
+                             rms_index_order, fill_value);
         } else {
             fprintf(stderr,
                     "%s: int field can only export to int/double/float\n",
@@ -199,36 +196,31 @@ void field_export3D(const field_type *field, void *_target_data,
         field_free(initial_field);
     }
 }
-#undef EXPORT_MACRO
-
-#define IMPORT_MACRO                                                           \
-    {                                                                          \
-        int i, j, k;                                                           \
-        int nx, ny, nz;                                                        \
-        field_config_get_dims(field->config, &nx, &ny, &nz);                   \
-        for (k = 0; k < nz; k++) {                                             \
-            for (j = 0; j < ny; j++) {                                         \
-                for (i = 0; i < nx; i++) {                                     \
-                    int target_index =                                         \
-                        keep_inactive_cells                                    \
-                            ? field_config_global_index(config, i, j, k)       \
-                            : field_config_active_index(config, i, j, k);      \
-                                                                               \
-                    if (target_index >= 0) {                                   \
-                        int source_index;                                      \
-                        if (rms_index_order)                                   \
-                            source_index =                                     \
-                                rms_util_global_index_from_eclipse_ijk(        \
-                                    nx, ny, nz, i, j, k);                      \
-                        else                                                   \
-                            source_index = i + j * nx + k * nx * ny;           \
-                                                                               \
-                        target_data[target_index] = src_data[source_index];    \
-                    }                                                          \
-                }                                                              \
-            }                                                                  \
-        }                                                                      \
+/**
+   Copies the cells of @src_data, which holds all the cells of the grid in
+   the order of @rms_index_order, to @target_data. Only the active cells are
+   copied unless @keep_inactive_cells is set.
+*/
+template <typename S, typename T>
+static void field_import3D__(const field_config_type *config,
+                             const S *src_data, T *target_data,
+                             bool rms_index_order, bool keep_inactive_cells) {
+    const int volume = field_config_get_volume(config);
+    if (keep_inactive_cells) {
+        const int *global_index =
+            rms_index_order ? field_config_get_rms_global_permutation(config)
+                            : NULL;
+        for (int index = 0; index < volume; index++)
+            target_data[global_index ? global_index[index] : index] =
+                src_data[index];
+    } else {
+        const int *active_index =
+            field_config_get_active_permutation(config, rms_index_order);
+        for (int index = 0; index < volume; index++)
+            if (active_index[index] >= 0)
+                target_data[active_index[index]] = src_data[index];
     }
+}
 
 /**
    The main function of the field_import3D and field_export3D
@@ -260,13 +252,16 @@ static void field_import3D(field_type *field, const void *_src_data,
         double *target_data = (double *)field->data;
         if (ecl_type_is_float(src_type)) {
             float *src_data = (float *)_src_data;
-            IMPORT_MACRO;
+            field_import3D__(config, src_data, target_data, rms_index_order,
+                             keep_inactive_cells);
         } else if (ecl_type_is_double(src_type)) {
             double *src_data = (double *)_src_data;
-            IMPORT_MACRO;
+            field_import3D__(config, src_data, target_data, rms_index_order,
+                             keep_inactive_cells);
         } else if (ecl_type_is_int(src_type)) {
             int *src_data = (int *)_src_data;
-            IMPORT_MACRO;
+            field_import3D__(config, src_data, target_data, rms_index_order,
+                             keep_inactive_cells);
         } else {
             fprintf(stderr,
                     "%s: double field can only import from int/double/float\n",
@@ -278,13 +273,16 @@ static void field_import3D(field_type *field, const void *_src_data,
         float *target_data = (float *)field->data;
         if (ecl_type_is_float(src_type)) {
             float *src_data = (float *)_src_data;
-            IMPORT_MACRO;
+            field_import3D__(config, src_data, target_data, rms_index_order,
+                             keep_inactive_cells);
         } else if (ecl_type_is_double(src_type)) {
             double *src_data = (double *)_src_data;
-            IMPORT_MACRO;
+            field_import3D__(config, src_data, target_data, rms_index_order,
+                             keep_inactive_cells);
         } else if (ecl_type_is_int(src_type)) {
             int *src_data = (int *)_src_data;
-            IMPORT_MACRO;
+            field_import3D__(config, src_data, target_data, rms_index_order,
+                             keep_inactive_cells);
         } else {
             fprintf(stderr,
                     "%s: double field can only import from int/double/float\n",
@@ -296,7 +294,8 @@ static void field_import3D(field_type *field, const void *_src_data,
         int *target_data = (int *)field->data;
         if (ecl_type_is_int(src_type)) {
             int *src_data = (int *)_src_data;
-            IMPORT_MACRO;
+            field_import3D__(config, src_data, target_data, rms_index_order,
+                             keep_inactive_cells);
         } else {
             fprintf(stderr, "%s: int field can only import from int\n",
                     __func__);
@@ -309,8 +308,6 @@ static void field_import3D(field_type *field, const void *_src_data,
         break;
     }
 }
-#undef IMPORT_MACRO
-
 #define CLEAR_MACRO(d, s)                                                      \
     {                                                                          \
         int k;                                                                 \
@@ -389,8 +386,9 @@ void field_read_from_buffer(field_type *field, buffer_type *buffer,
     int byte_size = field_config_get_byte_size(field->config);
     enkf_util_assert_buffer_type(buffer,
                                  FIELD); // FIXME flaky runpath_list test
-    buffer_fread_compressed(buffer, buffer_get_remaining_size(buffer),
-                            field->data, byte_size);
+    int element_size = ecl_type_get_sizeof_ctype(
+        field_config_get_ecl_data_type(field->config));
+    node_codec_fread(buffer, field->data, element_size, byte_size);
 }
 
 static void *__field_alloc_3D_data(const field_type *field, int data_size,
@@ -537,8 +535,11 @@ void field_ROFF_export(const field_type *field, const char *export_filename,
 bool field_write_to_buffer(const field_type *field, buffer_type *buffer,
                            int report_step) {
     int byte_size = field_config_get_byte_size(field->config);
+    int element_size = ecl_type_get_sizeof_ctype(
+        field_config_get_ecl_data_type(field->config));
     buffer_fwrite_int(buffer, FIELD);
-    buffer_fwrite_compressed(buffer, field->data, byte_size);
+    node_codec_fwrite(buffer, node_codec_get(FIELD), field->data,
+                      element_size, byte_size);
     return true;
 }
 
@@ -596,7 +597,13 @@ void field_ecl_grdecl_export(const field_type *field, FILE *stream,
     free(data);
 }
 
-static void field_apply(field_type *field, field_func_type *func) {
+/**
+   Applies @func to every cell of the field. For float fields the array
+   version @array_func is used when available, which transforms all the
+   cells in one call instead of calling @func through a pointer per cell.
+*/
+static void field_apply(field_type *field, field_func_type *func,
+                        field_array_func_type *array_func) {
     field_config_assert_unary(field->config, __func__);
     {
         const int data_size = field_config_get_data_size(field->config);
@@ -605,8 +612,11 @@ static void field_apply(field_type *field, field_func_type *func) {
 
         if (ecl_type_is_float(data_type)) {
             float *data = (float *)field->data;
-            for (int i = 0; i < data_size; i++)
-                data[i] = func(data[i]);
+            if (array_func)
+                array_func(data, data_size);
+            else
+                for (int i = 0; i < data_size; i++)
+                    data[i] = func(data[i]);
         } else if (ecl_type_is_double(data_type)) {
             double *data = (double *)field->data;
             for (int i = 0; i < data_size; i++)
@@ -639,18 +649,26 @@ void field_inplace_output_transform(field_type *field) {
     field_func_type *output_transform =
         field_config_get_output_transform(field->config);
     if (output_transform != NULL)
-        field_apply(field, output_transform);
+        field_apply(field, output_transform,
+                    field_config_get_output_array_transform(field->config));
 }
 
-#define TRUNCATE_MACRO(s, d, t, min, max)                                      \
-    for (int i = 0; i < s; i++) {                                              \
-        if (t & TRUNCATE_MIN)                                                  \
-            if (d[i] < min)                                                    \
-                d[i] = min;                                                    \
-        if (t & TRUNCATE_MAX)                                                  \
-            if (d[i] > max)                                                    \
-                d[i] = max;                                                    \
-    }
+/**
+   The truncation is done in one branch free pass per limit, so that the
+   loops can be vectorized. As with a plain comparison, NaN values are left
+   unchanged.
+*/
+template <typename T>
+static void field_truncate(T *data, int size, int truncation, T min_value,
+                           T max_value) {
+    if (truncation & TRUNCATE_MIN)
+        for (int i = 0; i < size; i++)
+            data[i] = std::max(data[i], min_value);
+
+    if (truncation & TRUNCATE_MAX)
+        for (int i = 0; i < size; i++)
+            data[i] = std::min(data[i], max_value);
+}
 
 static void field_apply_truncation(field_type *field) {
     int truncation = field_config_get_truncation_mode(field->config);
@@ -662,11 +680,11 @@ static void field_apply_truncation(field_type *field) {
         const ecl_data_type data_type =
             field_config_get_ecl_data_type(field->config);
         if (ecl_type_is_float(data_type)) {
-            float *data = (float *)field->data;
-            TRUNCATE_MACRO(data_size, data, truncation, min_value, max_value);
+            field_truncate<float>((float *)field->data, data_size, truncation,
+                                  min_value, max_value);
         } else if (ecl_type_is_double(data_type)) {
-            double *data = (double *)field->data;
-            TRUNCATE_MACRO(data_size, data, truncation, min_value, max_value);
+            field_truncate<double>((double *)field->data, data_size,
+                                   truncation, min_value, max_value);
         } else
             util_abort("%s: Field type not supported for truncation \n",
                        __func__);
@@ -799,7 +817,9 @@ bool field_initialize(field_type *field, int iens, const char *init_file,
          prior to export.
       */
             if (init_transform) {
-                field_apply(field, init_transform);
+                field_apply(
+                    field, init_transform,
+                    field_config_get_init_array_transform(field->config));
                 if (!field_check_finite(field))
                     util_exit(
                         "Sorry: after applying the init transform field:%s "
@@ -946,6 +966,11 @@ void field_copy_ecl_kw_data(field_type *field, const ecl_kw_type *ecl_kw) {
                                field_type, kw_type, ecl_kw_get_size(ecl_kw));
 }
 
+/**
+   Only the headers of the ROFF file are scanned, and the data of the
+   parameter is read directly in the data type of the field; the other
+   parameters in the file are not loaded.
+*/
 bool field_fload_rms(field_type *field, const char *filename,
                      bool keep_inactive) {
     {
@@ -956,41 +981,41 @@ bool field_fload_rms(field_type *field, const char *filename,
         fclose(stream);
     }
 
-    {
-        const char *key = field_config_get_ecl_kw_name(field->config);
-        rms_file_type *rms_file = rms_file_alloc(filename, false);
-        rms_tagkey_type *data_tag;
-        if (field_config_enkf_mode(field->config))
-            data_tag = rms_file_fread_alloc_data_tagkey(rms_file, "parameter",
-                                                        "name", key);
-        else {
-            /*
+    const char *key = field_config_get_ecl_kw_name(field->config);
+    rms_index_type *index = rms_index_alloc(filename);
+    const rms_index_entry_type *data_entry;
+    if (field_config_enkf_mode(field->config))
+        data_entry = rms_index_find(index, "parameter", key, "data");
+    else {
+        /*
           Setting the key - purely to support converting between
           different types of files, without knowing the key. A usable
           feature - but not really well defined.
-      */
-
-            rms_tag_type *rms_tag =
-                rms_file_fread_alloc_tag(rms_file, "parameter", NULL, NULL);
-            const char *parameter_name = rms_tag_get_namekey_name(rms_tag);
+        */
+        data_entry = rms_index_find(index, "parameter", NULL, "data");
+        if (data_entry != NULL)
             field_config_set_key((field_config_type *)field->config,
-                                 parameter_name);
-            data_tag = rms_tagkey_copyc(rms_tag_get_key(rms_tag, "data"));
-            rms_tag_free(rms_tag);
-        }
+                                 data_entry->name.c_str());
+    }
 
-        ecl_data_type data_type = rms_tagkey_get_ecl_data_type(data_tag);
-        if (rms_tagkey_get_size(data_tag) !=
-            field_config_get_volume(field->config))
-            util_abort("%s: trying to import rms_data_tag from:%s with wrong "
-                       "size - aborting \n",
-                       __func__, filename);
+    if (data_entry == NULL)
+        util_abort("%s: could not find parameter:%s in file:%s - aborting \n",
+                   __func__, key, filename);
 
-        field_import3D(field, rms_tagkey_get_data_ref(data_tag), true,
-                       keep_inactive, data_type);
-        rms_tagkey_free(data_tag);
-        rms_file_free(rms_file);
-    }
+    const int data_size = field_config_get_volume(field->config);
+    if (data_entry->size != data_size)
+        util_abort("%s: trying to import rms_data_tag from:%s with wrong "
+                   "size - aborting \n",
+                   __func__, filename);
+
+    ecl_data_type data_type = field_config_get_ecl_data_type(field->config);
+    void *data = util_calloc(data_size, ecl_type_get_sizeof_ctype(data_type));
+    rms_index_fread(index, data_entry, rms_util_convert_ecl_type(data_type),
+                    data);
+    field_import3D(field, data, true, keep_inactive, data_type);
+
+    free(data);
+    rms_index_free(index);
     return true;
 }
 
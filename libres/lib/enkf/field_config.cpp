@@ -16,6 +16,7 @@
    for more details.
 */
 
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -26,6 +27,7 @@
 #include <ert/ecl/ecl_grid.h>
 
 #include <ert/rms/rms_file.hpp>
+#include <ert/rms/rms_util.hpp>
 
 #include <ert/enkf/config_keys.hpp>
 #include <ert/enkf/enkf_defaults.hpp>
@@ -144,9 +146,13 @@ struct field_config_struct {
     field_trans_table_type *trans_table;
     /** Function to apply to the data before they are exported - NULL: no transform. */
     field_func_type *output_transform;
+    /** output_transform applied to a whole array - NULL: not available. */
+    field_array_func_type *output_array_transform;
     /** Function to apply on the data when they are loaded the first time -
      * i.e. initialized. NULL : no transform*/
     field_func_type *init_transform;
+    /** init_transform applied to a whole array - NULL: not available. */
+    field_array_func_type *init_array_transform;
     /** Function to apply on the data when they are loaded from the forward
      * model - i.e. for dynamic data. */
     field_func_type *input_transform;
@@ -154,6 +160,13 @@ struct field_config_struct {
     char *output_transform_name;
     char *init_transform_name;
     char *input_transform_name;
+
+    /** Lazily built cell index tables for import and export, see
+     * field_config_get_active_permutation(). Guarded by index_mutex. */
+    pthread_mutex_t index_mutex;
+    int *ecl_active_index;
+    int *rms_active_index;
+    int *rms_global_index;
 };
 
 UTIL_IS_INSTANCE_FUNCTION(field_config, FIELD_CONFIG_ID)
@@ -276,6 +289,15 @@ field_config_get_output_transform_name(const field_config_type *field_config) {
     return field_config->output_transform_name;
 }
 
+static void field_config_free_index_tables(field_config_type *config) {
+    free(config->ecl_active_index);
+    free(config->rms_active_index);
+    free(config->rms_global_index);
+    config->ecl_active_index = NULL;
+    config->rms_active_index = NULL;
+    config->rms_global_index = NULL;
+}
+
 /**
    IFF the @private_grid parameter is true, the field_config instance
    will take ownership of grid, i.e. freeing it in
@@ -296,6 +318,7 @@ void field_config_set_grid(field_config_type *config, ecl_grid_type *grid,
 
     ecl_grid_get_dims(grid, &config->nx, &config->ny, &config->nz, NULL);
     config->data_size = field_config_get_data_size_from_grid(config);
+    field_config_free_index_tables(config);
 }
 
 const char *field_config_get_grid_name(const field_config_type *config) {
@@ -323,8 +346,10 @@ field_config_type *field_config_alloc_empty(const char *ecl_kw_name,
     config->type = UNKNOWN_FIELD_TYPE;
 
     config->output_transform = NULL;
+    config->output_array_transform = NULL;
     config->input_transform = NULL;
     config->init_transform = NULL;
+    config->init_array_transform = NULL;
     config->output_transform_name = NULL;
     config->input_transform_name = NULL;
     config->init_transform_name = NULL;
@@ -333,6 +358,11 @@ field_config_type *field_config_alloc_empty(const char *ecl_kw_name,
     config->min_std = NULL;
     config->trans_table = trans_table;
 
+    pthread_mutex_init(&config->index_mutex, NULL);
+    config->ecl_active_index = NULL;
+    config->rms_active_index = NULL;
+    config->rms_global_index = NULL;
+
     field_config_set_grid(
         config, ecl_grid,
         false); /* The grid is (currently) set on allocation and can NOT be updated afterwards. */
@@ -358,11 +388,15 @@ static void field_config_set_init_transform(field_config_type *config,
 
     config->init_transform_name = util_realloc_string_copy(
         config->init_transform_name, init_transform_name);
-    if (init_transform_name != NULL)
+    if (init_transform_name != NULL) {
         config->init_transform =
             field_trans_table_lookup(config->trans_table, init_transform_name);
-    else
+        config->init_array_transform = field_trans_table_lookup_array(
+            config->trans_table, init_transform_name);
+    } else {
         config->init_transform = NULL;
+        config->init_array_transform = NULL;
+    }
 }
 
 static void
@@ -382,11 +416,15 @@ field_config_set_output_transform(field_config_type *config,
 
     config->output_transform_name = util_realloc_string_copy(
         config->output_transform_name, output_transform_name);
-    if (output_transform_name != NULL)
+    if (output_transform_name != NULL) {
         config->output_transform = field_trans_table_lookup(
             config->trans_table, output_transform_name);
-    else
+        config->output_array_transform = field_trans_table_lookup_array(
+            config->trans_table, output_transform_name);
+    } else {
         config->output_transform = NULL;
+        config->output_array_transform = NULL;
+    }
 }
 
 static void
@@ -502,6 +540,66 @@ int field_config_global_index(const field_config_type *config, int i, int j,
     return ecl_grid_get_global_index3(config->grid, i, j, k);
 }
 
+static void field_config_build_index_tables(field_config_type *config) {
+    const int volume = field_config_get_volume(config);
+    config->ecl_active_index = (int *)util_malloc(volume * sizeof(int));
+    config->rms_active_index = (int *)util_malloc(volume * sizeof(int));
+    config->rms_global_index = (int *)util_malloc(volume * sizeof(int));
+
+    for (int k = 0; k < config->nz; k++) {
+        for (int j = 0; j < config->ny; j++) {
+            for (int i = 0; i < config->nx; i++) {
+                int global_index = field_config_global_index(config, i, j, k);
+                int active_index = field_config_active_index(config, i, j, k);
+                int rms_index = rms_util_global_index_from_eclipse_ijk(
+                    config->nx, config->ny, config->nz, i, j, k);
+
+                config->ecl_active_index[global_index] = active_index;
+                config->rms_active_index[rms_index] = active_index;
+                config->rms_global_index[rms_index] = global_index;
+            }
+        }
+    }
+}
+
+static const int *field_config_get_index_table(const field_config_type *config,
+                                               int *const *table) {
+    auto *mutable_config = (field_config_type *)config;
+    pthread_mutex_lock(&mutable_config->index_mutex);
+    if (*table == NULL)
+        field_config_build_index_tables(mutable_config);
+    pthread_mutex_unlock(&mutable_config->index_mutex);
+    return *table;
+}
+
+/**
+   Exported 3D fields hold all the nx*ny*nz cells of the grid, either in
+   the eclipse order, where i runs fastest, or in the RMS order, where k
+   runs fastest and is flipped. This function returns, for every position
+   of the exported field, the active index of the cell at that position or
+   -1 if the cell is inactive; the table is a gather permutation for export
+   and a scatter permutation for import.
+
+   The tables are built once, on first use, and shared by all the fields
+   of the config.
+*/
+const int *field_config_get_active_permutation(const field_config_type *config,
+                                               bool rms_index_order) {
+    return field_config_get_index_table(
+        config, rms_index_order ? &config->rms_active_index
+                                : &config->ecl_active_index);
+}
+
+/**
+   The global index of the cell at every position of a field exported in
+   RMS order; used for fields which keep the inactive cells. In the eclipse
+   order the global index is the position itself.
+*/
+const int *
+field_config_get_rms_global_permutation(const field_config_type *config) {
+    return field_config_get_index_table(config, &config->rms_global_index);
+}
+
 /**
     This function checks that i,j,k are in the intervals [0..nx),
     [0..ny) and [0..nz). It does *NOT* check if the corresponding
@@ -556,6 +654,8 @@ void field_config_free(field_config_type *config) {
     free(config->input_transform_name);
     free(config->output_transform_name);
     free(config->init_transform_name);
+    field_config_free_index_tables(config);
+    pthread_mutex_destroy(&config->index_mutex);
     if ((config->private_grid) && (config->grid != NULL))
         ecl_grid_free(config->grid);
     free(config);
@@ -670,6 +770,16 @@ field_config_get_init_transform(const field_config_type *config) {
     return config->init_transform;
 }
 
+field_array_func_type *
+field_config_get_output_array_transform(const field_config_type *config) {
+    return config->output_array_transform;
+}
+
+field_array_func_type *
+field_config_get_init_array_transform(const field_config_type *config) {
+    return config->init_array_transform;
+}
+
 /**
   This function asserts that a unary function can be applied
   to the field - i.e. that the underlying data_type is ecl_float or ecl_double.
@@ -28,6 +28,7 @@
   Documentation on how to add a new transformation function is at the
   bottom of the file.
 */
+#include <algorithm>
 #include <cmath>
 #include <string.h>
 
@@ -44,17 +45,21 @@ typedef struct {
     char *key;
     char *description;
     field_func_type *func;
+    /** The same transformation applied to a whole array, can be NULL. */
+    field_array_func_type *array_func;
 } field_func_node_type;
 
-static field_func_node_type *field_func_node_alloc(const char *key,
-                                                   const char *description,
-                                                   field_func_type *func) {
+static field_func_node_type *
+field_func_node_alloc(const char *key, const char *description,
+                      field_func_type *func,
+                      field_array_func_type *array_func) {
     field_func_node_type *node =
         (field_func_node_type *)util_malloc(sizeof *node);
 
     node->key = util_alloc_string_copy(key);
     node->description = util_alloc_string_copy(description);
     node->func = func;
+    node->array_func = array_func;
 
     return node;
 }
@@ -78,7 +83,8 @@ static void field_func_node_fprintf(const field_func_node_type *node,
 }
 
 void field_trans_table_add(field_trans_table_type *table, const char *_key,
-                           const char *description, field_func_type *func) {
+                           const char *description, field_func_type *func,
+                           field_array_func_type *array_func) {
     char *key;
 
     if (table->case_sensitive)
@@ -88,7 +94,7 @@ void field_trans_table_add(field_trans_table_type *table, const char *_key,
 
     {
         field_func_node_type *node =
-            field_func_node_alloc(key, description, func);
+            field_func_node_alloc(key, description, func, array_func);
         hash_insert_hash_owned_ref(table->function_table, key, node,
                                    field_func_node_free__);
     }
@@ -114,13 +120,12 @@ void field_trans_table_fprintf(const field_trans_table_type *table,
 }
 
 /**
-  This function takes a key input, and returns a pointer to the
-  corresponding function. The function will fail if the key is not
-  recognized.
+  This function takes a key input, and returns the corresponding
+  function node. The function will fail if the key is not recognized.
 */
-field_func_type *field_trans_table_lookup(field_trans_table_type *table,
-                                          const char *_key) {
-    field_func_type *func;
+static const field_func_node_type *
+field_trans_table_get_node(field_trans_table_type *table, const char *_key) {
+    const field_func_node_type *func_node;
     char *key;
 
     if (table->case_sensitive)
@@ -128,21 +133,41 @@ field_func_type *field_trans_table_lookup(field_trans_table_type *table,
     else
         key = util_alloc_strupr_copy(_key);
 
-    if (hash_has_key(table->function_table, key)) {
-        field_func_node_type *func_node =
-            (field_func_node_type *)hash_get(table->function_table, key);
-        func = func_node->func;
-    } else {
+    if (hash_has_key(table->function_table, key))
+        func_node =
+            (const field_func_node_type *)hash_get(table->function_table, key);
+    else {
         fprintf(stderr,
                 "Sorry: the field transformation function:%s is not recognized "
                 "\n\n",
                 key);
         field_trans_table_fprintf(table, stderr);
         util_exit("Exiting ... \n");
-        func = NULL; /* Compiler shut up. */
+        func_node = NULL; /* Compiler shut up. */
     }
     free(key);
-    return func;
+    return func_node;
+}
+
+/**
+  This function takes a key input, and returns a pointer to the
+  corresponding function. The function will fail if the key is not
+  recognized.
+*/
+field_func_type *field_trans_table_lookup(field_trans_table_type *table,
+                                          const char *_key) {
+    return field_trans_table_get_node(table, _key)->func;
+}
+
+/**
+  As field_trans_table_lookup(), but returns the version of the function
+  which transforms a whole array; that is NULL for functions which have
+  been added without one.
+*/
+field_array_func_type *
+field_trans_table_lookup_array(field_trans_table_type *table,
+                               const char *_key) {
+    return field_trans_table_get_node(table, _key)->array_func;
 }
 
 /**
@@ -216,9 +241,7 @@ static float denormalize_poro(float x) {
 
 static float field_trans_pow10(float x) { return powf(10.0, x); }
 
-static float trunc_pow10f(float x) {
-    return util_float_max(powf(10.0, x), 0.001);
-}
+static float trunc_pow10f(float x) { return std::max(powf(10.0, x), 0.001f); }
 
 #define LN_SHIFT 0.0000001
 static float field_trans_ln0(float x) { return logf(x + LN_SHIFT); }
@@ -226,46 +249,60 @@ static float field_trans_ln0(float x) { return logf(x + LN_SHIFT); }
 static float field_trans_exp0(float x) { return expf(x) - LN_SHIFT; }
 #undef LN_SHIFT
 
+/**
+  The array version of @func. The function is known at compile time, so
+  the call is inlined into the loop, which the compiler can vectorize,
+  instead of going through a function pointer for every cell.
+*/
+template <field_func_type *func>
+static void field_trans_array(float *data, int size) {
+    for (int i = 0; i < size; i++)
+        data[i] = func(data[i]);
+}
+
+#define FIELD_TRANS_ADD(table, key, description, func)                         \
+    field_trans_table_add(table, key, description, func,                       \
+                          field_trans_array<func>)
+
 field_trans_table_type *field_trans_table_alloc() {
     field_trans_table_type *table =
         (field_trans_table_type *)util_malloc(sizeof *table);
     table->function_table = hash_alloc();
-    field_trans_table_add(
-        table, "POW10",
-        "This function will raise x to the power of 10: y = 10^x.",
-        field_trans_pow10);
-    field_trans_table_add(table, "TRUNC_POW10",
-                          "This function will raise x to the power of 10 - and "
-                          "truncate lower values at 0.001.",
-                          trunc_pow10f);
-    field_trans_table_add(
+    FIELD_TRANS_ADD(table, "POW10",
+                    "This function will raise x to the power of 10: y = 10^x.",
+                    field_trans_pow10);
+    FIELD_TRANS_ADD(table, "TRUNC_POW10",
+                    "This function will raise x to the power of 10 - and "
+                    "truncate lower values at 0.001.",
+                    trunc_pow10f);
+    FIELD_TRANS_ADD(
         table, "LOG",
         "This function will take the NATURAL logarithm of x: y = ln(x)", logf);
-    field_trans_table_add(
+    FIELD_TRANS_ADD(
         table, "LN",
         "This function will take the NATURAL logarithm of x: y = ln(x)", logf);
-    field_trans_table_add(
+    FIELD_TRANS_ADD(
         table, "LOG10",
         "This function will take the log10 logarithm of x: y = log10(x)",
         log10f);
-    field_trans_table_add(table, "EXP",
-                          "This function will calculate y = exp(x) ", expf);
-    field_trans_table_add(table, "LN0",
-                          "This function will calculate y = ln(x + 0.000001)",
-                          field_trans_ln0);
-    field_trans_table_add(table, "EXP0",
-                          "This function will calculate y = exp(x) - 0.000001",
-                          field_trans_exp0);
+    FIELD_TRANS_ADD(table, "EXP", "This function will calculate y = exp(x) ",
+                    expf);
+    FIELD_TRANS_ADD(table, "LN0",
+                    "This function will calculate y = ln(x + 0.000001)",
+                    field_trans_ln0);
+    FIELD_TRANS_ADD(table, "EXP0",
+                    "This function will calculate y = exp(x) - 0.000001",
+                    field_trans_exp0);
 
     // Rubakumar specials:
-    field_trans_table_add(table, "NORMALIZE_PERMX", "...", normalize_permx);
-    field_trans_table_add(table, "DENORMALIZE_PERMX", "...", denormalize_permx);
+    FIELD_TRANS_ADD(table, "NORMALIZE_PERMX", "...", normalize_permx);
+    FIELD_TRANS_ADD(table, "DENORMALIZE_PERMX", "...", denormalize_permx);
 
-    field_trans_table_add(table, "NORMALIZE_PERMZ", "...", normalize_permz);
-    field_trans_table_add(table, "DENORMALIZE_PERMZ", "...", denormalize_permz);
+    FIELD_TRANS_ADD(table, "NORMALIZE_PERMZ", "...", normalize_permz);
+    FIELD_TRANS_ADD(table, "DENORMALIZE_PERMZ", "...", denormalize_permz);
 
-    field_trans_table_add(table, "NORMALIZE_PORO", "...", normalize_poro);
-    field_trans_table_add(table, "DENORMALIZE_PORO", "...", denormalize_poro);
+    FIELD_TRANS_ADD(table, "NORMALIZE_PORO", "...", normalize_poro);
+    FIELD_TRANS_ADD(table, "DENORMALIZE_PORO", "...", denormalize_poro);
 
     table->case_sensitive = false;
     return table;
@@ -16,9 +16,19 @@
    for more details.
 */
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <string>
+#include <system_error>
 
+#include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <ert/util/util.h>
 
@@ -32,6 +42,133 @@
    by both the gen_data and gen_obs objects.
 */
 
+namespace {
+/**
+   Read only memory map of a complete file; an empty file is represented with
+   size == 0 and no mapping.
+*/
+class mapped_file {
+public:
+    explicit mapped_file(const char *file) {
+        int fd = open(file, O_RDONLY);
+        if (fd == -1)
+            util_abort("%s: failed to open:%s - %s \n", __func__, file,
+                       strerror(errno));
+
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+            util_abort("%s: failed to stat:%s - %s \n", __func__, file,
+                       strerror(errno));
+
+        m_size = st.st_size;
+        if (m_size > 0) {
+            void *addr = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED)
+                util_abort("%s: failed to mmap:%s - %s \n", __func__, file,
+                           strerror(errno));
+            madvise(addr, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char *>(addr);
+        }
+        close(fd);
+    }
+
+    ~mapped_file() {
+        if (m_data)
+            munmap(const_cast<char *>(m_data), m_size);
+    }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    const char *begin() const { return m_data; }
+    const char *end() const { return m_data + m_size; }
+
+private:
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+const char *skip_space(const char *pos, const char *end) {
+    while (pos < end && std::isspace(static_cast<unsigned char>(*pos)))
+        pos++;
+    return pos;
+}
+
+template <typename T> T parse_number(const char *str, char **end);
+
+template <> float parse_number<float>(const char *str, char **end) {
+    return strtof(str, end);
+}
+
+template <> double parse_number<double>(const char *str, char **end) {
+    return strtod(str, end);
+}
+
+template <> int parse_number<int>(const char *str, char **end) {
+    return static_cast<int>(strtol(str, end, 10));
+}
+
+/**
+   Parse the whitespace delimited token [@pos, @token_end) as one number. The
+   mapped file is not NUL terminated, so the token is copied before it is
+   handed to the strtod() family; these accept the same input as fscanf(),
+   including hex floats, and like fscanf() the range errors are ignored.
+   Returns false unless the complete token is a number.
+*/
+template <typename T>
+bool parse_value(const char *pos, const char *token_end, T &value) {
+    const size_t length = token_end - pos;
+    char local[64];
+    std::string long_token;
+    const char *token = local;
+    if (length < sizeof local) {
+        memcpy(local, pos, length);
+        local[length] = '\0';
+    } else {
+        long_token.assign(pos, length);
+        token = long_token.c_str();
+    }
+
+    char *parse_end;
+    value = parse_number<T>(token, &parse_end);
+    return parse_end == token + length;
+}
+
+template <typename T>
+void *parse_alloc(const char *file, const mapped_file &map, int *size) {
+    int buffer_elements = *size;
+    int current_size = 0;
+    if (buffer_elements <= 0)
+        buffer_elements = 100;
+
+    T *buffer = static_cast<T *>(util_calloc(buffer_elements, sizeof(T)));
+    const char *pos = skip_space(map.begin(), map.end());
+    while (pos < map.end()) {
+        if (current_size == buffer_elements) {
+            buffer_elements *= 2;
+            buffer = static_cast<T *>(
+                util_realloc(buffer, buffer_elements * sizeof(T)));
+        }
+
+        const char *token_end = pos;
+        while (token_end < map.end() &&
+               !std::isspace(static_cast<unsigned char>(*token_end)))
+            token_end++;
+
+        if (!parse_value(pos, token_end, buffer[current_size]))
+            util_abort("%s: scanning of %s terminated before EOF was reached "
+                       "-- fix your file.\n",
+                       __func__, file);
+
+        current_size++;
+        pos = skip_space(token_end, map.end());
+    }
+
+    *size = current_size;
+    return buffer;
+}
+} // namespace
+
 void *gen_common_fscanf_alloc(const char *file, ecl_data_type load_data_type,
                               int *size) {
     FILE *stream = util_fopen(file, "r");
@@ -80,6 +217,55 @@ void *gen_common_fscanf_alloc(const char *file, ecl_data_type load_data_type,
     return buffer;
 }
 
+/**
+   Equivalent to gen_common_fscanf_alloc(), but the file is memory mapped and
+   parsed with strtod() in one pass. The input value of @size is used as a
+   hint for the number of elements in the file, typically the size already
+   registered in the gen_data_config object.
+*/
+void *gen_common_fparse_alloc(const char *file, ecl_data_type load_data_type,
+                              int *size) {
+    mapped_file map(file);
+    if (ecl_type_is_float(load_data_type))
+        return parse_alloc<float>(file, map, size);
+    else if (ecl_type_is_double(load_data_type))
+        return parse_alloc<double>(file, map, size);
+    else if (ecl_type_is_int(load_data_type))
+        return parse_alloc<int>(file, map, size);
+
+    util_abort("%s: god dammit - internal error \n", __func__);
+    return NULL;
+}
+
+/**
+   Load an active mask, i.e. a file with 0 and 1 integers, into the @size
+   elements of @mask. Anything else than 0 and 1, or a file with fewer than
+   @size elements, is a fatal error; content beyond @size elements is ignored.
+*/
+void gen_common_fparse_active_mask(const char *file, int size, bool *mask) {
+    mapped_file map(file);
+    const char *pos = map.begin();
+    for (int index = 0; index < size; index++) {
+        pos = skip_space(pos, map.end());
+        int active_int;
+        auto result = std::from_chars(pos, map.end(), active_int);
+        if (pos == map.end() || result.ec != std::errc())
+            util_abort("%s: error when loading active mask from:%s - file not "
+                       "long enough.\n",
+                       __func__, file);
+
+        if (active_int == 1)
+            mask[index] = true;
+        else if (active_int == 0)
+            mask[index] = false;
+        else
+            util_abort("%s: error when loading active mask from:%s only 0 and "
+                       "1 allowed \n",
+                       __func__, file);
+        pos = result.ptr;
+    }
+}
+
 void *gen_common_fread_alloc(const char *file, ecl_data_type load_data_type,
                              int *size) {
     const int max_read_size = 100000;
@@ -119,7 +305,8 @@ void *gen_common_fread_alloc(const char *file, ecl_data_type load_data_type,
 
 /**
   If the load_format is binary_float or binary_double, the ASCII_type
-  is *NOT* consulted. The load_type is set to float/double depending
+  is *NOT* consulted. The input value of @size is a hint for the
+  number of elements in the file. The load_type is set to float/double depending
   on what was actually used when the data was loaded.
 */
 void *gen_common_fload_alloc(const char *file,
@@ -130,7 +317,7 @@ void *gen_common_fload_alloc(const char *file,
 
     if (load_format == ASCII) {
         *load_data_type = ecl_type_get_type(ASCII_data_type);
-        buffer = gen_common_fscanf_alloc(file, ASCII_data_type, size);
+        buffer = gen_common_fparse_alloc(file, ASCII_data_type, size);
     } else if (load_format == BINARY_FLOAT) {
         *load_data_type = ECL_FLOAT_TYPE;
         buffer = gen_common_fread_alloc(file, ECL_FLOAT, size);
@@ -16,6 +16,7 @@
    for more details.
 */
 
+#include <algorithm>
 #include <cmath>
 #include <filesystem>
 
@@ -36,6 +37,7 @@
 #include <ert/enkf/gen_common.hpp>
 #include <ert/enkf/gen_data.hpp>
 #include <ert/enkf/gen_data_config.hpp>
+#include <ert/enkf/node_codec.hpp>
 
 namespace fs = std::filesystem;
 static auto logger = ert::get_logger("enkf");
@@ -147,7 +149,11 @@ C_USED bool gen_data_write_to_buffer(const gen_data_type *gen_data,
                 buffer,
                 report_step); /* Why the heck do I need to store this ????  It was a mistake ...*/
 
-            buffer_fwrite_compressed(buffer, gen_data->data, byte_size);
+            node_codec_fwrite(
+                buffer, node_codec_get(GEN_DATA), gen_data->data,
+                ecl_type_get_sizeof_ctype(
+                    gen_data_config_get_internal_data_type(gen_data->config)),
+                byte_size);
             return true;
         } else
             return false; /* When false is returned - the (empty) file will be removed */
@@ -163,14 +169,11 @@ C_USED void gen_data_read_from_buffer(gen_data_type *gen_data,
     buffer_fskip_int(
         buffer); /* Skipping report_step from the buffer - was a mistake to store it - I think ... */
     {
-        size_t byte_size =
-            size *
-            ecl_type_get_sizeof_ctype(
-                gen_data_config_get_internal_data_type(gen_data->config));
-        size_t compressed_size = buffer_get_remaining_size(buffer);
+        size_t element_size = ecl_type_get_sizeof_ctype(
+            gen_data_config_get_internal_data_type(gen_data->config));
+        size_t byte_size = size * element_size;
         gen_data->data = (char *)util_realloc(gen_data->data, byte_size);
-        buffer_fread_compressed(buffer, compressed_size, gen_data->data,
-                                byte_size);
+        node_codec_fread(buffer, gen_data->data, element_size, byte_size);
     }
     gen_data_assert_size(gen_data, size, report_step);
 
@@ -263,26 +266,8 @@ static bool gen_data_fload_active__(gen_data_type *gen_data,
             char *active_file = util_alloc_sprintf("%s_active", filename);
             if (fs::exists(active_file)) {
                 file_exists = true;
-                FILE *stream = util_fopen(active_file, "r");
-                int active_int;
-                for (int index = 0; index < size; index++) {
-                    if (fscanf(stream, "%d", &active_int) == 1) {
-                        if (active_int == 1)
-                            bool_vector_iset(gen_data->active_mask, index,
-                                             true);
-                        else if (active_int == 0)
-                            bool_vector_iset(gen_data->active_mask, index,
-                                             false);
-                        else
-                            util_abort("%s: error when loading active mask "
-                                       "from:%s only 0 and 1 allowed \n",
-                                       __func__, active_file);
-                    } else
-                        util_abort("%s: error when loading active mask from:%s "
-                                   "- file not long enough.\n",
-                                   __func__, active_file);
-                }
-                fclose(stream);
+                bool *mask = bool_vector_get_ptr(gen_data->active_mask);
+                gen_common_fparse_active_mask(active_file, size, mask);
                 logger->info("GEN_DATA({}): active information loaded from:{}.",
                              gen_data_get_key(gen_data), active_file);
             } else
@@ -321,7 +306,11 @@ bool gen_data_fload_with_report_step(
             gen_data_config_get_internal_data_type(gen_data->config);
         gen_data_file_format_type input_format =
             gen_data_config_get_input_format(gen_data->config);
-        int size = 0;
+        int report_step = forward_load_context_get_load_step(load_context);
+        // The size registered by other realisations is used as a hint for
+        // the buffer; the actual size is validated in gen_data_set_data__().
+        int size = std::max(0, gen_data_config_get_data_size__(
+                                   gen_data->config, report_step));
         buffer = gen_common_fload_alloc(filename, input_format, internal_type,
                                         &load_type, &size);
         logger->info("GEN_DATA({}): loading from: {}   size:{}",
@@ -211,6 +211,18 @@ double gen_kw_config_transform(const gen_kw_config_type *config, int index,
     return trans_func_eval(parameter->trans_func, x);
 }
 
+/**
+   Transforms @n values of the parameter @index, typically the values of
+   one parameter in all the realizations of an ensemble.
+*/
+void gen_kw_config_transform_many(const gen_kw_config_type *config, int index,
+                                  const double *x, double *y, size_t n) {
+    const gen_kw_parameter_type *parameter =
+        (const gen_kw_parameter_type *)vector_iget_const(config->parameters,
+                                                         index);
+    trans_func_eval_many(parameter->trans_func, x, y, n);
+}
+
 bool gen_kw_config_should_use_log_scale(const gen_kw_config_type *config,
                                         int index) {
     const gen_kw_parameter_type *parameter =
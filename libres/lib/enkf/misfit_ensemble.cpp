@@ -16,13 +16,18 @@
    for more details.
 */
 
+#include <algorithm>
+#include <memory>
 #include <stdio.h>
 #include <stdlib.h>
+#include <thread>
+#include <vector>
 
 #include <ert/util/hash.h>
 #include <ert/util/util.h>
 #include <ert/util/vector.h>
 
+#include <ert/concurrency.hpp>
 #include <ert/enkf/enkf_obs.hpp>
 #include <ert/enkf/misfit_ensemble.hpp>
 
@@ -38,19 +43,14 @@ struct misfit_ensemble_struct {
     vector_type *ensemble;
 };
 
-static double **__2d_malloc(int rows, int columns) {
-    double **d = (double **)util_calloc(rows, sizeof *d);
-    for (int i = 0; i < rows; i++)
-        d[i] = (double *)util_calloc(columns, sizeof *d[i]);
-    return d;
-}
-
-static void __2d_free(double **d, int rows) {
-    for (int i = 0; i < rows; i++)
-        free(d[i]);
-    free(d);
-}
-
+/**
+   The chi2 values of all the observations are computed in parallel, both
+   over the observation keys and over blocks of realizations. Everything
+   goes into one contiguous table where observation obs_index has
+   (history_length + 1) * ens_size values, laid out as [step][iens]. The
+   table is internalized into the misfit members afterwards, in the
+   iteration order of the observations.
+*/
 void misfit_ensemble_initialize(misfit_ensemble_type *misfit_ensemble,
                                 const ensemble_config_type *ensemble_config,
                                 const enkf_obs_type *enkf_obs, enkf_fs_type *fs,
@@ -60,42 +60,54 @@ void misfit_ensemble_initialize(misfit_ensemble_type *misfit_ensemble,
     if (force_init || !misfit_ensemble->initialized) {
         misfit_ensemble_clear(misfit_ensemble);
 
-        double **chi2_work = __2d_malloc(history_length + 1, ens_size);
-        bool_vector_type *iens_valid = bool_vector_alloc(ens_size, true);
-
+        std::vector<const char *> obs_keys;
         hash_iter_type *obs_iter = enkf_obs_alloc_iter(enkf_obs);
-        const char *obs_key = hash_iter_get_next_key(obs_iter);
+        for (const char *obs_key = hash_iter_get_next_key(obs_iter);
+             obs_key != NULL; obs_key = hash_iter_get_next_key(obs_iter))
+            obs_keys.push_back(obs_key);
 
         misfit_ensemble->history_length = history_length;
         misfit_ensemble_set_ens_size(misfit_ensemble, ens_size);
 
-        while (obs_key != NULL) {
-            obs_vector_type *obs_vector =
-                enkf_obs_get_vector(enkf_obs, obs_key);
-
-            bool_vector_reset(iens_valid);
-            bool_vector_iset(iens_valid, ens_size - 1, true);
-            obs_vector_ensemble_chi2(obs_vector, fs, iens_valid, 0,
-                                     misfit_ensemble->history_length, 0,
-                                     ens_size, chi2_work);
-
-            // Internalizing the results from the chi2_work table into the
-            // misfit structure.
+        const int obs_count = obs_keys.size();
+        const size_t obs_size = size_t(history_length + 1) * ens_size;
+        std::vector<double> chi2_work(obs_count * obs_size);
+        std::unique_ptr<bool[]> iens_valid(new bool[obs_count * ens_size]);
+        std::fill_n(iens_valid.get(), obs_count * ens_size, true);
+
+        // Every block allocates its own node, so the blocks should not be
+        // much smaller than what is needed to keep all the threads busy.
+        const int block_count = std::clamp<int>(
+            std::thread::hardware_concurrency(), 1, std::max(ens_size, 1));
+        ert::parallel_for(obs_count * block_count, [&](int task) {
+            int obs_index = task / block_count;
+            int block = task % block_count;
+            int iens1 = block * ens_size / block_count;
+            int iens2 = (block + 1) * ens_size / block_count;
+            if (iens1 == iens2)
+                return;
+
+            obs_vector_ensemble_chi2(
+                enkf_obs_get_vector(enkf_obs, obs_keys[obs_index]), fs, 0,
+                history_length, iens1, iens2, ens_size,
+                chi2_work.data() + obs_index * obs_size,
+                iens_valid.get() + obs_index * ens_size);
+        });
+
+        // Internalizing the results from the chi2_work table into the
+        // misfit structure.
+        for (int obs_index = 0; obs_index < obs_count; obs_index++) {
             for (int iens = 0; iens < ens_size; iens++) {
                 misfit_member_type *node =
                     misfit_ensemble_iget_member(misfit_ensemble, iens);
-                if (bool_vector_iget(iens_valid, iens))
-                    misfit_member_update(node, obs_key,
-                                         misfit_ensemble->history_length, iens,
-                                         (const double **)chi2_work);
+                if (iens_valid[obs_index * ens_size + iens])
+                    misfit_member_update(
+                        node, obs_keys[obs_index], history_length, iens,
+                        ens_size, chi2_work.data() + obs_index * obs_size);
             }
-            obs_key = hash_iter_get_next_key(obs_iter);
         }
 
-        bool_vector_free(iens_valid);
         hash_iter_free(obs_iter);
-
-        __2d_free(chi2_work, misfit_ensemble->history_length + 1);
         misfit_ensemble->initialized = true;
     }
 }
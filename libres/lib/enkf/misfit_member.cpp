@@ -78,13 +78,17 @@ bool misfit_member_has_ts(const misfit_member_type *node, const char *obs_key) {
     return hash_has_key(node->obs, obs_key);
 }
 
+/**
+   Copy the chi2 values of realization @iens from @work_chi2, which holds
+   @ens_size values for each of the report steps [0, history_length].
+*/
 void misfit_member_update(misfit_member_type *node, const char *obs_key,
-                          int history_length, int iens,
-                          const double **work_chi2) {
+                          int history_length, int iens, int ens_size,
+                          const double *work_chi2) {
     misfit_ts_type *vector =
         misfit_member_safe_get_vector(node, obs_key, history_length);
     for (int step = 0; step <= history_length; step++)
-        misfit_ts_iset(vector, step, work_chi2[step][iens]);
+        misfit_ts_iset(vector, step, work_chi2[step * ens_size + iens]);
 }
 
 void misfit_member_fwrite(const misfit_member_type *node, FILE *stream) {
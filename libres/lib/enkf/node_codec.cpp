@@ -0,0 +1,397 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include <ert/util/util.h>
+
+#include <ert/logging.hpp>
+
+#include <ert/enkf/node_codec.hpp>
+
+static auto logger = ert::get_logger("enkf");
+
+namespace {
+/**
+   The first int of a payload with a codec header. A zlib stream, which is
+   what was stored before the codecs were introduced, always starts with
+   the byte 0x78, so the two can not be confused.
+*/
+constexpr int node_codec_magic = 0x43444345;
+
+constexpr int lz_min_match = 4;
+constexpr int lz_hash_bits = 16;
+constexpr size_t lz_max_offset = 65535;
+
+std::once_flag codec_env_flag;
+std::mutex codec_mutex;
+std::map<ert_impl_type, node_codec_spec> codecs;
+
+ert_impl_type codec_impl_type(const std::string &name) {
+    if (name == "FIELD")
+        return FIELD;
+    if (name == "GEN_DATA")
+        return GEN_DATA;
+    return INVALID;
+}
+
+/** Apply ERT_STORAGE_CODEC=TYPE=CODEC,TYPE=CODEC,... */
+void codec_load_env() {
+    const char *env = getenv("ERT_STORAGE_CODEC");
+    if (!env)
+        return;
+
+    std::string value = env;
+    size_t begin = 0;
+    while (begin < value.size()) {
+        size_t end = value.find(',', begin);
+        if (end == std::string::npos)
+            end = value.size();
+
+        std::string item = value.substr(begin, end - begin);
+        size_t split = item.find('=');
+        ert_impl_type impl_type = codec_impl_type(item.substr(0, split));
+        if (split == std::string::npos || impl_type == INVALID)
+            logger->warning("Ignoring {} in ERT_STORAGE_CODEC", item);
+        else {
+            try {
+                codecs[impl_type] = node_codec_parse(item.substr(split + 1));
+            } catch (const std::invalid_argument &err) {
+                logger->warning("Ignoring {} in ERT_STORAGE_CODEC: {}", item,
+                                err.what());
+            }
+        }
+        begin = end + 1;
+    }
+}
+
+uint32_t lz_read32(const uint8_t *ptr) {
+    uint32_t value;
+    memcpy(&value, ptr, sizeof value);
+    return value;
+}
+
+void lz_write_length(std::vector<char> &out, size_t length) {
+    while (length >= 255) {
+        out.push_back(char(255));
+        length -= 255;
+    }
+    out.push_back(char(length));
+}
+
+/**
+   Append one sequence of @literal_size literal bytes, followed by a match
+   of @match_size bytes at @offset bytes back. The final sequence of a
+   stream has only literals.
+*/
+void lz_write_sequence(std::vector<char> &out, const uint8_t *literals,
+                       size_t literal_size, size_t offset, size_t match_size) {
+    size_t match_code = match_size ? match_size - lz_min_match : 0;
+    uint8_t token = (std::min<size_t>(literal_size, 15) << 4) |
+                    std::min<size_t>(match_code, 15);
+    out.push_back(char(token));
+    if (literal_size >= 15)
+        lz_write_length(out, literal_size - 15);
+    out.insert(out.end(), literals, literals + literal_size);
+
+    if (match_size) {
+        out.push_back(char(offset & 0xFF));
+        out.push_back(char(offset >> 8));
+        if (match_code >= 15)
+            lz_write_length(out, match_code - 15);
+    }
+}
+
+bool lz_read_length(const uint8_t *&ip, const uint8_t *iend, size_t &length) {
+    uint8_t byte;
+    do {
+        if (ip == iend)
+            return false;
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+} // namespace
+
+node_codec_spec node_codec_parse(const std::string &name) {
+    node_codec_spec spec;
+    std::string codec = name;
+    const std::string shuffle_suffix = "+shuffle";
+    if (codec.size() > shuffle_suffix.size() &&
+        codec.compare(codec.size() - shuffle_suffix.size(),
+                      shuffle_suffix.size(), shuffle_suffix) == 0) {
+        spec.shuffle = true;
+        codec.resize(codec.size() - shuffle_suffix.size());
+    }
+
+    if (codec == "zlib")
+        spec.codec = node_codec_type::zlib;
+    else if (codec == "none")
+        spec.codec = node_codec_type::none;
+    else if (codec == "lz")
+        spec.codec = node_codec_type::lz;
+    else
+        throw std::invalid_argument("Unknown storage codec: " + name);
+    return spec;
+}
+
+std::string node_codec_name(node_codec_spec spec) {
+    std::string name;
+    switch (spec.codec) {
+    case node_codec_type::zlib:
+        name = "zlib";
+        break;
+    case node_codec_type::none:
+        name = "none";
+        break;
+    case node_codec_type::lz:
+        name = "lz";
+        break;
+    }
+    if (spec.shuffle)
+        name += "+shuffle";
+    return name;
+}
+
+node_codec_spec node_codec_get(ert_impl_type impl_type) {
+    std::call_once(codec_env_flag, codec_load_env);
+    std::lock_guard<std::mutex> lock(codec_mutex);
+    auto iter = codecs.find(impl_type);
+    if (iter == codecs.end())
+        return {};
+    return iter->second;
+}
+
+void node_codec_set(ert_impl_type impl_type, node_codec_spec spec) {
+    std::call_once(codec_env_flag, codec_load_env);
+    std::lock_guard<std::mutex> lock(codec_mutex);
+    codecs[impl_type] = spec;
+}
+
+void node_codec_shuffle(const void *src, void *target, size_t element_size,
+                        size_t byte_size) {
+    const char *src_bytes = static_cast<const char *>(src);
+    char *target_bytes = static_cast<char *>(target);
+    size_t count = byte_size / element_size;
+    for (size_t byte = 0; byte < element_size; byte++)
+        for (size_t index = 0; index < count; index++)
+            target_bytes[byte * count + index] =
+                src_bytes[index * element_size + byte];
+
+    size_t shuffled_size = count * element_size;
+    if (byte_size > shuffled_size)
+        memcpy(target_bytes + shuffled_size, src_bytes + shuffled_size,
+               byte_size - shuffled_size);
+}
+
+void node_codec_unshuffle(const void *src, void *target, size_t element_size,
+                          size_t byte_size) {
+    const char *src_bytes = static_cast<const char *>(src);
+    char *target_bytes = static_cast<char *>(target);
+    size_t count = byte_size / element_size;
+    for (size_t byte = 0; byte < element_size; byte++)
+        for (size_t index = 0; index < count; index++)
+            target_bytes[index * element_size + byte] =
+                src_bytes[byte * count + index];
+
+    size_t shuffled_size = count * element_size;
+    if (byte_size > shuffled_size)
+        memcpy(target_bytes + shuffled_size, src_bytes + shuffled_size,
+               byte_size - shuffled_size);
+}
+
+/**
+   Greedy LZ77 compression with a single entry hash table of the positions
+   of four byte sequences. The output is a list of sequences, each a token
+   byte with the literal length in the high nibble and the match length
+   minus four in the low nibble, the literals, a two byte offset and the
+   remainder of lengths which do not fit in a nibble, as in LZ4.
+*/
+std::vector<char> node_codec_lz_compress(const void *data, size_t byte_size) {
+    const uint8_t *in = static_cast<const uint8_t *>(data);
+    std::vector<char> out;
+    out.reserve(byte_size + byte_size / 255 + 16);
+
+    // Small payloads, like most GEN_DATA, get a smaller hash table.
+    int hash_bits = 8;
+    while (hash_bits < lz_hash_bits && (size_t(1) << hash_bits) < byte_size)
+        hash_bits++;
+    std::vector<size_t> table(size_t(1) << hash_bits, 0);
+    size_t pos = 0;
+    size_t anchor = 0;
+    while (pos + lz_min_match <= byte_size) {
+        uint32_t sequence = lz_read32(in + pos);
+        uint32_t hash = (sequence * 2654435761U) >> (32 - hash_bits);
+        size_t candidate = table[hash];
+        table[hash] = pos + 1;
+
+        if (candidate > 0 && pos - (candidate - 1) <= lz_max_offset &&
+            lz_read32(in + candidate - 1) == sequence) {
+            size_t match = candidate - 1;
+            size_t match_size = lz_min_match;
+            while (pos + match_size < byte_size &&
+                   in[match + match_size] == in[pos + match_size])
+                match_size++;
+
+            lz_write_sequence(out, in + anchor, pos - anchor, pos - match,
+                              match_size);
+            pos += match_size;
+            anchor = pos;
+        } else
+            // Step faster through data which do not compress.
+            pos += 1 + ((pos - anchor) >> 6);
+    }
+
+    if (anchor < byte_size || out.empty())
+        lz_write_sequence(out, in + anchor, byte_size - anchor, 0, 0);
+    return out;
+}
+
+/**
+   Decompress the output of node_codec_lz_compress() into exactly @byte_size
+   bytes at @target. Returns false if the input is corrupt.
+*/
+bool node_codec_lz_decompress(const void *src, size_t src_size, void *target,
+                              size_t byte_size) {
+    const uint8_t *ip = static_cast<const uint8_t *>(src);
+    const uint8_t *iend = ip + src_size;
+    uint8_t *out = static_cast<uint8_t *>(target);
+    uint8_t *op = out;
+    uint8_t *oend = out + byte_size;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+        size_t literal_size = token >> 4;
+        if (literal_size == 15 && !lz_read_length(ip, iend, literal_size))
+            return false;
+        if (literal_size > size_t(iend - ip) ||
+            literal_size > size_t(oend - op))
+            return false;
+        if (literal_size > 0)
+            memcpy(op, ip, literal_size);
+        ip += literal_size;
+        op += literal_size;
+
+        if (ip == iend)
+            break;
+
+        if (iend - ip < 2)
+            return false;
+        size_t offset = ip[0] | (size_t(ip[1]) << 8);
+        ip += 2;
+        size_t match_size = token & 15;
+        if (match_size == 15 && !lz_read_length(ip, iend, match_size))
+            return false;
+        match_size += lz_min_match;
+        if (offset == 0 || offset > size_t(op - out) ||
+            match_size > size_t(oend - op))
+            return false;
+
+        // The match can overlap the output, so copy byte by byte.
+        const uint8_t *match = op - offset;
+        for (size_t index = 0; index < match_size; index++)
+            op[index] = match[index];
+        op += match_size;
+    }
+    return op == oend;
+}
+
+/**
+   Write @byte_size bytes of @data, an array of elements of @element_size
+   bytes, to @buffer with the codec @spec. Plain zlib is written without a
+   header, exactly as before the codecs were introduced.
+*/
+void node_codec_fwrite(buffer_type *buffer, node_codec_spec spec,
+                       const void *data, size_t element_size,
+                       size_t byte_size) {
+    if (spec.codec == node_codec_type::zlib && !spec.shuffle) {
+        buffer_fwrite_compressed(buffer, data, byte_size);
+        return;
+    }
+
+    buffer_fwrite_int(buffer, node_codec_magic);
+    buffer_fwrite_int(buffer, static_cast<int>(spec.codec));
+    buffer_fwrite_int(buffer, spec.shuffle ? element_size : 0);
+
+    std::vector<char> shuffled;
+    if (spec.shuffle) {
+        shuffled.resize(byte_size);
+        node_codec_shuffle(data, shuffled.data(), element_size, byte_size);
+        data = shuffled.data();
+    }
+
+    switch (spec.codec) {
+    case node_codec_type::zlib:
+        buffer_fwrite_compressed(buffer, data, byte_size);
+        break;
+    case node_codec_type::none:
+        buffer_fwrite(buffer, data, 1, byte_size);
+        break;
+    case node_codec_type::lz: {
+        std::vector<char> compressed = node_codec_lz_compress(data, byte_size);
+        buffer_fwrite(buffer, compressed.data(), 1, compressed.size());
+        break;
+    }
+    }
+}
+
+/**
+   Read @byte_size bytes written by node_codec_fwrite() into @data; the
+   payload is assumed to extend to the end of @buffer.
+*/
+void node_codec_fread(buffer_type *buffer, void *data, size_t element_size,
+                      size_t byte_size) {
+    size_t remaining_size = buffer_get_remaining_size(buffer);
+    const char *payload = static_cast<const char *>(buffer_get_data(buffer)) +
+                          buffer_get_offset(buffer);
+    int magic = 0;
+    if (remaining_size >= sizeof magic)
+        memcpy(&magic, payload, sizeof magic);
+
+    if (magic != node_codec_magic) {
+        buffer_fread_compressed(buffer, remaining_size, data, byte_size);
+        return;
+    }
+
+    buffer_fskip_int(buffer);
+    auto codec = static_cast<node_codec_type>(buffer_fread_int(buffer));
+    size_t shuffle_size = buffer_fread_int(buffer);
+    remaining_size = buffer_get_remaining_size(buffer);
+    payload = static_cast<const char *>(buffer_get_data(buffer)) +
+              buffer_get_offset(buffer);
+
+    std::vector<char> shuffled;
+    void *target = data;
+    if (shuffle_size > 0) {
+        shuffled.resize(byte_size);
+        target = shuffled.data();
+    }
+
+    switch (codec) {
+    case node_codec_type::zlib:
+        buffer_fread_compressed(buffer, remaining_size, target, byte_size);
+        break;
+    case node_codec_type::none:
+        if (remaining_size < byte_size)
+            util_abort("%s: stored data too short: %zu < %zu bytes\n", __func__,
+                       remaining_size, byte_size);
+        buffer_fread(buffer, target, 1, byte_size);
+        break;
+    case node_codec_type::lz:
+        if (!node_codec_lz_decompress(payload, remaining_size, target,
+                                      byte_size))
+            util_abort("%s: corrupt lz compressed data\n", __func__);
+        buffer_fskip(buffer, remaining_size);
+        break;
+    default:
+        util_abort("%s: unknown storage codec: %d\n", __func__,
+                   static_cast<int>(codec));
+    }
+
+    if (shuffle_size > 0)
+        node_codec_unshuffle(shuffled.data(), data, shuffle_size, byte_size);
+}
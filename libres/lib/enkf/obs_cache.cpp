@@ -0,0 +1,190 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ert/enkf/obs_cache.hpp>
+#include <ert/logging.hpp>
+
+namespace fs = std::filesystem;
+static auto logger = ert::get_logger("enkf");
+
+namespace {
+const char cache_magic[8] = {'E', 'R', 'T', 'H', 'O', 'B', 'S', '1'};
+
+template <typename T> void write_value(std::ofstream &stream, const T &value) {
+    stream.write(reinterpret_cast<const char *>(&value), sizeof value);
+}
+
+template <typename T>
+void write_vector(std::ofstream &stream, const std::vector<T> &values) {
+    stream.write(reinterpret_cast<const char *>(values.data()),
+                 values.size() * sizeof(T));
+}
+
+template <typename T> bool read_value(std::ifstream &stream, T &value) {
+    return bool(stream.read(reinterpret_cast<char *>(&value), sizeof value));
+}
+
+template <typename T>
+bool read_vector(std::ifstream &stream, std::vector<T> &values,
+                 std::uint32_t size) {
+    values.resize(size);
+    return bool(stream.read(reinterpret_cast<char *>(values.data()),
+                            size * sizeof(T)));
+}
+} // namespace
+
+/**
+   FNV-1a hash of @size bytes, continuing from @hash. Start a new hash
+   with obs_cache_hash_bytes(NULL, 0, 0).
+*/
+std::uint64_t obs_cache_hash_bytes(const void *data, std::size_t size,
+                                   std::uint64_t hash) {
+    if (hash == 0)
+        hash = 14695981039346656037ULL;
+
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+   Continue @hash with the content of @file. Returns false if the file could
+   not be read.
+*/
+bool obs_cache_hash_file(const char *file, std::uint64_t &hash) {
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream)
+        return false;
+
+    char buffer[1 << 16];
+    while (stream) {
+        stream.read(buffer, sizeof buffer);
+        hash = obs_cache_hash_bytes(buffer, stream.gcount(), hash);
+    }
+    return stream.eof();
+}
+
+/**
+   Load the entries from @file. Returns false - and leaves the cache empty -
+   if the file does not exist, is corrupt or was stored with another key.
+*/
+bool HistoryObsCache::load(const std::string &file) {
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream)
+        return false;
+
+    char magic[sizeof cache_magic];
+    std::uint64_t key;
+    std::uint32_t num_entries;
+    if (!stream.read(magic, sizeof magic) ||
+        memcmp(magic, cache_magic, sizeof magic) != 0 ||
+        !read_value(stream, key) || key != m_key ||
+        !read_value(stream, num_entries))
+        return false;
+
+    for (std::uint32_t i = 0; i < num_entries; i++) {
+        std::uint32_t key_size, size;
+        std::uint8_t valid;
+        std::string obs_key;
+        history_obs_cache_entry entry;
+        if (!read_value(stream, key_size))
+            break;
+
+        obs_key.resize(key_size);
+        if (!stream.read(obs_key.data(), key_size) ||
+            !read_value(stream, valid) || !read_value(stream, size) ||
+            !read_vector(stream, entry.step, size) ||
+            !read_vector(stream, entry.value, size) ||
+            !read_vector(stream, entry.stddev, size))
+            break;
+
+        entry.valid = valid;
+        m_entries[obs_key] = std::move(entry);
+    }
+
+    if (m_entries.size() != num_entries) {
+        logger->warning("Ignoring corrupt observation cache: {}", file);
+        m_entries.clear();
+        return false;
+    }
+    return true;
+}
+
+/**
+   Store the entries in @file, creating its directory if needed. The file is
+   written to a uniquely named temporary file which is renamed in place, so
+   concurrent readers never see a partial file, and concurrent writers never
+   write to the same temporary file.
+*/
+bool HistoryObsCache::save(const std::string &file) const {
+    std::error_code ec;
+    fs::path parent_path = fs::path(file).parent_path();
+    if (!parent_path.empty())
+        fs::create_directories(parent_path, ec);
+
+    std::string tmp_file = file + ".XXXXXX";
+    int fd = mkstemp(tmp_file.data());
+    if (fd < 0) {
+        logger->warning("Could not write observation cache: {}", file);
+        return false;
+    }
+    fchmod(fd, 0644);
+    close(fd);
+
+    {
+        std::ofstream stream(tmp_file, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            logger->warning("Could not write observation cache: {}", file);
+            fs::remove(tmp_file, ec);
+            return false;
+        }
+
+        stream.write(cache_magic, sizeof cache_magic);
+        write_value(stream, m_key);
+        write_value(stream, static_cast<std::uint32_t>(m_entries.size()));
+        for (const auto &[obs_key, entry] : m_entries) {
+            write_value(stream, static_cast<std::uint32_t>(obs_key.size()));
+            stream.write(obs_key.data(), obs_key.size());
+            write_value(stream, static_cast<std::uint8_t>(entry.valid));
+            write_value(stream, static_cast<std::uint32_t>(entry.step.size()));
+            write_vector(stream, entry.step);
+            write_vector(stream, entry.value);
+            write_vector(stream, entry.stddev);
+        }
+        if (!stream) {
+            logger->warning("Could not write observation cache: {}", file);
+            stream.close();
+            fs::remove(tmp_file, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tmp_file, file, ec);
+    if (ec) {
+        logger->warning("Could not write observation cache: {}", file);
+        fs::remove(tmp_file, ec);
+        return false;
+    }
+    return true;
+}
+
+const history_obs_cache_entry *
+HistoryObsCache::get(const std::string &obs_key) const {
+    auto iter = m_entries.find(obs_key);
+    if (iter == m_entries.end())
+        return nullptr;
+    return &iter->second;
+}
+
+void HistoryObsCache::set(const std::string &obs_key,
+                          history_obs_cache_entry entry) {
+    m_entries[obs_key] = std::move(entry);
+}
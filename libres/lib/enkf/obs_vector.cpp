@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <mutex>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -61,7 +62,13 @@ struct obs_vector_struct {
     obs_chi2_ftype *chi2;
     /** Function to scale the standard deviation with a given factor */
     obs_update_std_scale_ftype *update_std_scale;
+    /** For SUMMARY_OBS the nodes are views into summary_obs, which are only
+     * allocated when requested with obs_vector_iget_node(). */
     vector_type *nodes;
+    /** Guards @nodes, as obs_vector_iget_node() can allocate a view. */
+    mutable std::mutex nodes_mutex;
+    /** The observations of a SUMMARY_OBS vector, NULL for other types. */
+    SummaryObsStore *summary_obs;
     /** The key this observation vector has in the enkf_obs layer. */
     char *obs_key;
     /** The config_node of the node type we are observing - shared reference */
@@ -205,6 +212,7 @@ obs_vector_type *obs_vector_alloc(obs_impl_type obs_type, const char *obs_key,
     vector->obs_key = util_alloc_string_copy(obs_key);
     vector->num_active = 0;
     vector->nodes = vector_alloc_new();
+    vector->summary_obs = NULL;
     obs_vector_resize(
         vector, num_reports + 1); /* +1 here ?? Ohh  - these +/- problems. */
 
@@ -235,6 +243,7 @@ obs_vector_get_config_node(const obs_vector_type *obs_vector) {
 
 void obs_vector_free(obs_vector_type *obs_vector) {
     vector_free(obs_vector->nodes);
+    delete obs_vector->summary_obs;
     free(obs_vector->obs_key);
     delete obs_vector;
 }
@@ -262,20 +271,41 @@ static void obs_vector_assert_node_type(const obs_vector_type *obs_vector,
                    __func__);
 }
 
+static void obs_vector_activate_step(obs_vector_type *obs_vector,
+                                     int index) {
+    obs_vector_resize(obs_vector, index + 1);
+    if (!obs_vector_iget_active(obs_vector, index)) {
+        obs_vector->num_active++;
+        auto &step_list = obs_vector->step_list;
+        step_list.insert(
+            std::upper_bound(step_list.begin(), step_list.end(), index),
+            index);
+    }
+}
+
+static SummaryObsStore *
+obs_vector_get_summary_store(obs_vector_type *obs_vector,
+                             const char *summary_key, const char *obs_key) {
+    if (!obs_vector->summary_obs)
+        obs_vector->summary_obs = new SummaryObsStore(summary_key, obs_key);
+    return obs_vector->summary_obs;
+}
+
 void obs_vector_install_node(obs_vector_type *obs_vector, int index,
                              void *node) {
     obs_vector_assert_node_type(obs_vector, node);
-    {
-        if (vector_iget_const(obs_vector->nodes, index) == NULL) {
-            obs_vector->num_active++;
-            obs_vector->step_list.push_back(index);
-            std::sort(obs_vector->step_list.begin(),
-                      obs_vector->step_list.end());
-        }
-
-        vector_iset_owned_ref(obs_vector->nodes, index, node,
-                              obs_vector->freef);
+    std::lock_guard guard{obs_vector->nodes_mutex};
+    obs_vector_activate_step(obs_vector, index);
+
+    if (obs_vector->obs_type == SUMMARY_OBS) {
+        auto summary_obs = static_cast<summary_obs_type *>(node);
+        SummaryObsStore *store = obs_vector_get_summary_store(
+            obs_vector, summary_obs_get_summary_key(summary_obs),
+            obs_vector->obs_key);
+        summary_obs_attach(summary_obs, store, index);
     }
+
+    vector_iset_owned_ref(obs_vector->nodes, index, node, obs_vector->freef);
 }
 
 /**
@@ -283,13 +313,19 @@ void obs_vector_install_node(obs_vector_type *obs_vector, int index,
    corresponding simulated value in the ensemble, and not the
    observation key - the two can be different.
 */
-static void obs_vector_add_summary_obs(obs_vector_type *obs_vector,
-                                       int obs_index, const char *summary_key,
-                                       const char *obs_key, double value,
-                                       double std) {
-    summary_obs_type *summary_obs =
-        summary_obs_alloc(summary_key, obs_key, value, std);
-    obs_vector_install_node(obs_vector, obs_index, summary_obs);
+void obs_vector_add_summary_obs(obs_vector_type *obs_vector, int obs_index,
+                                const char *summary_key, const char *obs_key,
+                                double value, double std) {
+    obs_vector_activate_step(obs_vector, obs_index);
+    SummaryObsStore *store =
+        obs_vector_get_summary_store(obs_vector, summary_key, obs_key);
+    store->add(obs_index, value, std);
+    store->set_key(obs_index, obs_key);
+}
+
+const SummaryObsStore *
+obs_vector_get_summary_obs(const obs_vector_type *obs_vector) {
+    return obs_vector->summary_obs;
 }
 
 int obs_vector_get_num_active(const obs_vector_type *vector) {
@@ -303,23 +339,25 @@ obs_vector_get_step_list(const obs_vector_type *vector) {
 
 bool obs_vector_iget_active(const obs_vector_type *vector, int index) {
     /* We accept this ... */
-    if (index >= vector_get_size(vector->nodes))
+    if (index < 0 || index >= vector_get_size(vector->nodes))
         return false;
 
-    {
-        void *obs_data = (void *)vector_iget(vector->nodes, index);
-        if (obs_data != NULL)
-            return true;
-        else
-            return false;
-    }
+    return std::binary_search(vector->step_list.begin(),
+                              vector->step_list.end(), index);
 }
 
 /**
    Will happily return NULL if index is not active.
 */
 void *obs_vector_iget_node(const obs_vector_type *vector, int index) {
-    return vector_iget(vector->nodes, index); // CXX_CAST_ERROR
+    std::lock_guard guard{vector->nodes_mutex};
+    void *node = vector_iget(vector->nodes, index); // CXX_CAST_ERROR
+    if (node == NULL && vector->summary_obs &&
+        vector->summary_obs->find(index) >= 0) {
+        node = summary_obs_alloc_view(vector->summary_obs, index);
+        vector_iset_owned_ref(vector->nodes, index, node, vector->freef);
+    }
+    return node;
 }
 
 void obs_vector_user_get(const obs_vector_type *obs_vector,
@@ -336,20 +374,12 @@ void obs_vector_user_get(const obs_vector_type *obs_vector,
 */
 int obs_vector_get_next_active_step(const obs_vector_type *obs_vector,
                                     int prev_step) {
-    if (prev_step >= (vector_get_size(obs_vector->nodes) - 1))
-        return -1;
-    else {
-        int size = vector_get_size(obs_vector->nodes);
-        int next_step = prev_step + 1;
-        while ((next_step < size) &&
-               (obs_vector_iget_node(obs_vector, next_step) == NULL))
-            next_step++;
-
-        if (next_step == size)
-            return -1; /* No more active steps. */
-        else
-            return next_step;
-    }
+    const auto &step_list = obs_vector->step_list;
+    auto next = std::upper_bound(step_list.begin(), step_list.end(), prev_step);
+    if (next == step_list.end())
+        return -1; /* No more active steps. */
+    else
+        return *next;
 }
 
 /**
@@ -849,6 +879,13 @@ obs_vector_type *obs_vector_alloc_from_BLOCK_OBSERVATION(
 void obs_vector_iget_observations(const obs_vector_type *obs_vector,
                                   int report_step, obs_data_type *obs_data,
                                   enkf_fs_type *fs) {
+    if (obs_vector->summary_obs) {
+        int index = obs_vector->summary_obs->find(report_step);
+        if (index >= 0)
+            obs_vector->summary_obs->get_observations(index, obs_data);
+        return;
+    }
+
     void *obs_node = (void *)vector_iget(obs_vector->nodes, report_step);
     if (obs_node != NULL)
         obs_vector->get_obs(obs_node, obs_data, fs, report_step);
@@ -859,8 +896,12 @@ void obs_vector_measure(const obs_vector_type *obs_vector, enkf_fs_type *fs,
                         const std::vector<int> &ens_active_list,
                         meas_data_type *meas_data) {
 
-    void *obs_node = (void *)vector_iget(obs_vector->nodes, report_step);
-    if (obs_node != NULL) {
+    if (obs_vector_iget_active(obs_vector, report_step)) {
+        const SummaryObsStore *summary_obs = obs_vector->summary_obs;
+        int summary_index = summary_obs ? summary_obs->find(report_step) : -1;
+        void *obs_node = summary_obs ? NULL
+                                     : obs_vector_iget_node(obs_vector,
+                                                            report_step);
         enkf_node_type *enkf_node =
             enkf_node_deep_alloc(obs_vector->config_node);
 
@@ -872,8 +913,14 @@ void obs_vector_measure(const obs_vector_type *obs_vector, enkf_fs_type *fs,
             node_id.iens = ens_active_list[active_iens_index];
 
             enkf_node_load(enkf_node, fs, node_id);
-            obs_vector->measure(obs_node, enkf_node_value_ptr(enkf_node),
-                                node_id, meas_data);
+            if (summary_obs)
+                summary_obs->measure(
+                    summary_index,
+                    (const summary_type *)enkf_node_value_ptr(enkf_node),
+                    node_id, meas_data);
+            else
+                obs_vector->measure(obs_node, enkf_node_value_ptr(enkf_node),
+                                    node_id, meas_data);
         }
 
         enkf_node_free(enkf_node);
@@ -884,8 +931,7 @@ static bool
 obs_vector_has_data_at_report_step(const obs_vector_type *obs_vector,
                                    const bool_vector_type *active_mask,
                                    enkf_fs_type *fs, int report_step) {
-    void *obs_node = (void *)vector_iget(obs_vector->nodes, report_step);
-    if (obs_node) {
+    if (obs_vector_iget_active(obs_vector, report_step)) {
         node_id_type node_id = {.report_step = report_step};
         for (int iens = 0; iens < bool_vector_size(active_mask); iens++) {
             if (bool_vector_iget(active_mask, iens)) {
@@ -964,6 +1010,15 @@ bool obs_vector_has_data(const obs_vector_type *obs_vector,
 static double obs_vector_chi2__(const obs_vector_type *obs_vector,
                                 int report_step, const enkf_node_type *node,
                                 node_id_type node_id) {
+    if (obs_vector->summary_obs) {
+        int index = obs_vector->summary_obs->find(report_step);
+        if (index < 0)
+            return 0.0; /* Observation not active for this report step. */
+
+        return obs_vector->summary_obs->chi2(
+            index, (const summary_type *)enkf_node_value_ptr(node), node_id);
+    }
+
     void *obs_node = (void *)vector_iget(obs_vector->nodes, report_step);
 
     if (obs_node)
@@ -974,44 +1029,55 @@ static double obs_vector_chi2__(const obs_vector_type *obs_vector,
 
 /**
    This function will evaluate the chi2 for the ensemble members
-   [iens1,iens2) and report steps [step1,step2).
+   [iens1,iens2) and report steps [step1,step2].
 
-   Observe that the chi2 pointer is assumed to be allocated for the
-   complete ensemble, altough this function only operates on part of
-   it.
+   The results are stored in @chi2 as chi2[step * ens_size + iens], i.e. the
+   table is allocated for the complete ensemble, altough this function only
+   operates on part of it. Members with missing data are marked with
+   valid[iens] = false.
+
+   Nodes with vector storage hold all the report steps of a realization, so
+   the vector is loaded once per realization and not once per report step.
 
    This will not work for container observations .....
 */
 void obs_vector_ensemble_chi2(const obs_vector_type *obs_vector,
-                              enkf_fs_type *fs, bool_vector_type *valid,
-                              int step1, int step2, int iens1, int iens2,
-                              double **chi2) {
+                              enkf_fs_type *fs, int step1, int step2,
+                              int iens1, int iens2, int ens_size, double *chi2,
+                              bool *valid) {
 
-    int step;
     enkf_node_type *enkf_node = enkf_node_alloc(obs_vector->config_node);
-    node_id_type node_id;
-    for (step = step1; step <= step2; step++) {
-        int iens;
-        node_id.report_step = step;
-        {
-            void *obs_node = (void *)vector_iget(obs_vector->nodes, step);
-
-            if (obs_node == NULL) {
-                for (iens = iens1; iens < iens2; iens++)
-                    chi2[step][iens] = 0;
-            } else {
-                for (iens = iens1; iens < iens2; iens++) {
-                    node_id.iens = iens;
-                    if (enkf_node_try_load(enkf_node, fs, node_id))
-                        chi2[step][iens] = obs_vector_chi2__(
-                            obs_vector, step, enkf_node, node_id);
-                    else {
-                        chi2[step][iens] = 0;
-                        // Missing data - this member will be marked as invalid in the misfit calculations.
-                        bool_vector_iset(valid, iens, false);
-                    }
+    bool vector_storage = enkf_node_vector_storage(enkf_node);
+    for (int iens = iens1; iens < iens2; iens++) {
+        node_id_type node_id = {.report_step = 0, .iens = iens};
+        bool vector_tried = false;
+        bool vector_loaded = false;
+        for (int step = step1; step <= step2; step++) {
+            double &step_chi2 = chi2[step * ens_size + iens];
+            step_chi2 = 0;
+            if (!obs_vector_iget_active(obs_vector, step))
+                continue;
+
+            node_id.report_step = step;
+            bool has_data;
+            if (vector_storage) {
+                if (!vector_tried) {
+                    vector_loaded =
+                        enkf_node_try_load_vector(enkf_node, fs, iens);
+                    vector_tried = true;
                 }
-            }
+                has_data = vector_loaded &&
+                           enkf_node_vector_has_data(enkf_node, step);
+            } else
+                has_data = enkf_node_try_load(enkf_node, fs, node_id);
+
+            if (has_data)
+                step_chi2 =
+                    obs_vector_chi2__(obs_vector, step, enkf_node, node_id);
+            else
+                // Missing data - this member will be marked as invalid in the
+                // misfit calculations.
+                valid[iens] = false;
         }
     }
     enkf_node_free(enkf_node);
@@ -1027,15 +1093,12 @@ double obs_vector_total_chi2(const obs_vector_type *obs_vector,
     enkf_node_type *enkf_node = enkf_node_deep_alloc(obs_vector->config_node);
     node_id_type node_id = {.report_step = 0, .iens = iens};
 
-    int vec_size = vector_get_size(obs_vector->nodes);
-    for (int report_step = 0; report_step < vec_size; report_step++) {
-        if (vector_iget(obs_vector->nodes, report_step) != NULL) {
-            node_id.report_step = report_step;
+    for (int report_step : obs_vector->step_list) {
+        node_id.report_step = report_step;
 
-            if (enkf_node_try_load(enkf_node, fs, node_id))
-                sum_chi2 += obs_vector_chi2__(obs_vector, report_step,
-                                              enkf_node, node_id);
-        }
+        if (enkf_node_try_load(enkf_node, fs, node_id))
+            sum_chi2 += obs_vector_chi2__(obs_vector, report_step, enkf_node,
+                                          node_id);
     }
     enkf_node_free(enkf_node);
     return sum_chi2;
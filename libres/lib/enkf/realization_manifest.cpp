@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+#include <ert/res_util/file_utils.hpp>
+#include <ert/util/util.h>
+
+#include <ert/enkf/realization_manifest.hpp>
+
+namespace fs = std::filesystem;
+
+#define REALIZATION_MANIFEST_VERSION 2
+
+namespace {
+struct manifest_entry_type {
+    std::string runpath;
+    std::string keys;
+    std::vector<realization_manifest_file_type> files;
+};
+} // namespace
+
+struct realization_manifest_struct {
+    mutable std::mutex mutex;
+    std::unordered_map<int, manifest_entry_type> entries;
+};
+
+/**
+   The size and modification time of @paths - relative to @runpath unless
+   absolute - sorted by path. A file which does not exist is recorded with
+   size -1.
+*/
+std::vector<realization_manifest_file_type>
+realization_manifest_stat(const char *runpath, std::vector<std::string> paths) {
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+    std::vector<realization_manifest_file_type> files;
+    for (const auto &path : paths) {
+        std::error_code ec;
+        fs::path file = fs::path(runpath) / path;
+        auto size = fs::file_size(file, ec);
+        if (ec) {
+            files.push_back({path, -1, 0});
+            continue;
+        }
+
+        auto mtime = fs::last_write_time(file, ec);
+        files.push_back(
+            {path, (long)size,
+             (long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 mtime.time_since_epoch())
+                 .count()});
+    }
+    return files;
+}
+
+realization_manifest_type *realization_manifest_alloc() {
+    return new realization_manifest_type;
+}
+
+void realization_manifest_free(realization_manifest_type *manifest) {
+    delete manifest;
+}
+
+void realization_manifest_fwrite(const realization_manifest_type *manifest,
+                                 const char *filename) {
+    std::lock_guard guard{manifest->mutex};
+    auto stream = mkdir_fopen(fs::path(filename), "w");
+    if (!stream)
+        util_abort("%s: failed to open: %s for writing \n", __func__,
+                   filename);
+
+    util_fwrite_int(REALIZATION_MANIFEST_VERSION, stream);
+    util_fwrite_int(manifest->entries.size(), stream);
+    for (const auto &[iens, entry] : manifest->entries) {
+        util_fwrite_int(iens, stream);
+        util_fwrite_string(entry.runpath.c_str(), stream);
+        util_fwrite_string(entry.keys.c_str(), stream);
+        util_fwrite_int(entry.files.size(), stream);
+        for (const auto &file : entry.files) {
+            util_fwrite_string(file.path.c_str(), stream);
+            util_fwrite_long(file.size, stream);
+            util_fwrite_long(file.mtime, stream);
+        }
+    }
+    fclose(stream);
+}
+
+static std::string realization_manifest_fread_string(FILE *stream) {
+    char *c_string = util_fread_alloc_string(stream);
+    std::string string = c_string ? c_string : "";
+    free(c_string);
+    return string;
+}
+
+/**
+   A missing manifest, or one written by another version, is read as an
+   empty manifest; all the realizations will then be loaded.
+*/
+void realization_manifest_fread(realization_manifest_type *manifest,
+                                const char *filename) {
+    std::lock_guard guard{manifest->mutex};
+    manifest->entries.clear();
+    if (!fs::exists(filename))
+        return;
+
+    FILE *stream = util_fopen(filename, "r");
+    if (util_fread_int(stream) == REALIZATION_MANIFEST_VERSION) {
+        int num_entries = util_fread_int(stream);
+        for (int i = 0; i < num_entries; i++) {
+            int iens = util_fread_int(stream);
+            auto &entry = manifest->entries[iens];
+            entry.runpath = realization_manifest_fread_string(stream);
+            entry.keys = realization_manifest_fread_string(stream);
+            int num_files = util_fread_int(stream);
+            for (int j = 0; j < num_files; j++) {
+                auto path = realization_manifest_fread_string(stream);
+                long size = util_fread_long(stream);
+                long mtime = util_fread_long(stream);
+                entry.files.push_back({path, size, mtime});
+            }
+        }
+    }
+    fclose(stream);
+}
+
+/**
+   Whether realization @iens was last loaded from @runpath, with the
+   configured @keys, and the @files found there now.
+*/
+bool realization_manifest_is_current(
+    const realization_manifest_type *manifest, int iens, const char *runpath,
+    const std::string &keys,
+    const std::vector<realization_manifest_file_type> &files) {
+    std::lock_guard guard{manifest->mutex};
+    auto iter = manifest->entries.find(iens);
+    if (iter == manifest->entries.end())
+        return false;
+
+    const auto &entry = iter->second;
+    if (entry.runpath != runpath || entry.keys != keys ||
+        entry.files.size() != files.size())
+        return false;
+
+    for (size_t i = 0; i < files.size(); i++)
+        if (entry.files[i].path != files[i].path ||
+            entry.files[i].size != files[i].size ||
+            entry.files[i].mtime != files[i].mtime)
+            return false;
+    return true;
+}
+
+void realization_manifest_iset(
+    realization_manifest_type *manifest, int iens, const char *runpath,
+    const std::string &keys,
+    const std::vector<realization_manifest_file_type> &files) {
+    std::lock_guard guard{manifest->mutex};
+    manifest->entries[iens] = {runpath, keys, files};
+}
+
+void realization_manifest_clear(realization_manifest_type *manifest,
+                                int iens) {
+    std::lock_guard guard{manifest->mutex};
+    manifest->entries.erase(iens);
+}
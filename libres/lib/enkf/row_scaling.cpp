@@ -96,8 +96,9 @@ double RowScaling::assign(size_t index, double value) {
   multiplications are grouped together where all rows with the same alpha valued
   are multiplied in one go.
  */
-void RowScaling::multiply(Eigen::Ref<Eigen::MatrixXd> A,
-                          const Eigen::MatrixXd &X0) const {
+template <typename Matrix>
+void RowScaling::multiply_rows(Eigen::Ref<Matrix> A,
+                               const Eigen::MatrixXd &X0) const {
     if (m_data.size() != A.rows())
         throw std::invalid_argument(
             "Size mismatch between row_scaling and A matrix");
@@ -156,7 +157,7 @@ void RowScaling::multiply(Eigen::Ref<Eigen::MatrixXd> A,
         // 3: Calculate A' = A * X for the rows with the same alpha
         for (const auto &row : row_list) {
             std::vector<double> target_row(A.cols());
-            Eigen::VectorXd src_row = A.row(row);
+            Eigen::VectorXd src_row = A.row(row).template cast<double>();
 
             for (int j = 0; j < A.cols(); j++) {
                 target_row[j] = src_row.cwiseProduct(X.col(j)).sum();
@@ -173,6 +174,20 @@ void RowScaling::multiply(Eigen::Ref<Eigen::MatrixXd> A,
     }
 }
 
+void RowScaling::multiply(Eigen::Ref<Eigen::MatrixXd> A,
+                          const Eigen::MatrixXd &X0) const {
+    multiply_rows(A, X0);
+}
+
+/**
+  For a single precision A the scaled X matrices and the row products are
+  still computed in double precision.
+*/
+void RowScaling::multiply(Eigen::Ref<Eigen::MatrixXf> A,
+                          const Eigen::MatrixXd &X0) const {
+    multiply_rows(A, X0);
+}
+
 void RowScaling::assign_vector(const float *data, size_t size) {
     m_resize(size);
     for (int index = 0; index < size; index++)
@@ -236,5 +251,12 @@ RES_LIB_SUBMODULE("local.row_scaling", m) {
         .def("assign_vector", &assign_vector<float>, py::doc{assign_vector_doc},
              "scaling_vector"_a)
         .def("assign_vector", &assign_vector<double>, "scaling_vector"_a)
-        .def("multiply", &RowScaling::multiply);
+        .def("multiply",
+             py::overload_cast<Eigen::Ref<Eigen::MatrixXd>,
+                               const Eigen::MatrixXd &>(&RowScaling::multiply,
+                                                        py::const_))
+        .def("multiply",
+             py::overload_cast<Eigen::Ref<Eigen::MatrixXf>,
+                               const Eigen::MatrixXd &>(&RowScaling::multiply,
+                                                        py::const_));
 }
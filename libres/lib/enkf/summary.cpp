@@ -18,6 +18,8 @@
 
 #include <stdlib.h>
 
+#include <vector>
+
 #include <ert/util/double_vector.h>
 #include <ert/util/util.h>
 
@@ -235,62 +237,77 @@ bool summary_forward_load(summary_type *summary, const char *ecl_file_name,
     return loadOK;
 }
 
-bool summary_forward_load_vector(summary_type *summary,
-                                 const char *ecl_file_name,
-                                 const forward_load_context_type *load_context,
-                                 const int_vector_type *time_index) {
-    bool loadOK = false;
-
-    const ecl_sum_type *ecl_sum =
-        forward_load_context_get_ecl_sum(load_context);
+/**
+   Internalizes the vectors of all the @summaries from @ecl_sum in one
+   pass. The ecl_sum time index of every report step in @time_index is
+   found once, and every key is resolved to its ecl_sum parameter index
+   once, after which the values of each key are copied column by column.
+
+   The load fail modes are handled as for a single vector: a key which is
+   missing is filled with zeros with LOAD_FAIL_WARN and LOAD_FAIL_SILENT,
+   and nodes with LOAD_FAIL_EXIT are not loaded and make the load fail.
+   Returns false if any of the vectors failed to load.
+*/
+bool summary_forward_load_vectors(const std::vector<summary_type *> &summaries,
+                                  const ecl_sum_type *ecl_sum,
+                                  const int_vector_type *time_index) {
     if (ecl_sum == NULL)
         return false;
 
-    const char *var_key = summary_config_get_var(summary->config);
-    load_fail_type load_fail_action =
-        summary_config_get_load_fail_mode(summary->config);
-    bool normal_load = false;
+    const int size = int_vector_size(time_index);
+    std::vector<int> report_end(size, -1);
+    for (int store_index = 0; store_index < size; store_index++) {
+        int summary_index = int_vector_iget(time_index, store_index);
+        if (summary_index >= 0 &&
+            ecl_sum_has_report_step(ecl_sum, summary_index))
+            report_end[store_index] =
+                ecl_sum_iget_report_end(ecl_sum, summary_index);
+    }
 
-    if (load_fail_action != LOAD_FAIL_EXIT) {
-        // The load will always ~succeed - but if we do not have the data; we
-        // will fill the vector with zeros.
+    bool loadOK = true;
+    for (summary_type *summary : summaries) {
+        const char *var_key = summary_config_get_var(summary->config);
+        load_fail_type load_fail_action =
+            summary_config_get_load_fail_mode(summary->config);
+        if (load_fail_action == LOAD_FAIL_EXIT) {
+            loadOK = false;
+            continue;
+        }
 
         if (!ecl_sum_has_general_var(ecl_sum, var_key)) {
-            for (int step = 0; step < int_vector_size(time_index); step++) {
+            // The load will always ~succeed - but if we do not have the data;
+            // we will fill the vector with zeros.
+            for (int step = 0; step < size; step++) {
                 int summary_step = int_vector_iget(time_index, step);
                 if (summary_step >= 0)
                     double_vector_iset(summary->data_vector, summary_step, 0);
             }
-            loadOK = true;
 
             if (load_fail_action == LOAD_FAIL_WARN)
                 fprintf(
                     stderr,
                     "** WARNING ** Failed summary:%s does not have key:%s \n",
                     ecl_sum_get_case(ecl_sum), var_key);
-        } else
-            normal_load = true;
-    }
-
-    if (!normal_load)
-        return loadOK;
-
-    int key_index = ecl_sum_get_general_var_params_index(ecl_sum, var_key);
-    for (int store_index = 0; store_index < int_vector_size(time_index);
-         store_index++) {
-        int summary_index = int_vector_iget(time_index, store_index);
+            continue;
+        }
 
-        if (summary_index >= 0) {
-            if (ecl_sum_has_report_step(ecl_sum, summary_index)) {
-                int last_update_step_index =
-                    ecl_sum_iget_report_end(ecl_sum, summary_index);
-                double_vector_iset(
-                    summary->data_vector, store_index,
-                    ecl_sum_iget(ecl_sum, last_update_step_index, key_index));
-            }
+        int key_index = ecl_sum_get_general_var_params_index(ecl_sum, var_key);
+        for (int store_index = 0; store_index < size; store_index++) {
+            int time_step = report_end[store_index];
+            if (time_step >= 0)
+                double_vector_iset(summary->data_vector, store_index,
+                                   ecl_sum_iget(ecl_sum, time_step, key_index));
         }
     }
-    return true;
+    return loadOK;
+}
+
+bool summary_forward_load_vector(summary_type *summary,
+                                 const char *ecl_file_name,
+                                 const forward_load_context_type *load_context,
+                                 const int_vector_type *time_index) {
+    return summary_forward_load_vectors(
+        {summary}, forward_load_context_get_ecl_sum(load_context), time_index);
 }
 
 UTIL_SAFE_CAST_FUNCTION(summary, SUMMARY)
@@ -19,6 +19,8 @@
 /*
    See the overview documentation of the observation system in enkf_obs.c
 */
+#include <algorithm>
+
 #include <stdlib.h>
 
 #include <ert/util/util.h>
@@ -30,17 +32,90 @@
 #define SUMMARY_OBS_TYPE_ID 66103
 #define OBS_SIZE 1
 
+SummaryObsStore::SummaryObsStore(const char *summary_key, const char *obs_key)
+    : summary_key(summary_key), obs_key(obs_key) {}
+
+/**
+   Add the observation at @report_step, replacing any observation already
+   present at that step. Returns the index of the observation in the arrays.
+*/
+int SummaryObsStore::add(int report_step, double value, double std) {
+    auto iter = std::lower_bound(step.begin(), step.end(), report_step);
+    int index = iter - step.begin();
+    if (iter == step.end() || *iter != report_step) {
+        step.insert(iter, report_step);
+        this->value.insert(this->value.begin() + index, value);
+        stddev.insert(stddev.begin() + index, std);
+        std_scaling.insert(std_scaling.begin() + index, 1.0);
+    } else {
+        this->value[index] = value;
+        stddev[index] = std;
+        std_scaling[index] = 1.0;
+    }
+    return index;
+}
+
+/** Returns the index of the observation at @report_step, or -1. */
+int SummaryObsStore::find(int report_step) const {
+    auto iter = std::lower_bound(step.begin(), step.end(), report_step);
+    if (iter == step.end() || *iter != report_step)
+        return -1;
+    return iter - step.begin();
+}
+
+/** The observation key of the observation at @index. */
+const std::string &SummaryObsStore::key(int index) const {
+    if (!step_obs_key.empty()) {
+        auto iter = step_obs_key.find(step[index]);
+        if (iter != step_obs_key.end())
+            return iter->second;
+    }
+    return obs_key;
+}
+
+void SummaryObsStore::set_key(int report_step, const std::string &key) {
+    if (key == obs_key)
+        step_obs_key.erase(report_step);
+    else
+        step_obs_key[report_step] = key;
+}
+
+void SummaryObsStore::get_observations(int index,
+                                       obs_data_type *obs_data) const {
+    obs_block_type *obs_block =
+        obs_data_add_block(obs_data, key(index).c_str(), OBS_SIZE);
+    obs_block_iset(obs_block, 0, value[index],
+                   stddev[index] * std_scaling[index]);
+}
+
+void SummaryObsStore::measure(int index, const summary_type *summary,
+                              node_id_type node_id,
+                              meas_data_type *meas_data) const {
+    meas_block_type *meas_block = meas_data_add_block(
+        meas_data, key(index).c_str(), node_id.report_step, OBS_SIZE);
+    meas_block_iset(meas_block, node_id.iens, 0,
+                    summary_get(summary, node_id.report_step));
+}
+
+double SummaryObsStore::chi2(int index, const summary_type *summary,
+                             node_id_type node_id) const {
+    double x =
+        (summary_get(summary, node_id.report_step) - value[index]) /
+        stddev[index];
+    return x * x;
+}
+
+/**
+   The summary_obs instances are handles to one report step in a
+   SummaryObsStore. A summary_obs allocated with summary_obs_alloc() owns a
+   store with only that step, whereas the summary_obs instances handed out by
+   an obs_vector are views into the store of the obs_vector.
+*/
 struct summary_obs_struct {
     UTIL_TYPE_ID_DECLARATION;
-    /** The observation, in summary.x syntax, e.g. GOPR:FIELD. */
-    char *summary_key;
-    char *obs_key;
-
-    /** Observation value. */
-    double value;
-    /** Standard deviation of observation. */
-    double std;
-    double std_scaling;
+    SummaryObsStore *store;
+    int report_step;
+    bool owns_store;
 };
 
 /**
@@ -61,93 +136,129 @@ summary_obs_type *summary_obs_alloc(const char *summary_key,
     summary_obs_type *obs = (summary_obs_type *)util_malloc(sizeof *obs);
     UTIL_TYPE_ID_INIT(obs, SUMMARY_OBS_TYPE_ID)
 
-    obs->summary_key = util_alloc_string_copy(summary_key);
-    obs->obs_key = util_alloc_string_copy(obs_key);
-    obs->value = value;
-    obs->std = std;
-    obs->std_scaling = 1.0;
+    obs->store = new SummaryObsStore(summary_key, obs_key);
+    obs->report_step = 0;
+    obs->owns_store = true;
+    obs->store->add(obs->report_step, value, std);
 
     return obs;
 }
 
+summary_obs_type *summary_obs_alloc_view(SummaryObsStore *store,
+                                         int report_step) {
+    summary_obs_type *obs = (summary_obs_type *)util_malloc(sizeof *obs);
+    UTIL_TYPE_ID_INIT(obs, SUMMARY_OBS_TYPE_ID)
+
+    obs->store = store;
+    obs->report_step = report_step;
+    obs->owns_store = false;
+    return obs;
+}
+
+/**
+   Move the observation of a standalone summary_obs into @store at
+   @report_step, and turn the summary_obs into a view of that step.
+*/
+void summary_obs_attach(summary_obs_type *summary_obs, SummaryObsStore *store,
+                        int report_step) {
+    if (!summary_obs->owns_store)
+        util_abort("%s: summary observation already attached to an "
+                   "observation vector\n",
+                   __func__);
+
+    SummaryObsStore *own_store = summary_obs->store;
+    int index = store->add(report_step, own_store->value[0],
+                           own_store->stddev[0]);
+    store->std_scaling[index] = own_store->std_scaling[0];
+    store->set_key(report_step, own_store->obs_key);
+
+    delete own_store;
+    summary_obs->store = store;
+    summary_obs->report_step = report_step;
+    summary_obs->owns_store = false;
+}
+
+bool summary_obs_is_view(const summary_obs_type *summary_obs) {
+    return !summary_obs->owns_store;
+}
+
 static UTIL_SAFE_CAST_FUNCTION_CONST(summary_obs, SUMMARY_OBS_TYPE_ID);
 static UTIL_SAFE_CAST_FUNCTION(summary_obs, SUMMARY_OBS_TYPE_ID);
 UTIL_IS_INSTANCE_FUNCTION(summary_obs, SUMMARY_OBS_TYPE_ID);
 
 void summary_obs_free(summary_obs_type *summary_obs) {
-    free(summary_obs->summary_key);
-    free(summary_obs->obs_key);
+    if (summary_obs->owns_store)
+        delete summary_obs->store;
     free(summary_obs);
 }
 
+static int summary_obs_index(const summary_obs_type *summary_obs) {
+    int index = summary_obs->store->find(summary_obs->report_step);
+    if (index < 0)
+        util_abort("%s: internal error - no observation at report step:%d\n",
+                   __func__, summary_obs->report_step);
+    return index;
+}
+
 const char *summary_obs_get_summary_key(const summary_obs_type *summary_obs) {
-    return summary_obs->summary_key;
+    return summary_obs->store->summary_key.c_str();
 }
 
 void summary_obs_get_observations(const summary_obs_type *summary_obs,
                                   obs_data_type *obs_data, enkf_fs_type *fs,
                                   int report_step) {
-
-    obs_block_type *obs_block =
-        obs_data_add_block(obs_data, summary_obs->obs_key, OBS_SIZE);
-    obs_block_iset(obs_block, 0, summary_obs->value,
-                   summary_obs->std * summary_obs->std_scaling);
+    summary_obs->store->get_observations(summary_obs_index(summary_obs),
+                                         obs_data);
 }
 
 void summary_obs_measure(const summary_obs_type *obs,
                          const summary_type *summary, node_id_type node_id,
                          meas_data_type *meas_data) {
-    {
-        meas_block_type *meas_block = meas_data_add_block(
-            meas_data, obs->obs_key, node_id.report_step, OBS_SIZE);
-        meas_block_iset(meas_block, node_id.iens, 0,
-                        summary_get(summary, node_id.report_step));
-    }
+    obs->store->measure(summary_obs_index(obs), summary, node_id, meas_data);
 }
 
 C_USED double summary_obs_chi2(const summary_obs_type *obs,
                                const summary_type *summary,
                                node_id_type node_id) {
-    double x =
-        (summary_get(summary, node_id.report_step) - obs->value) / obs->std;
-    return x * x;
+    return obs->store->chi2(summary_obs_index(obs), summary, node_id);
 }
 
 void summary_obs_user_get(const summary_obs_type *summary_obs,
                           const char *index_key, double *value, double *std,
                           bool *valid) {
     *valid = true;
-    *value = summary_obs->value;
-    *std = summary_obs->std;
+    *value = summary_obs_get_value(summary_obs);
+    *std = summary_obs_get_std(summary_obs);
 }
 
 double summary_obs_get_value(const summary_obs_type *summary_obs) {
-    return summary_obs->value;
+    return summary_obs->store->value[summary_obs_index(summary_obs)];
 }
 
 double summary_obs_get_std(const summary_obs_type *summary_obs) {
-    return summary_obs->std;
+    return summary_obs->store->stddev[summary_obs_index(summary_obs)];
 }
 
 double summary_obs_get_std_scaling(const summary_obs_type *summary_obs) {
-    return summary_obs->std_scaling;
+    return summary_obs->store->std_scaling[summary_obs_index(summary_obs)];
 }
 
 void summary_obs_update_std_scale(summary_obs_type *summary_obs,
                                   double std_multiplier,
                                   const ActiveList *active_list) {
     if (active_list->getMode() == ALL_ACTIVE)
-        summary_obs->std_scaling = std_multiplier;
+        summary_obs_set_std_scale(summary_obs, std_multiplier);
     else {
         int size = active_list->active_size(OBS_SIZE);
         if (size > 0)
-            summary_obs->std_scaling = std_multiplier;
+            summary_obs_set_std_scale(summary_obs, std_multiplier);
     }
 }
 
 void summary_obs_set_std_scale(summary_obs_type *summary_obs,
                                double std_multiplier) {
-    summary_obs->std_scaling = std_multiplier;
+    summary_obs->store->std_scaling[summary_obs_index(summary_obs)] =
+        std_multiplier;
 }
 
 VOID_FREE(summary_obs)
@@ -1,7 +1,13 @@
 #ifndef ERT_CONCURRENCY_HPP
 #define ERT_CONCURRENCY_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 // Standard support for semaphores arrived in C++20, so make our own for now
 // Idea and most of code is from
@@ -27,4 +33,33 @@ private:
     size_t count;
 };
 
+namespace ert {
+/**
+   Call @func(index) for every index in [0, size), spread over at most
+   std::thread::hardware_concurrency() threads. The indices are handed out
+   one at a time, so uneven work is balanced between the threads. An
+   exception thrown by @func is rethrown in the calling thread.
+*/
+template <typename Func> void parallel_for(int size, Func &&func) {
+    int num_threads = std::min<int>(
+        std::max(1U, std::thread::hardware_concurrency()), size);
+    if (num_threads <= 1) {
+        for (int index = 0; index < size; index++)
+            func(index);
+        return;
+    }
+
+    std::atomic<int> next_index = 0;
+    std::vector<std::future<void>> futures;
+    for (int thread = 0; thread < num_threads; thread++)
+        futures.push_back(std::async(std::launch::async, [&] {
+            for (int index = next_index++; index < size; index = next_index++)
+                func(index);
+        }));
+
+    for (auto &future : futures)
+        future.get();
+}
+} // namespace ert
+
 #endif
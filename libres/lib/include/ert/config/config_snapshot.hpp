@@ -0,0 +1,35 @@
+#ifndef ERT_CONFIG_SNAPSHOT_H
+#define ERT_CONFIG_SNAPSHOT_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/** The tokens of all the non-empty lines of one configuration file. */
+typedef std::vector<std::vector<std::string>> config_token_lines;
+
+/**
+   Snapshots of tokenized configuration files.
+
+   Tokenizing the configuration files is the same work every time ERT starts,
+   and every time a workflow or a job description is loaded. The snapshots
+   are kept in memory for the lifetime of the process, and are additionally
+   stored as binary files in the directory given by the environment variable
+   ERT_CONFIG_CACHE_DIR if that is set.
+
+   A snapshot is identified by the canonical path of the file and the
+   comment string used when tokenizing it, and is only used as long as the
+   modification time, size and content hash of the file are unchanged.
+   Hashing the file is much cheaper than tokenizing it, and catches edits
+   which keep both the size and the modification time.
+*/
+std::shared_ptr<const config_token_lines>
+config_snapshot_load(const char *config_file, const char *comment_string);
+
+void config_snapshot_store(const char *config_file, const char *comment_string,
+                           std::shared_ptr<const config_token_lines> lines);
+
+/** Drop all the in-memory snapshots; the snapshot files are kept. */
+void config_snapshot_clear();
+
+#endif
@@ -49,12 +49,15 @@ public:
                    buffer_type *buffer);
     void save_node(const char *node_key, int report_step, int iens,
                    buffer_type *buffer);
+    bool copy_node(block_fs_driver *target, const char *node_key,
+                   int src_report_step, int target_report_step, int iens);
 
     bool has_vector(const char *node_key, int iens);
     void load_vector(const char *node_key, int iens, buffer_type *buffer);
     void save_vector(const char *node_key, int iens, buffer_type *buffer);
 
     void fsync();
+    bool snapshot(block_fs_driver *src);
 
 private:
     void mount();
@@ -29,6 +29,7 @@
 #include <ert/enkf/fs_driver.hpp>
 #include <ert/enkf/fs_types.hpp>
 #include <ert/enkf/misfit_ensemble_typedef.hpp>
+#include <ert/enkf/realization_manifest.hpp>
 #include <ert/enkf/state_map.hpp>
 #include <ert/enkf/summary_key_set.hpp>
 #include <ert/enkf/time_map.hpp>
@@ -69,6 +70,11 @@ void enkf_fs_fread_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
 
 bool enkf_fs_has_vector(enkf_fs_type *enkf_fs, const char *node_key,
                         enkf_var_type var_type, int iens);
+bool enkf_fs_snapshot_parameters(enkf_fs_type *src_fs,
+                                 enkf_fs_type *target_fs);
+bool enkf_fs_copy_node(enkf_fs_type *src_fs, enkf_fs_type *target_fs,
+                       const char *node_key, enkf_var_type var_type,
+                       int src_report_step, int target_report_step, int iens);
 bool enkf_fs_has_node(enkf_fs_type *enkf_fs, const char *node_key,
                       enkf_var_type var_type, int report_step, int iens);
 
@@ -94,6 +100,8 @@ FILE *enkf_fs_open_excase_tstep_file(const enkf_fs_type *fs,
 
 state_map_type *enkf_fs_alloc_readonly_state_map(const char *mount_point);
 extern "C" state_map_type *enkf_fs_get_state_map(const enkf_fs_type *fs);
+realization_manifest_type *
+enkf_fs_get_realization_manifest(const enkf_fs_type *fs);
 extern "C" time_map_type *enkf_fs_get_time_map(const enkf_fs_type *fs);
 misfit_ensemble_type *enkf_fs_get_misfit_ensemble(const enkf_fs_type *fs);
 extern "C" summary_key_set_type *
@@ -155,6 +155,8 @@ extern "C" bool enkf_node_try_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
 bool enkf_node_try_load_vector(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                int iens);
 bool enkf_node_vector_storage(const enkf_node_type *node);
+bool enkf_node_vector_has_data(const enkf_node_type *enkf_node,
+                               int report_step);
 enkf_node_type *
 enkf_node_alloc_shared_container(const enkf_config_node_type *config,
                                  hash_type *node_hash);
@@ -57,7 +57,7 @@ extern "C" obs_vector_type *enkf_obs_get_vector(const enkf_obs_type *,
 extern "C" void enkf_obs_add_obs_vector(enkf_obs_type *enkf_obs,
                                         const obs_vector_type *vector);
 
-void enkf_obs_load(enkf_obs_type *, const char *, double);
+void enkf_obs_load(enkf_obs_type *, const char *, double, const char *);
 extern "C" void enkf_obs_clear(enkf_obs_type *enkf_obs);
 extern "C" obs_impl_type enkf_obs_get_type(const enkf_obs_type *enkf_obs,
                                            const char *key);
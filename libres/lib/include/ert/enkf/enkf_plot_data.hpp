@@ -21,6 +21,8 @@
 
 #include <stdbool.h>
 
+#include <vector>
+
 #include <ert/util/bool_vector.h>
 #include <ert/util/type_macros.h>
 
@@ -39,6 +41,14 @@ extern "C" void enkf_plot_data_load(enkf_plot_data_type *plot_data,
 extern "C" int enkf_plot_data_get_size(const enkf_plot_data_type *plot_data);
 extern "C" enkf_plot_tvector_type *
 enkf_plot_data_iget(const enkf_plot_data_type *plot_data, int index);
+int enkf_plot_data_get_step_count(enkf_fs_type *fs);
+void enkf_plot_data_load_matrix(const enkf_config_node_type *config_node,
+                                enkf_fs_type *fs, const char *index_key,
+                                const std::vector<int> &realizations,
+                                double *data);
+void enkf_plot_data_load_matrix(const enkf_config_node_type *config_node,
+                                enkf_fs_type *fs, const char *index_key,
+                                double *data);
 
 UTIL_IS_INSTANCE_HEADER(enkf_plot_data);
 
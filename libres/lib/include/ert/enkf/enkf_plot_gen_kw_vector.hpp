@@ -32,6 +32,8 @@ enkf_plot_gen_kw_vector_alloc(const enkf_config_node_type *config_node,
 void enkf_plot_gen_kw_vector_free(enkf_plot_gen_kw_vector_type *vector);
 extern "C" int
 enkf_plot_gen_kw_vector_get_size(const enkf_plot_gen_kw_vector_type *vector);
+void enkf_plot_gen_kw_vector_iset(enkf_plot_gen_kw_vector_type *vector,
+                                  int index, double value);
 void enkf_plot_gen_kw_vector_reset(enkf_plot_gen_kw_vector_type *vector);
 void enkf_plot_gen_kw_vector_load(enkf_plot_gen_kw_vector_type *vector,
                                   enkf_fs_type *fs, bool transform_data,
@@ -55,7 +55,12 @@ void enkf_state_initialize(enkf_state_type *enkf_state, rng_type *rng,
 
 std::pair<fw_load_status, std::string>
 enkf_state_load_from_forward_model(enkf_state_type *enkf_state,
-                                   run_arg_type *run_arg);
+                                   run_arg_type *run_arg, bool force = true);
+std::pair<fw_load_status, std::string>
+enkf_state_load_from_forward_model__(ensemble_config_type *ens_config,
+                                     model_config_type *model_config,
+                                     const ecl_config_type *ecl_config,
+                                     const run_arg_type *run_arg, bool force);
 
 enkf_state_type *enkf_state_alloc(int, rng_type *main_rng, model_config_type *,
                                   ensemble_config_type *,
@@ -20,6 +20,8 @@
 #define EXT_PARAM_H
 #include <ert/util/type_macros.h>
 
+#include <ert/tooling.hpp>
+
 #include <ert/enkf/ext_param_config.hpp>
 
 typedef struct ext_param_struct ext_param_type;
@@ -40,6 +42,10 @@ extern "C" double ext_param_key_suffix_get(const ext_param_type *param,
                                            const char *key, const char *suffix);
 extern "C" void ext_param_json_export(const ext_param_type *ext_param,
                                       const char *json_file);
+extern "C" bool ext_param_set_from_json(ext_param_type *param,
+                                        const char *json_file);
+extern "C" PY_USED bool
+ext_param_set_from_json_string(ext_param_type *param, const char *json_text);
 extern "C" void ext_param_free(ext_param_type *ext_param);
 extern "C" ext_param_type *ext_param_alloc(const ext_param_config_type *config);
 extern "C" ext_param_config_type const *
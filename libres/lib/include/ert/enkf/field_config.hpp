@@ -129,6 +129,9 @@ int field_config_get_byte_size(const field_config_type *);
 int field_config_get_sizeof_ctype(const field_config_type *);
 int field_config_active_index(const field_config_type *, int, int, int);
 int field_config_global_index(const field_config_type *, int, int, int);
+const int *field_config_get_active_permutation(const field_config_type *,
+                                               bool rms_index_order);
+const int *field_config_get_rms_global_permutation(const field_config_type *);
 bool field_config_ijk_valid(const field_config_type *, int, int, int);
 extern "C" bool field_config_ijk_active(const field_config_type *config, int i,
                                         int j, int k);
@@ -142,6 +145,10 @@ const char *field_config_get_key(const field_config_type *);
 bool field_config_keep_inactive_cells(const field_config_type *);
 field_func_type *field_config_get_init_transform(const field_config_type *);
 field_func_type *field_config_get_output_transform(const field_config_type *);
+field_array_func_type *
+field_config_get_init_array_transform(const field_config_type *);
+field_array_func_type *
+field_config_get_output_array_transform(const field_config_type *);
 bool field_config_is_valid(const field_config_type *field_config);
 void field_config_assert_binary(const field_config_type *,
                                 const field_config_type *, const char *);
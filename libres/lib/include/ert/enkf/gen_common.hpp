@@ -26,6 +26,8 @@
 #include <ert/enkf/gen_data_config.hpp>
 
 void *gen_common_fscanf_alloc(const char *, ecl_data_type, int *);
+void *gen_common_fparse_alloc(const char *, ecl_data_type, int *);
+void gen_common_fparse_active_mask(const char *, int, bool *);
 void *gen_common_fread_alloc(const char *, ecl_data_type, int *);
 void *gen_common_fload_alloc(const char *, gen_data_file_format_type,
                              ecl_data_type, ecl_type_enum *, int *);
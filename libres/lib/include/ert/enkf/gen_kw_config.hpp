@@ -44,6 +44,8 @@ extern "C" const char *
 gen_kw_config_get_template_file(const gen_kw_config_type *);
 extern "C" void gen_kw_config_free(gen_kw_config_type *);
 double gen_kw_config_transform(const gen_kw_config_type *, int index, double x);
+void gen_kw_config_transform_many(const gen_kw_config_type *, int index,
+                                  const double *x, double *y, size_t n);
 extern "C" bool
 gen_kw_config_should_use_log_scale(const gen_kw_config_type *config, int index);
 extern "C" int gen_kw_config_get_data_size(const gen_kw_config_type *);
@@ -0,0 +1,59 @@
+#ifndef ERT_NODE_CODEC_H
+#define ERT_NODE_CODEC_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <ert/util/buffer.h>
+
+#include <ert/enkf/enkf_types.hpp>
+
+/**
+   The codecs used when storing the data array of FIELD and GEN_DATA nodes.
+
+   zlib is the original format, and is still the default. The other codecs
+   write a small header in front of the data recording the codec, so that
+   payloads written with zlib before the codecs existed are still readable:
+
+     none: The data are stored as they are, reading is a plain copy.
+     lz:   A fast LZ77 codec in the style of LZ4, implemented in
+           node_codec.cpp.
+
+   Any codec can be combined with byte shuffling, where byte b of all the
+   elements is stored before byte b + 1 of all the elements. For smooth
+   float and double arrays the exponent and high mantissa bytes then come
+   in long runs, which compress much better.
+
+   The codec of a node type is selected with node_codec_set(), or with the
+   environment variable ERT_STORAGE_CODEC, e.g.
+   ERT_STORAGE_CODEC=FIELD=lz+shuffle,GEN_DATA=none.
+*/
+enum class node_codec_type : int { zlib = 0, none = 1, lz = 2 };
+
+struct node_codec_spec {
+    node_codec_type codec = node_codec_type::zlib;
+    bool shuffle = false;
+};
+
+node_codec_spec node_codec_parse(const std::string &name);
+std::string node_codec_name(node_codec_spec spec);
+
+node_codec_spec node_codec_get(ert_impl_type impl_type);
+void node_codec_set(ert_impl_type impl_type, node_codec_spec spec);
+
+void node_codec_fwrite(buffer_type *buffer, node_codec_spec spec,
+                       const void *data, size_t element_size,
+                       size_t byte_size);
+void node_codec_fread(buffer_type *buffer, void *data, size_t element_size,
+                      size_t byte_size);
+
+void node_codec_shuffle(const void *src, void *target, size_t element_size,
+                        size_t byte_size);
+void node_codec_unshuffle(const void *src, void *target, size_t element_size,
+                          size_t byte_size);
+std::vector<char> node_codec_lz_compress(const void *data, size_t byte_size);
+bool node_codec_lz_decompress(const void *src, size_t src_size, void *target,
+                              size_t byte_size);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef ERT_OBS_CACHE_H
+#define ERT_OBS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** The observations built from one HISTORY_OBSERVATION keyword. */
+struct history_obs_cache_entry {
+    /** False if the history did not have data for the key. */
+    bool valid;
+    std::vector<int> step;
+    std::vector<double> value;
+    std::vector<double> stddev;
+};
+
+/**
+   Persisted binary cache of the observation vectors built from the
+   HISTORY_OBSERVATION keywords of an observation configuration file.
+
+   The cache is only valid for the exact input it was built from; the
+   calling scope computes a key from the content of all the input (see
+   obs_cache_hash_file()) and the cache file is ignored unless it was stored
+   with the same key.
+*/
+class HistoryObsCache {
+public:
+    explicit HistoryObsCache(std::uint64_t key) : m_key(key) {}
+
+    bool load(const std::string &file);
+    bool save(const std::string &file) const;
+
+    const history_obs_cache_entry *get(const std::string &obs_key) const;
+    void set(const std::string &obs_key, history_obs_cache_entry entry);
+
+private:
+    std::uint64_t m_key;
+    std::unordered_map<std::string, history_obs_cache_entry> m_entries;
+};
+
+std::uint64_t obs_cache_hash_bytes(const void *data, std::size_t size,
+                                   std::uint64_t hash);
+bool obs_cache_hash_file(const char *file, std::uint64_t &hash);
+
+#endif
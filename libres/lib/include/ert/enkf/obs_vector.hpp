@@ -38,6 +38,7 @@
 #include <ert/enkf/enkf_types.hpp>
 #include <ert/enkf/ensemble_config.hpp>
 #include <ert/enkf/obs_data.hpp>
+#include <ert/enkf/summary_obs.hpp>
 #include <ert/enkf/time_map.hpp>
 
 typedef enum { GEN_OBS = 1, SUMMARY_OBS = 2, BLOCK_OBS = 3 } obs_impl_type;
@@ -103,11 +104,16 @@ extern "C" obs_vector_type *obs_vector_alloc(obs_impl_type obs_type,
 
 extern "C" void obs_vector_install_node(obs_vector_type *obs_vector,
                                         int obs_index, void *node);
+void obs_vector_add_summary_obs(obs_vector_type *obs_vector, int obs_index,
+                                const char *summary_key, const char *obs_key,
+                                double value, double std);
+const SummaryObsStore *
+obs_vector_get_summary_obs(const obs_vector_type *obs_vector);
 
 void obs_vector_ensemble_chi2(const obs_vector_type *obs_vector,
-                              enkf_fs_type *fs, bool_vector_type *valid,
-                              int step1, int step2, int iens1, int iens2,
-                              double **chi2);
+                              enkf_fs_type *fs, int step1, int step2,
+                              int iens1, int iens2, int ens_size, double *chi2,
+                              bool *valid);
 
 extern "C" double obs_vector_total_chi2(const obs_vector_type *, enkf_fs_type *,
                                         int);
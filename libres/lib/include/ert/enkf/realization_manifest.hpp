@@ -0,0 +1,48 @@
+#ifndef ERT_REALIZATION_MANIFEST_H
+#define ERT_REALIZATION_MANIFEST_H
+
+#include <string>
+#include <vector>
+
+/**
+   The runpath files the results of each realization were loaded from.
+
+   When a realization has been loaded the size and modification time of the
+   files in its runpath which the loaders read are recorded in the manifest,
+   which is stored in the case directory next to the state map. A later
+   load can then skip the realization if neither the files nor the
+   configured keys - with their result files and report steps - have
+   changed.
+*/
+typedef struct realization_manifest_struct realization_manifest_type;
+
+typedef struct {
+    /** The path relative to the runpath */
+    std::string path;
+    long size;
+    /** The modification time in nanoseconds */
+    long mtime;
+} realization_manifest_file_type;
+
+std::vector<realization_manifest_file_type>
+realization_manifest_stat(const char *runpath, std::vector<std::string> paths);
+
+realization_manifest_type *realization_manifest_alloc();
+void realization_manifest_free(realization_manifest_type *manifest);
+void realization_manifest_fwrite(const realization_manifest_type *manifest,
+                                 const char *filename);
+void realization_manifest_fread(realization_manifest_type *manifest,
+                                const char *filename);
+
+bool realization_manifest_is_current(
+    const realization_manifest_type *manifest, int iens, const char *runpath,
+    const std::string &keys,
+    const std::vector<realization_manifest_file_type> &files);
+void realization_manifest_iset(
+    realization_manifest_type *manifest, int iens, const char *runpath,
+    const std::string &keys,
+    const std::vector<realization_manifest_file_type> &files);
+void realization_manifest_clear(realization_manifest_type *manifest,
+                                int iens);
+
+#endif
@@ -8,6 +8,8 @@ class RowScaling : public std::enable_shared_from_this<RowScaling> {
     std::vector<double> m_data;
 
     void m_resize(size_t new_size);
+    template <typename Matrix>
+    void multiply_rows(Eigen::Ref<Matrix> A, const Eigen::MatrixXd &X0) const;
 
 public:
     double operator[](size_t index) const;
@@ -15,6 +17,8 @@ public:
     double clamp(double value) const;
     void multiply(Eigen::Ref<Eigen::MatrixXd> A,
                   const Eigen::MatrixXd &X0) const;
+    void multiply(Eigen::Ref<Eigen::MatrixXf> A,
+                  const Eigen::MatrixXd &X0) const;
     size_t size() const;
 
     void assign_vector(const float *data, size_t size);
@@ -18,7 +18,10 @@
 
 #ifndef ERT_SUMMARY_H
 #define ERT_SUMMARY_H
+#include <vector>
+
 #include <ert/util/double_vector.h>
+#include <ert/util/int_vector.h>
 
 #include <ert/ecl/ecl_file.h>
 #include <ert/ecl/ecl_sum.h>
@@ -36,6 +39,9 @@ extern "C" void summary_set(summary_type *summary, int report_step,
 bool summary_active_value(double value);
 extern "C" int summary_length(const summary_type *summary);
 extern "C" double summary_undefined_value();
+bool summary_forward_load_vectors(const std::vector<summary_type *> &summaries,
+                                  const ecl_sum_type *ecl_sum,
+                                  const int_vector_type *time_index);
 
 VOID_HAS_DATA_HEADER(summary);
 UTIL_SAFE_CAST_HEADER(summary);
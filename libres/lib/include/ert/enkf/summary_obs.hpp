@@ -21,6 +21,10 @@
 
 #include <stdbool.h>
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <ert/sched/history.hpp>
 
 #include <ert/config/conf.hpp>
@@ -32,6 +36,38 @@
 #include <ert/enkf/summary.hpp>
 #include <ert/enkf/summary_config.hpp>
 
+/**
+   All the summary observations of one obs_vector, stored as contiguous
+   arrays sorted on report step. The summary key and observation key are
+   shared by all the steps, and stored only once; the few steps installed
+   with a different observation key keep it in @step_obs_key.
+*/
+class SummaryObsStore {
+public:
+    SummaryObsStore(const char *summary_key, const char *obs_key);
+
+    int add(int report_step, double value, double std);
+    int find(int report_step) const;
+    int size() const { return step.size(); }
+    const std::string &key(int index) const;
+    void set_key(int report_step, const std::string &key);
+
+    void get_observations(int index, obs_data_type *obs_data) const;
+    void measure(int index, const summary_type *summary, node_id_type node_id,
+                 meas_data_type *meas_data) const;
+    double chi2(int index, const summary_type *summary,
+                node_id_type node_id) const;
+
+    const std::string summary_key;
+    const std::string obs_key;
+    std::vector<int> step;
+    std::vector<double> value;
+    std::vector<double> stddev;
+    std::vector<double> std_scaling;
+    /** The observation keys which differ from @obs_key, by report step. */
+    std::unordered_map<int, std::string> step_obs_key;
+};
+
 typedef struct summary_obs_struct summary_obs_type;
 
 extern "C" void summary_obs_free(summary_obs_type *summary_obs);
@@ -40,6 +76,12 @@ extern "C" summary_obs_type *summary_obs_alloc(const char *summary_key,
                                                const char *obs_key,
                                                double value, double std);
 
+summary_obs_type *summary_obs_alloc_view(SummaryObsStore *store,
+                                         int report_step);
+void summary_obs_attach(summary_obs_type *summary_obs, SummaryObsStore *store,
+                        int report_step);
+bool summary_obs_is_view(const summary_obs_type *summary_obs);
+
 extern "C" double summary_obs_get_value(const summary_obs_type *summary_obs);
 extern "C" double summary_obs_get_std(const summary_obs_type *summary_obs);
 extern "C" double
@@ -27,10 +27,14 @@
 
 typedef struct trans_func_struct trans_func_type;
 typedef double(transform_ftype)(double, const double_vector_type *);
+typedef void(transform_many_ftype)(const double *, double *, size_t,
+                                   const double_vector_type *);
 typedef bool(validate_ftype)(const trans_func_type *);
 
 trans_func_type *trans_func_alloc(const stringlist_type *args);
 double trans_func_eval(const trans_func_type *trans_func, double x);
+void trans_func_eval_many(const trans_func_type *trans_func, const double *x,
+                          double *y, size_t n);
 
 void trans_func_free(trans_func_type *trans_func);
 bool trans_func_use_log_scale(const trans_func_type *trans_func);
@@ -38,6 +38,10 @@ void job_list_get_rdlock(job_list_type *list);
 void job_list_reader_wait(job_list_type *list, int usleep_time1,
                           int usleep_time2);
 void job_list_unlock(job_list_type *list);
+void job_list_notify(job_list_type *list);
+long job_list_get_generation(job_list_type *list);
+bool job_list_wait_for_change(job_list_type *list, long generation,
+                              int timeout_usec);
 
 UTIL_SAFE_CAST_HEADER(job_list);
 UTIL_IS_INSTANCE_HEADER(job_list);
@@ -19,7 +19,10 @@
 #ifndef ERT_JOB_NODE_H
 #define ERT_JOB_NODE_H
 
+#include <vector>
+
 #include <ert/job_queue/job_queue_status.hpp>
+#include <ert/job_queue/job_status_event.hpp>
 #include <ert/job_queue/queue_driver.hpp>
 #include <ert/util/type_macros.hpp>
 
@@ -43,6 +46,7 @@
 
 typedef bool(job_callback_ftype)(void *);
 typedef struct job_queue_node_struct job_queue_node_type;
+typedef struct job_list_struct job_list_type;
 
 time_t job_queue_node_get_timestamp(const job_queue_node_type *node);
 bool job_queue_node_status_transition(job_queue_node_type *node,
@@ -53,6 +57,9 @@ submit_status_type job_queue_node_submit(job_queue_node_type *node,
                                          queue_driver_type *driver);
 extern "C" PY_USED submit_status_type job_queue_node_submit_simple(
     job_queue_node_type *node, queue_driver_type *driver);
+int job_queue_node_submit_array(const std::vector<job_queue_node_type *> &nodes,
+                                job_queue_status_type *status,
+                                queue_driver_type *driver);
 void job_queue_node_free_error_info(job_queue_node_type *node);
 void job_queue_node_fscanf_EXIT(job_queue_node_type *node);
 void job_queue_node_free_data(job_queue_node_type *node);
@@ -112,6 +119,10 @@ extern "C" void job_queue_node_set_status(job_queue_node_type *node,
                                           job_status_type new_status);
 
 char *job_queue_node_get_name(job_queue_node_type *node);
+void job_queue_node_set_status_events(job_queue_node_type *node,
+                                      JobStatusEventRing *status_events);
+void job_queue_node_set_job_list(job_queue_node_type *node,
+                                 job_list_type *job_list);
 UTIL_IS_INSTANCE_HEADER(job_queue_node);
 UTIL_SAFE_CAST_HEADER(job_queue_node);
 
@@ -22,9 +22,13 @@
 #include <stdbool.h>
 #include <time.h>
 
+#include <vector>
+
 #include <ert/res_util/path_fmt.hpp>
+#include <ert/util/int_vector.h>
 
 #include <ert/job_queue/job_node.hpp>
+#include <ert/job_queue/job_status_event.hpp>
 #include <ert/job_queue/queue_driver.hpp>
 
 typedef struct job_queue_struct job_queue_type;
@@ -44,11 +48,24 @@ int job_queue_add_job(job_queue_type *, const char *run_cmd,
                       const char **argv);
 
 bool job_queue_accept_jobs(const job_queue_type *queue);
+extern "C" PY_USED int job_queue_submit_waiting_array(job_queue_type *queue,
+                                                   int max_jobs);
 
 void *job_queue_run_jobs__(void *);
 
 int job_queue_iget_status_summary(const job_queue_type *queue,
                                   job_status_type status);
+JobStatusEventRing *job_queue_get_status_events(job_queue_type *queue);
+std::size_t
+job_queue_drain_status_events(job_queue_type *queue,
+                              std::vector<job_status_event_type> &events);
+extern "C" PY_USED bool
+job_queue_drain_status_changes(job_queue_type *queue,
+                               int_vector_type *queue_index,
+                               int_vector_type *status);
+extern "C" PY_USED long job_queue_get_generation(job_queue_type *queue);
+extern "C" PY_USED bool job_queue_wait_for_change(job_queue_type *queue,
+                                                  long generation);
 
 extern "C" PY_USED void
 job_queue_set_max_job_duration(job_queue_type *queue, int max_duration_seconds);
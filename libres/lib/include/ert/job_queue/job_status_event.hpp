@@ -0,0 +1,57 @@
+#ifndef ERT_JOB_STATUS_EVENT_H
+#define ERT_JOB_STATUS_EVENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ert/job_queue/job_status.hpp>
+
+struct job_status_event_type {
+    int queue_index;
+    job_status_type old_status;
+    job_status_type new_status;
+    std::chrono::system_clock::time_point timestamp;
+};
+
+/**
+   Bounded lock-free queue of job status changes. Any number of threads can
+   push() events concurrently - typically the threads updating the status of
+   the job nodes - whereas only one thread at a time can consume the events
+   with pop() or drain().
+
+   The ring never blocks the producers: when it is full new events are
+   dropped, and the number of dropped events is available from dropped(). A
+   consumer which sees dropped events must fall back to reading the current
+   status of the nodes.
+*/
+class JobStatusEventRing {
+public:
+    /** The capacity is rounded up to the nearest power of two. */
+    explicit JobStatusEventRing(std::size_t capacity = 4096);
+
+    bool push(const job_status_event_type &event);
+    bool pop(job_status_event_type &event);
+    std::size_t drain(std::vector<job_status_event_type> &events);
+
+    std::size_t capacity() const { return m_mask + 1; }
+    std::size_t dropped() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct slot_type {
+        std::atomic<std::size_t> sequence;
+        job_status_event_type event;
+    };
+
+    std::size_t m_mask;
+    std::unique_ptr<slot_type[]> m_slots;
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::size_t m_tail = 0;
+    std::atomic<std::size_t> m_dropped{0};
+};
+
+#endif
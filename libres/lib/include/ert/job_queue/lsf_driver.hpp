@@ -67,6 +67,9 @@ stringlist_type *lsf_driver_alloc_cmd(lsf_driver_type *driver,
 void *lsf_driver_submit_job(void *__driver, const char *submit_cmd, int num_cpu,
                             const char *run_path, const char *job_name,
                             int argc, const char **argv);
+bool lsf_driver_submit_job_array(void *__driver, int num_jobs,
+                                 const queue_driver_array_job_type *jobs,
+                                 void **job_data);
 job_status_type lsf_driver_convert_status(int lsf_status);
 void lsf_driver_blacklist_node(void *__driver, void *__job);
 void lsf_driver_kill_job(void *__driver, void *__job);
@@ -51,6 +51,32 @@ typedef bool(set_option_ftype)(void *, const char *, const void *);
 typedef const void *(get_option_ftype)(const void *, const char *);
 typedef void(init_option_list_ftype)(stringlist_type *);
 
+/**
+   One element of a job array; the fields correspond to the arguments of
+   submit_job_ftype. All elements of an array are submitted with one call to
+   the scheduler, and element number i is started with the array index i (plus
+   a driver specific offset).
+*/
+typedef struct {
+    const char *cmd;
+    int num_cpu;
+    const char *run_path;
+    const char *job_name;
+    int argc;
+    const char **argv;
+} queue_driver_array_job_type;
+
+/**
+   Submit @num_jobs jobs as one job array. On success the driver stores one
+   job handle per element in @job_data - the handles are of the same type as
+   the ones returned from submit_job_ftype, so status, kill and free work
+   unchanged on the individual elements. Returns false if the array could not
+   be submitted, in which case @job_data is left untouched.
+*/
+typedef bool(submit_job_array_ftype)(void *data, int num_jobs,
+                                     const queue_driver_array_job_type *jobs,
+                                     void **job_data);
+
 queue_driver_type *queue_driver_alloc_RSH(const char *rsh_cmd,
                                           const hash_type *rsh_hostlist);
 queue_driver_type *queue_driver_alloc_LSF(const char *queue_name,
@@ -65,6 +91,17 @@ void *queue_driver_submit_job(queue_driver_type *driver, const char *run_cmd,
                               int num_cpu, const char *run_path,
                               const char *job_name, int argc,
                               const char **argv);
+extern "C" PY_USED bool
+queue_driver_supports_job_array(const queue_driver_type *driver);
+bool queue_driver_submit_job_array(queue_driver_type *driver, int num_jobs,
+                                   const queue_driver_array_job_type *jobs,
+                                   void **job_data);
+void queue_driver_write_array_script(const char *script_file,
+                                     const char *index_variable,
+                                     int index_offset, int num_jobs,
+                                     const queue_driver_array_job_type *jobs);
+int queue_driver_array_num_cpu(int num_jobs,
+                               const queue_driver_array_job_type *jobs);
 extern "C" void queue_driver_free_job(queue_driver_type *driver,
                                       void *job_data);
 void queue_driver_blacklist_node(queue_driver_type *driver, void *job_data);
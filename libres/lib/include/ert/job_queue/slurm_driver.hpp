@@ -24,6 +24,7 @@
 
 #include <ert/enkf/config_keys.hpp>
 #include <ert/job_queue/job_status.hpp>
+#include <ert/job_queue/queue_driver.hpp>
 
 /*
   The options supported by the Slurm driver; these string constants will be used
@@ -45,6 +46,9 @@ void slurm_driver_init_option_list(stringlist_type *option_list);
 void *slurm_driver_submit_job(void *__driver, const char *cmd, int num_cpu,
                               const char *run_path, const char *job_name,
                               int argc, const char **argv);
+bool slurm_driver_submit_job_array(void *__driver, int num_jobs,
+                                   const queue_driver_array_job_type *jobs,
+                                   void **job_data);
 job_status_type slurm_driver_get_job_status(void *__driver, void *__job);
 void slurm_driver_kill_job(void *__driver, void *__job);
 void slurm_driver_free_job(void *__job);
@@ -21,6 +21,7 @@
 #include <stdio.h>
 
 #include <ert/job_queue/queue_driver.hpp>
+#include <ert/util/hash.hpp>
 #include <ert/util/type_macros.hpp>
 
 /*
@@ -52,6 +53,9 @@ void *torque_driver_submit_job(void *__driver, const char *submit_cmd,
                                int num_cpu, const char *run_path,
                                const char *job_name, int argc,
                                const char **argv);
+bool torque_driver_submit_job_array(void *__driver, int num_jobs,
+                                    const queue_driver_array_job_type *jobs,
+                                    void **job_data);
 
 void torque_driver_kill_job(void *__driver, void *__job);
 void torque_driver_free__(void *__driver);
@@ -74,6 +78,8 @@ int torque_driver_get_submit_sleep(const torque_driver_type *driver);
 FILE *torque_driver_get_debug_stream(const torque_driver_type *driver);
 job_status_type torque_driver_parse_status(const char *qstat_file,
                                            const char *jobnr);
+void torque_driver_parse_array_status(const char *qstat_file,
+                                      hash_type *status);
 
 UTIL_SAFE_CAST_HEADER(torque_driver);
 
@@ -39,6 +39,11 @@ void block_fs_fwrite_buffer(block_fs_type *block_fs, const char *filename,
 void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
                                    const char *filename, buffer_type *buffer);
 bool block_fs_has_file(block_fs_type *block_fs, const char *filename);
+bool block_fs_is_empty(block_fs_type *block_fs);
+void block_fs_snapshot(block_fs_type *src,
+                       const std::filesystem::path &target_mount_file);
+bool block_fs_copy_file(block_fs_type *src, const char *src_filename,
+                        block_fs_type *target, const char *target_filename);
 
 UTIL_IS_INSTANCE_HEADER(block_fs);
 UTIL_SAFE_CAST_HEADER(block_fs);
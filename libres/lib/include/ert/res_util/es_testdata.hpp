@@ -20,12 +20,20 @@
 
 #include <Eigen/Dense>
 #include <ert/util/bool_vector.hpp>
+#include <random>
 #include <string>
 #include <vector>
 
 namespace res {
 class es_testdata {
 public:
+    /**
+      The matrices are stored either as whitespace separated text, or in a
+      binary format which is lossless, checksummed and much faster to load.
+      Loading detects the format of each matrix file.
+    */
+    enum class format { text, binary };
+
     std::string path;
 
     Eigen::MatrixXd S{};
@@ -44,11 +52,16 @@ public:
                 const Eigen::MatrixXd &dObs);
     es_testdata(const char *path);
 
+    static es_testdata random(int ens_size, int obs_size, unsigned int seed);
+    static Eigen::MatrixXd random_matrix(int rows, int columns,
+                                         std::mt19937 &generator);
+
     Eigen::MatrixXd make_matrix(const std::string &name, int rows,
                                 int columns) const;
-    void save_matrix(const std::string &name, const Eigen::MatrixXd &m) const;
+    void save_matrix(const std::string &name, const Eigen::MatrixXd &m,
+                     format fmt = format::text) const;
     Eigen::MatrixXd make_state(const std::string &name) const;
-    void save(const std::string &path) const;
+    void save(const std::string &path, format fmt = format::text) const;
     void deactivate_obs(int iobs);
     void deactivate_realization(int iens);
 };
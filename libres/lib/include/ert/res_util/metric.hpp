@@ -1,5 +1,11 @@
+#ifndef ERT_METRIC_H
+#define ERT_METRIC_H
+
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <ert/logging.hpp>
 
@@ -24,4 +30,76 @@ private:
 };
 
 } // namespace utils
+
+/**
+   Process wide counters and timers for the hot paths.
+
+   The metrics are accumulated in thread local storage, so updating them is
+   a couple of uncontended memory writes, and only snapshot() has to visit
+   all the threads. Metrics are typically defined as function local
+   statics:
+
+       static const ert::metrics::Timer read_timer("block_fs.read");
+       auto timing = read_timer.time();
+*/
+namespace metrics {
+enum class metric_kind { counter, timer };
+
+/**
+   The upper bound, in nanoseconds, of the latency histogram bucket
+   @bucket; the last bucket has no upper bound. Bucket 0 holds everything
+   below one microsecond and every following bucket doubles the bound.
+*/
+constexpr int histogram_buckets = 32;
+std::uint64_t histogram_upper_bound(int bucket);
+
+struct metric_snapshot {
+    std::string name;
+    metric_kind kind;
+    /** The number of add() or record() calls */
+    std::uint64_t count;
+    /** The sum of the added values, or the total time in nanoseconds */
+    std::uint64_t total;
+    /** The latency histogram of timers, empty for counters */
+    std::vector<std::uint64_t> histogram;
+};
+
+class Counter {
+public:
+    explicit Counter(const std::string &name);
+    void add(std::uint64_t value = 1) const;
+
+private:
+    int m_id;
+};
+
+class Timer {
+public:
+    /** Records the time from construction to destruction in the timer. */
+    class Scope {
+    public:
+        explicit Scope(const Timer &timer) : m_timer(timer) {}
+        Scope(const Scope &) = delete;
+        ~Scope() { m_timer.record(clock::now() - m_start); }
+
+    private:
+        using clock = std::chrono::steady_clock;
+        const Timer &m_timer;
+        clock::time_point m_start = clock::now();
+    };
+
+    explicit Timer(const std::string &name);
+    void record(std::chrono::nanoseconds duration) const;
+    Scope time() const { return Scope(*this); }
+
+private:
+    int m_id;
+};
+
+/** The values of all the registered metrics since the last reset(). */
+std::vector<metric_snapshot> snapshot();
+void reset();
+} // namespace metrics
 } // namespace ert
+
+#endif
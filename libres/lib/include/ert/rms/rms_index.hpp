@@ -0,0 +1,43 @@
+#ifndef ERT_RMS_INDEX_H
+#define ERT_RMS_INDEX_H
+
+#include <string>
+
+#include <ert/rms/rms_type.hpp>
+
+/**
+   Random access to the arrays of a ROFF file.
+
+   rms_index_alloc() makes one pass over the file, reading only the tag
+   and key headers, and records where the values of every key start. A
+   single key can then be read straight into a buffer owned by the caller,
+   without loading any of the other tags. Both binary and ASCII ROFF files
+   are supported.
+*/
+typedef struct rms_index_struct rms_index_type;
+
+typedef struct {
+    /** The name of the tag, e.g. "parameter" */
+    std::string tag;
+    /** The value of the "name" key of the tag, empty if it has none */
+    std::string name;
+    /** The name of the key within the tag, e.g. "data" */
+    std::string key;
+    rms_type_enum rms_type;
+    /** The number of values */
+    int size;
+    /** The file offset of the first value */
+    long offset;
+} rms_index_entry_type;
+
+rms_index_type *rms_index_alloc(const char *filename);
+void rms_index_free(rms_index_type *index);
+bool rms_index_is_ascii(const rms_index_type *index);
+const rms_index_entry_type *rms_index_find(const rms_index_type *index,
+                                           const char *tag, const char *name,
+                                           const char *key);
+void rms_index_fread(const rms_index_type *index,
+                     const rms_index_entry_type *entry,
+                     rms_type_enum target_type, void *data);
+
+#endif
@@ -16,9 +16,11 @@
    for more details.
 */
 
+#include <errno.h>
 #include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <ert/util/util.hpp>
@@ -34,6 +36,11 @@ struct job_list_struct {
     int alloc_size;
     job_queue_node_type **jobs;
     pthread_rwlock_t lock;
+    /** Protects the generation counter; the condition is signalled when it
+        is incremented */
+    pthread_mutex_t change_mutex;
+    pthread_cond_t change_cond;
+    long generation;
 };
 
 UTIL_IS_INSTANCE_FUNCTION(job_list, JOB_LIST_TYPE_ID)
@@ -46,6 +53,17 @@ job_list_type *job_list_alloc() {
     job_list->alloc_size = 0;
     job_list->jobs = NULL;
     pthread_rwlock_init(&job_list->lock, NULL);
+    pthread_mutex_init(&job_list->change_mutex, NULL);
+    {
+        // The deadline of job_list_wait_for_change() is on the monotonic
+        // clock, so that changes of the wall clock do not affect the wait.
+        pthread_condattr_t cond_attr;
+        pthread_condattr_init(&cond_attr);
+        pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&job_list->change_cond, &cond_attr);
+        pthread_condattr_destroy(&cond_attr);
+    }
+    job_list->generation = 0;
     return job_list;
 }
 
@@ -57,6 +75,7 @@ void job_list_reset(job_list_type *job_list) {
         job_list->jobs[queue_index] = NULL;
     }
     job_list->active_size = 0;
+    job_list_notify(job_list);
 }
 
 int job_list_get_size(const job_list_type *job_list) {
@@ -77,9 +96,11 @@ void job_list_add_job(job_list_type *job_list, job_queue_node_type *job_node) {
     {
         int queue_index = job_list_get_size(job_list);
         job_queue_node_set_queue_index(job_node, queue_index);
+        job_queue_node_set_job_list(job_node, job_list);
         job_list->jobs[queue_index] = job_node;
     }
     job_list->active_size++;
+    job_list_notify(job_list);
 }
 
 job_queue_node_type *job_list_iget_job(const job_list_type *job_list,
@@ -98,6 +119,9 @@ void job_list_free(job_list_type *job_list) {
         job_list_reset(job_list);
         free(job_list->jobs);
     }
+    pthread_rwlock_destroy(&job_list->lock);
+    pthread_mutex_destroy(&job_list->change_mutex);
+    pthread_cond_destroy(&job_list->change_cond);
     free(job_list);
 }
 
@@ -113,13 +137,63 @@ void job_list_unlock(job_list_type *list) {
     pthread_rwlock_unlock(&list->lock);
 }
 
+/**
+   Every change of the list - jobs added or removed, and status changes of
+   the jobs in the list - increments the generation of the list and wakes
+   up the threads waiting in job_list_wait_for_change(). A thread which
+   wants to react on changes reads the generation, inspects the list and
+   then waits for the generation to move past the value it read; changes
+   which happen in between are therefore never lost.
+*/
+void job_list_notify(job_list_type *list) {
+    pthread_mutex_lock(&list->change_mutex);
+    list->generation++;
+    pthread_cond_broadcast(&list->change_cond);
+    pthread_mutex_unlock(&list->change_mutex);
+}
+
+long job_list_get_generation(job_list_type *list) {
+    pthread_mutex_lock(&list->change_mutex);
+    long generation = list->generation;
+    pthread_mutex_unlock(&list->change_mutex);
+    return generation;
+}
+
+/**
+   Waits until the generation of the list differs from @generation, or at
+   most @timeout_usec microseconds. Returns true if the list has changed.
+*/
+bool job_list_wait_for_change(job_list_type *list, long generation,
+                              int timeout_usec) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long nsec = now.tv_nsec + ((long)timeout_usec % 1000000) * 1000;
+    struct timespec deadline;
+    deadline.tv_sec = now.tv_sec + timeout_usec / 1000000 + nsec / 1000000000;
+    deadline.tv_nsec = nsec % 1000000000;
+
+    pthread_mutex_lock(&list->change_mutex);
+    while (list->generation == generation)
+        if (pthread_cond_timedwait(&list->change_cond, &list->change_mutex,
+                                   &deadline) == ETIMEDOUT)
+            break;
+    bool changed = list->generation != generation;
+    pthread_mutex_unlock(&list->change_mutex);
+    return changed;
+}
+
+/**
+   Waits for a change of the list; for at most @usleep_time1 microseconds
+   if no writer holds the lock, otherwise for at most @usleep_time2
+   microseconds to let more writers get access.
+*/
 void job_list_reader_wait(job_list_type *list, int usleep_time1,
                           int usleep_time2) {
+    long generation = job_list_get_generation(list);
+    int timeout_usec = usleep_time2;
     if (pthread_rwlock_tryrdlock(&list->lock) == 0) {
-        // Seems to be no writers waiting - take a short sleep and return.
         pthread_rwlock_unlock(&list->lock);
-        usleep(usleep_time1);
-    } else
-        // A writer already has the lock - let more writers get access; sleep longer.
-        usleep(usleep_time2);
+        timeout_usec = usleep_time1;
+    }
+    job_list_wait_for_change(list, generation, timeout_usec);
 }
@@ -16,8 +16,10 @@
    for more details.
 */
 
+#include <chrono>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 #include <pthread.h>
 #include <stdbool.h>
@@ -27,6 +29,7 @@
 #include <ert/logging.hpp>
 #include <ert/util/util.hpp>
 
+#include <ert/job_queue/job_list.hpp>
 #include <ert/job_queue/job_node.hpp>
 
 namespace fs = std::filesystem;
@@ -93,6 +96,11 @@ struct job_queue_node_struct {
     time_t max_confirm_wait;
     /** Timestamp of the status update update file. */
     time_t progress_timestamp;
+    /** Status changes are published here when the node is part of a
+     * job_queue; owned by the job_queue. */
+    JobStatusEventRing *status_events;
+    /** The job_list holding the node, notified on status changes. */
+    job_list_type *job_list;
 };
 
 void job_queue_node_free_error_info(job_queue_node_type *node) {
@@ -321,6 +329,8 @@ job_queue_node_alloc(const char *job_name, const char *run_path,
     node->sim_end = 0;
     node->submit_time = time(NULL);
     node->max_confirm_wait = 60 * 2; // 2 minutes before we consider job dead.
+    node->status_events = NULL;
+    node->job_list = NULL;
 
     pthread_mutex_init(&node->data_mutex, NULL);
     return node;
@@ -374,7 +384,13 @@ void job_queue_node_set_status(job_queue_node_type *node,
 
     logger->debug("Set {}({}) to {}", node->job_name, node->queue_index,
                   job_status_get_name(new_status));
+    if (node->status_events)
+        node->status_events->push({node->queue_index, node->job_status,
+                                   new_status,
+                                   std::chrono::system_clock::now()});
     node->job_status = new_status;
+    if (node->job_list)
+        job_list_notify(node->job_list);
 
     // We record sim start when the node is in state JOB_QUEUE_WAITING to be
     // sure that we do not miss the start time completely for very fast jobs
@@ -480,6 +496,55 @@ submit_status_type job_queue_node_submit_simple(job_queue_node_type *node,
     return submit_status;
 }
 
+/**
+   Submit all the @nodes as one job array. The nodes are locked while the
+   array is submitted, element number i in the array is nodes[i] - i.e. the
+   mapping from array index to queue index is given by the order of @nodes,
+   and is retained in the job_data of each node. Returns the number of nodes
+   which were submitted; that is either all or none of them.
+*/
+int job_queue_node_submit_array(const std::vector<job_queue_node_type *> &nodes,
+                                job_queue_status_type *status,
+                                queue_driver_type *driver) {
+    if (nodes.empty())
+        return 0;
+
+    std::vector<queue_driver_array_job_type> jobs;
+    std::vector<void *> job_data(nodes.size(), nullptr);
+    for (auto *node : nodes) {
+        pthread_mutex_lock(&node->data_mutex);
+        jobs.push_back({node->run_cmd, node->num_cpu, node->run_path,
+                        node->job_name, node->argc,
+                        (const char **)node->argv});
+    }
+
+    int num_submitted = 0;
+    if (queue_driver_submit_job_array(driver, jobs.size(), jobs.data(),
+                                      job_data.data())) {
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            job_queue_node_type *node = nodes[i];
+            job_status_type old_status = node->job_status;
+
+            logger->info("Submitted job {} (attempt {}) as array element {}",
+                         node->job_name, node->submit_attempt, i);
+            node->job_data = job_data[i];
+            node->submit_attempt++;
+            job_queue_node_set_status(node, JOB_QUEUE_SUBMITTED);
+            if (status)
+                job_queue_status_transition(status, old_status,
+                                            JOB_QUEUE_SUBMITTED);
+        }
+        num_submitted = nodes.size();
+    } else
+        logger->warning("Failed to submit job array with {} jobs",
+                        nodes.size());
+
+    for (auto *node : nodes)
+        pthread_mutex_unlock(&node->data_mutex);
+
+    return num_submitted;
+}
+
 static bool
 job_queue_node_status_update_confirmed_running__(job_queue_node_type *node) {
     if (node->confirmed_running)
@@ -700,6 +765,16 @@ time_t job_queue_node_get_timestamp(const job_queue_node_type *node) {
     return node->progress_timestamp;
 }
 
+void job_queue_node_set_status_events(job_queue_node_type *node,
+                                      JobStatusEventRing *status_events) {
+    node->status_events = status_events;
+}
+
+void job_queue_node_set_job_list(job_queue_node_type *node,
+                                 job_list_type *job_list) {
+    node->job_list = job_list;
+}
+
 char *job_queue_node_get_name(job_queue_node_type *node) {
     return (node->job_name);
 }
@@ -232,13 +232,17 @@ struct job_queue_struct {
     int max_duration;
     /** A job is only allowed to run until this time. 0 = no time set, ignore stop_time */
     time_t progress_timestamp;
-    /** The sleep time before checking for updates. */
+    /** The longest time to wait for a change before polling the driver. */
     unsigned long usleep_time;
     /** This mutex is used to ensure that ONLY one thread is executing the job_queue_run_jobs(). */
     std::mutex run_mutex;
 
     /** This holds future results of currently running callbacks */
     std::vector<std::future<void>> active_callbacks;
+    /** All status changes of the nodes in this queue are published here. */
+    JobStatusEventRing *status_events;
+    /** The number of dropped status events seen by the last drain. */
+    std::size_t status_events_dropped;
 };
 
 /*
@@ -274,6 +278,60 @@ int job_queue_iget_status_summary(const job_queue_type *queue,
     return job_queue_status_get_count(queue->status, status);
 }
 
+/**
+   Consumers which want to react on status changes - instead of polling the
+   status counters above - can drain the status events of the queue. Only one
+   consumer can drain the events; events which did not fit in the ring are
+   dropped and counted, see JobStatusEventRing.
+*/
+JobStatusEventRing *job_queue_get_status_events(job_queue_type *queue) {
+    return queue->status_events;
+}
+
+std::size_t
+job_queue_drain_status_events(job_queue_type *queue,
+                              std::vector<job_status_event_type> &events) {
+    return queue->status_events->drain(events);
+}
+
+/**
+   Drain the status events of the queue into @queue_index and @status, one
+   element per event in the order of the changes. Returns false if events
+   have been dropped since the last drain, the consumer must then re-read
+   the status of all the nodes.
+*/
+bool job_queue_drain_status_changes(job_queue_type *queue,
+                                    int_vector_type *queue_index,
+                                    int_vector_type *status) {
+    std::vector<job_status_event_type> events;
+    job_queue_drain_status_events(queue, events);
+    for (const auto &event : events) {
+        int_vector_append(queue_index, event.queue_index);
+        int_vector_append(status, event.new_status);
+    }
+
+    std::size_t dropped = queue->status_events->dropped();
+    bool complete = dropped == queue->status_events_dropped;
+    queue->status_events_dropped = dropped;
+    return complete;
+}
+
+/**
+   The run loop should not sleep a fixed time between the rounds; instead it
+   reads the generation of the queue before a round and then waits with
+   job_queue_wait_for_change(). The wait returns as soon as a job is added
+   or changes status, and otherwise after usleep_time - the status of
+   submitted jobs is only found by polling the driver.
+*/
+long job_queue_get_generation(job_queue_type *queue) {
+    return job_list_get_generation(queue->job_list);
+}
+
+bool job_queue_wait_for_change(job_queue_type *queue, long generation) {
+    return job_list_wait_for_change(queue->job_list, generation,
+                                    queue->usleep_time);
+}
+
 int job_queue_get_num_running(const job_queue_type *queue) {
     return job_queue_iget_status_summary(queue, JOB_QUEUE_RUNNING);
 }
@@ -396,6 +454,7 @@ int job_queue_add_job(job_queue_type *queue, const char *run_cmd,
         if (node) {
             job_list_get_wrlock(queue->job_list);
             {
+                job_queue_node_set_status_events(node, queue->status_events);
                 job_list_add_job(queue->job_list, node);
                 queue_index = job_queue_node_get_queue_index(node);
                 job_queue_change_node_status(queue, node, JOB_QUEUE_WAITING);
@@ -441,6 +500,8 @@ job_queue_type *job_queue_alloc(int max_submit, const char *ok_file,
     queue->submit_complete = false;
     queue->job_list = job_list_alloc();
     queue->status = job_queue_status_alloc();
+    queue->status_events = new JobStatusEventRing();
+    queue->status_events_dropped = 0;
     queue->progress_timestamp = time(NULL);
 
     return queue;
@@ -481,6 +542,7 @@ void job_queue_free(job_queue_type *queue) {
     free(queue->status_file);
     job_list_free(queue->job_list);
     job_queue_status_free(queue->status);
+    delete queue->status_events;
     free(queue);
 }
 
@@ -496,9 +558,38 @@ char *job_queue_get_status_file(const job_queue_type *queue) {
     return queue->status_file;
 }
 
+/**
+   Submit the jobs which are currently WAITING as one job array; at most
+   @max_jobs jobs are submitted, @max_jobs <= 0 means no limit. The
+   submission is done with a read lock on the job list, the array elements
+   are numbered in increasing queue_index order. Returns the number of jobs
+   submitted.
+*/
+int job_queue_submit_waiting_array(job_queue_type *queue, int max_jobs) {
+    if (!job_queue_accept_jobs(queue))
+        return 0;
+
+    JobListReadLock rl(queue->job_list);
+    std::vector<job_queue_node_type *> nodes;
+    for (int queue_index = 0; queue_index < job_list_get_size(queue->job_list);
+         queue_index++) {
+        if (max_jobs > 0 && static_cast<int>(nodes.size()) >= max_jobs)
+            break;
+
+        job_queue_node_type *node =
+            job_list_iget_job(queue->job_list, queue_index);
+        if (job_queue_node_get_status(node) == JOB_QUEUE_WAITING &&
+            job_queue_node_get_submit_attempt(node) < queue->max_submit)
+            nodes.push_back(node);
+    }
+
+    return job_queue_node_submit_array(nodes, queue->status, queue->driver);
+}
+
 int job_queue_add_job_node(job_queue_type *queue, job_queue_node_type *node) {
     job_list_get_wrlock(queue->job_list);
 
+    job_queue_node_set_status_events(node, queue->status_events);
     job_list_add_job(queue->job_list, node);
     job_queue_change_node_status(queue, node, JOB_QUEUE_WAITING);
     int queue_index = job_queue_node_get_queue_index(node);
@@ -15,7 +15,7 @@
    See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
    for more details.
 */
-#include <pthread.h>
+#include <atomic>
 
 #include <ert/util/type_macros.hpp>
 
@@ -24,12 +24,16 @@
 
 #define JOB_QUEUE_STATUS_TYPE_ID 777620306
 
+/*
+  The counters are atomic, so that the status transitions of different job
+  nodes - which happen with only the node mutex held - do not contend on a
+  common lock.
+*/
 struct job_queue_status_struct {
     UTIL_TYPE_ID_DECLARATION;
-    int status_list[JOB_QUEUE_MAX_STATE];
-    pthread_rwlock_t rw_lock;
+    std::atomic<int> status_list[JOB_QUEUE_MAX_STATE];
     int status_index[JOB_QUEUE_MAX_STATE];
-    time_t timestamp;
+    std::atomic<time_t> timestamp;
 };
 
 static int STATUS_INDEX(const job_queue_status_type *status_count,
@@ -52,10 +56,8 @@ UTIL_IS_INSTANCE_FUNCTION(job_queue_status, JOB_QUEUE_STATUS_TYPE_ID)
 UTIL_SAFE_CAST_FUNCTION(job_queue_status, JOB_QUEUE_STATUS_TYPE_ID)
 
 job_queue_status_type *job_queue_status_alloc() {
-    job_queue_status_type *status =
-        (job_queue_status_type *)util_malloc(sizeof *status);
+    job_queue_status_type *status = new job_queue_status_type;
     UTIL_TYPE_ID_INIT(status, JOB_QUEUE_STATUS_TYPE_ID);
-    pthread_rwlock_init(&status->rw_lock, NULL);
     job_queue_status_clear(status);
     status->timestamp = time(NULL);
 
@@ -95,66 +97,51 @@ job_queue_status_type *job_queue_status_alloc() {
     return status;
 }
 
-void job_queue_status_free(job_queue_status_type *status) { free(status); }
+void job_queue_status_free(job_queue_status_type *status) { delete status; }
 
 void job_queue_status_clear(job_queue_status_type *status) {
     int index;
     for (index = 0; index < JOB_QUEUE_MAX_STATE; index++)
-        status->status_list[index] = 0;
+        status->status_list[index].store(0, std::memory_order_relaxed);
 }
 
 int job_queue_status_get_count(job_queue_status_type *status_count,
                                int job_status_mask) {
     int count = 0;
-    pthread_rwlock_rdlock(&status_count->rw_lock);
-    {
-        int index = 0;
-        int status = 1;
-
-        while (true) {
-            if ((status & job_status_mask) == status) {
-                job_status_mask -= status;
-                count += status_count->status_list[index];
-            }
-
-            if (job_status_mask == 0)
-                break;
-
-            index++;
-            status <<= 1;
-            if (index == JOB_QUEUE_MAX_STATE)
-                util_abort("%s: internal error: remaining unrecognized status "
-                           "value:%d \n",
-                           __func__, job_status_mask);
+    int index = 0;
+    int status = 1;
+
+    while (true) {
+        if ((status & job_status_mask) == status) {
+            job_status_mask -= status;
+            count += status_count->status_list[index].load(
+                std::memory_order_relaxed);
         }
+
+        if (job_status_mask == 0)
+            break;
+
+        index++;
+        status <<= 1;
+        if (index == JOB_QUEUE_MAX_STATE)
+            util_abort("%s: internal error: remaining unrecognized status "
+                       "value:%d \n",
+                       __func__, job_status_mask);
     }
-    pthread_rwlock_unlock(&status_count->rw_lock);
     return count;
 }
 
 void job_queue_status_inc(job_queue_status_type *status_count,
                           job_status_type status_type) {
     int index = STATUS_INDEX(status_count, status_type);
-
-    pthread_rwlock_wrlock(&status_count->rw_lock);
-    {
-        int count = status_count->status_list[index];
-        status_count->status_list[index] = count + 1;
-    }
-    status_count->timestamp = time(NULL);
-    pthread_rwlock_unlock(&status_count->rw_lock);
+    status_count->status_list[index].fetch_add(1, std::memory_order_relaxed);
+    status_count->timestamp.store(time(NULL), std::memory_order_relaxed);
 }
 
 static void job_queue_status_dec(job_queue_status_type *status_count,
                                  job_status_type status_type) {
     int index = STATUS_INDEX(status_count, status_type);
-
-    pthread_rwlock_wrlock(&status_count->rw_lock);
-    {
-        int count = status_count->status_list[index];
-        status_count->status_list[index] = count - 1;
-    }
-    pthread_rwlock_unlock(&status_count->rw_lock);
+    status_count->status_list[index].fetch_sub(1, std::memory_order_relaxed);
 }
 
 /*
@@ -181,6 +168,7 @@ bool job_queue_status_transition(job_queue_status_type *status_count,
 int job_queue_status_get_total_count(const job_queue_status_type *status) {
     int total_count = 0;
     for (int index = 0; index < JOB_QUEUE_MAX_STATE; index++)
-        total_count += status->status_list[index];
+        total_count +=
+            status->status_list[index].load(std::memory_order_relaxed);
     return total_count;
 }
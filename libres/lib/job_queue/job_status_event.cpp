@@ -0,0 +1,72 @@
+#include <ert/job_queue/job_status_event.hpp>
+
+/*
+  The ring is the bounded queue described by Dmitry Vyukov: every slot carries
+  a sequence number which tells whether the slot is ready to be written by the
+  producer claiming position pos (sequence == pos) or ready to be read by the
+  consumer at position pos (sequence == pos + 1). The producers claim a
+  position with a compare and swap on m_head; since there is only one consumer
+  the tail position is a plain variable.
+*/
+
+JobStatusEventRing::JobStatusEventRing(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+
+    m_mask = size - 1;
+    m_slots.reset(new slot_type[size]);
+    for (std::size_t i = 0; i < size; i++)
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool JobStatusEventRing::push(const job_status_event_type &event) {
+    std::size_t pos = m_head.load(std::memory_order_relaxed);
+    slot_type *slot;
+    while (true) {
+        slot = &m_slots[pos & m_mask];
+        std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) -
+                    static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else
+            pos = m_head.load(std::memory_order_relaxed);
+    }
+
+    slot->event = event;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool JobStatusEventRing::pop(job_status_event_type &event) {
+    slot_type *slot = &m_slots[m_tail & m_mask];
+    std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+    if (seq != m_tail + 1)
+        return false;
+
+    event = slot->event;
+    slot->sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+    m_tail++;
+    return true;
+}
+
+/**
+   Append all the currently available events to @events, and return the
+   number of events appended.
+*/
+std::size_t
+JobStatusEventRing::drain(std::vector<job_status_event_type> &events) {
+    std::size_t count = 0;
+    job_status_event_type event;
+    while (pop(event)) {
+        events.push_back(event);
+        count++;
+    }
+    return count;
+}
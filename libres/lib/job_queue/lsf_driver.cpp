@@ -157,6 +157,12 @@ struct lsf_driver_struct {
     /** A hash table of all jobs submitted by this ERT instance - to ensure
      * that we do not check status of old jobs in e.g. ZOMBIE status. */
     hash_type *my_jobs;
+    /** The job ids of the job arrays submitted by this ERT instance; the
+     * status of all elements in an array is fetched with one bjobs call. An
+     * array is removed when all its elements have finished. */
+    std::vector<std::string> my_arrays;
+    /** The final status of the elements of the removed job arrays. */
+    hash_type *finished_array_status;
     hash_type *status_map;
     /** The output of calling bjobs is cached in this table. */
     hash_type *bjobs_cache;
@@ -598,6 +604,82 @@ static int lsf_driver_get_status__(lsf_driver_type *driver, const char *status,
     }
 }
 
+/**
+  The default bjobs output lists all the elements of a job array with the same
+  job id, so the status of the array elements is instead fetched with:
+
+     bjobs -a -noheader -o "jobid jobindex stat" <array_id>
+
+  The status of each element is stored in the bjobs_cache with the key
+  "jobid[jobindex]", which is the lsf_jobnr_char of the array element. When all
+  the elements have finished their status is also stored in the
+  finished_array_status table, and true is returned.
+*/
+static bool lsf_driver_update_bjobs_array(lsf_driver_type *driver,
+                                          const char *array_id) {
+    std::vector<std::pair<std::string, int>> element_status;
+    char *tmp_file = (char *)util_alloc_tmp_file("/tmp", "enkf-bjobs", true);
+
+    if (driver->submit_method == LSF_SUBMIT_REMOTE_SHELL) {
+        char **argv = (char **)util_calloc(2, sizeof *argv);
+        argv[0] = driver->remote_lsf_server;
+        argv[1] = util_alloc_sprintf(
+            "%s -a -noheader -o 'jobid jobindex stat' %s", driver->bjobs_cmd,
+            array_id);
+        util_spawn_blocking(driver->rsh_cmd, 2, (const char **)argv, tmp_file,
+                            NULL);
+        free(argv[1]);
+        free(argv);
+    } else if (driver->submit_method == LSF_SUBMIT_LOCAL_SHELL) {
+        const char *argv[5] = {"-a", "-noheader", "-o", "jobid jobindex stat",
+                               array_id};
+        util_spawn_blocking(driver->bjobs_cmd, 5, argv, tmp_file, NULL);
+    }
+
+    {
+        char status[16];
+        FILE *stream = util_fopen(tmp_file, "r");
+        bool at_eof = false;
+        while (!at_eof) {
+            char *line = util_fscanf_alloc_line(stream, &at_eof);
+            if (line != NULL) {
+                int job_id_int;
+                int job_index;
+
+                if (sscanf(line, "%d %d %15s", &job_id_int, &job_index,
+                           status) == 3) {
+                    char *job_id = (char *)util_alloc_sprintf(
+                        "%d[%d]", job_id_int, job_index);
+                    int job_status =
+                        lsf_driver_get_status__(driver, status, job_id);
+                    hash_insert_int(driver->bjobs_cache, job_id, job_status);
+                    element_status.emplace_back(job_id, job_status);
+                    free(job_id);
+                }
+                free(line);
+            }
+        }
+        fclose(stream);
+    }
+    util_unlink_existing(tmp_file);
+    free(tmp_file);
+
+    bool finished =
+        !element_status.empty() &&
+        std::all_of(element_status.begin(), element_status.end(),
+                    [](const auto &element) {
+                        return element.second == JOB_STAT_DONE ||
+                               element.second == JOB_STAT_PDONE ||
+                               element.second == JOB_STAT_EXIT;
+                    });
+    if (finished) {
+        for (const auto &[job_id, job_status] : element_status)
+            hash_insert_int(driver->finished_array_status, job_id.c_str(),
+                            job_status);
+    }
+    return finished;
+}
+
 static void lsf_driver_update_bjobs_table(lsf_driver_type *driver) {
     char *tmp_file = (char *)util_alloc_tmp_file("/tmp", "enkf-bjobs", true);
 
@@ -647,6 +729,14 @@ static void lsf_driver_update_bjobs_table(lsf_driver_type *driver) {
     }
     util_unlink_existing(tmp_file);
     free(tmp_file);
+
+    auto &arrays = driver->my_arrays;
+    arrays.erase(std::remove_if(arrays.begin(), arrays.end(),
+                                [driver](const std::string &array_id) {
+                                    return lsf_driver_update_bjobs_array(
+                                        driver, array_id.c_str());
+                                }),
+                 arrays.end());
 }
 
 static int lsf_driver_get_job_status_libary(void *__driver, void *__job) {
@@ -812,6 +902,14 @@ static int lsf_driver_get_job_status_shell(void *__driver, void *__job) {
                     lsf_driver_update_bjobs_table(driver);
                     driver->last_bjobs_update = time(NULL);
                 }
+
+                if (!hash_has_key(driver->bjobs_cache, job->lsf_jobnr_char) &&
+                    hash_has_key(driver->finished_array_status,
+                                 job->lsf_jobnr_char))
+                    hash_insert_int(
+                        driver->bjobs_cache, job->lsf_jobnr_char,
+                        hash_get_int(driver->finished_array_status,
+                                     job->lsf_jobnr_char));
             }
             pthread_mutex_unlock(&driver->bjobs_mutex);
 
@@ -1057,6 +1155,93 @@ void *lsf_driver_submit_job(void *__driver, const char *submit_cmd, int num_cpu,
     }
 }
 
+/**
+  Submit all the jobs as one LSF job array with 'bsub -J "name[1-num_jobs]"'.
+  The submit script is written to the runpath of the first job, and selects
+  the job to run from the $LSB_JOBINDEX environment variable. Job arrays are
+  only supported with the shell based submit methods; with
+  LSF_SUBMIT_INTERNAL the jobs are submitted one at a time.
+*/
+bool lsf_driver_submit_job_array(void *__driver, int num_jobs,
+                                 const queue_driver_array_job_type *jobs,
+                                 void **job_data) {
+    lsf_driver_type *driver = lsf_driver_safe_cast(__driver);
+    lsf_driver_assert_submit_method(driver);
+
+    if (driver->submit_method == LSF_SUBMIT_INTERNAL) {
+        for (int i = 0; i < num_jobs; i++) {
+            const auto &job = jobs[i];
+            job_data[i] =
+                lsf_driver_submit_job(driver, job.cmd, job.num_cpu,
+                                      job.run_path, job.job_name, job.argc,
+                                      job.argv);
+            if (job_data[i] == NULL) {
+                for (int j = 0; j < i; j++) {
+                    lsf_driver_kill_job(driver, job_data[j]);
+                    lsf_driver_free_job(job_data[j]);
+                    job_data[j] = NULL;
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int num_cpu = queue_driver_array_num_cpu(num_jobs, jobs);
+    char *script_file =
+        (char *)util_alloc_filename(jobs[0].run_path, "lsf_array", "sh");
+    char *array_name;
+    if (driver->submit_method == LSF_SUBMIT_REMOTE_SHELL)
+        array_name =
+            util_alloc_sprintf("'%s[1-%d]'", jobs[0].job_name, num_jobs);
+    else
+        array_name = util_alloc_sprintf("%s[1-%d]", jobs[0].job_name, num_jobs);
+
+    queue_driver_write_array_script(script_file, "LSB_JOBINDEX", 1, num_jobs,
+                                    jobs);
+
+    usleep(driver->submit_sleep);
+    pthread_mutex_lock(&driver->submit_lock);
+    logger->info("LSF DRIVER submitting job array with {} elements \n",
+                 num_jobs);
+    long lsf_jobnr = lsf_driver_submit_shell_job(
+        driver, "/dev/null", array_name, script_file, num_cpu, 0, NULL);
+    pthread_mutex_unlock(&driver->submit_lock);
+
+    free(array_name);
+    free(script_file);
+
+    if (lsf_jobnr <= 0) {
+        logger->error("** ERROR ** Failed when submitting job array to LSF - "
+                      "will try again.");
+        driver->error_count++;
+        if (driver->error_count >= driver->max_error_count)
+            util_exit("Maximum number of submit errors exceeded - giving up\n");
+        return false;
+    }
+
+    pthread_mutex_lock(&driver->bjobs_mutex);
+    driver->my_arrays.push_back(std::to_string(lsf_jobnr));
+    pthread_mutex_unlock(&driver->bjobs_mutex);
+
+    for (int i = 0; i < num_jobs; i++) {
+        lsf_job_type *job = lsf_job_alloc(jobs[i].job_name);
+        job->lsf_jobnr = lsf_jobnr;
+        job->lsf_jobnr_char = util_alloc_sprintf("%ld[%d]", lsf_jobnr, i + 1);
+
+        char *json_file =
+            (char *)util_alloc_filename(jobs[i].run_path, LSF_JSON, NULL);
+        FILE *stream = util_fopen(json_file, "w");
+        fprintf(stream, "{\"job_id\" : %ld, \"array_index\" : %d}\n",
+                lsf_jobnr, i + 1);
+        fclose(stream);
+        free(json_file);
+
+        job_data[i] = job;
+    }
+    return true;
+}
+
 void lsf_driver_free(lsf_driver_type *driver) {
     free(driver->login_shell);
     free(driver->queue_name);
@@ -1072,6 +1257,7 @@ void lsf_driver_free(lsf_driver_type *driver) {
     hash_free(driver->status_map);
     hash_free(driver->bjobs_cache);
     hash_free(driver->my_jobs);
+    hash_free(driver->finished_array_status);
 
 #ifdef HAVE_LSF_LIBRARY
     if (driver->lsb != NULL)
@@ -1348,6 +1534,7 @@ static void lsf_driver_shell_init(lsf_driver_type *lsf_driver) {
     lsf_driver->last_bjobs_update = time(NULL);
     lsf_driver->bjobs_cache = hash_alloc();
     lsf_driver->my_jobs = hash_alloc();
+    lsf_driver->finished_array_status = hash_alloc();
     lsf_driver->status_map = hash_alloc();
     lsf_driver->bsub_cmd = NULL;
     lsf_driver->bjobs_cmd = NULL;
@@ -16,11 +16,16 @@
    for more details.
  */
 
+#include <string>
+
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #include <ert/util/util.hpp>
 
+#include <ert/res_util/metric.hpp>
+
 #include <ert/job_queue/local_driver.hpp>
 #include <ert/job_queue/lsf_driver.hpp>
 #include <ert/job_queue/queue_driver.hpp>
@@ -60,6 +65,9 @@ struct queue_driver_struct {
     /** Function pointers - pointing to low level functions in the
      * implementations of e.g. lsf_driver. */
     submit_job_ftype *submit;
+    /** Optional - drivers without job array support leave this as NULL, and
+     * the array elements are then submitted one by one. */
+    submit_job_array_ftype *submit_array;
     free_job_ftype *free_job;
     kill_job_ftype *kill_job;
     blacklist_node_ftype *blacklist_node;
@@ -202,6 +210,7 @@ static queue_driver_type *queue_driver_alloc_empty() {
     UTIL_TYPE_ID_INIT(driver, QUEUE_DRIVER_ID);
     driver->driver_type = NULL_DRIVER;
     driver->submit = NULL;
+    driver->submit_array = NULL;
     driver->get_status = NULL;
     driver->kill_job = NULL;
     driver->free_job = NULL;
@@ -231,6 +240,7 @@ static UTIL_SAFE_CAST_FUNCTION(queue_driver, QUEUE_DRIVER_ID)
     switch (type) {
     case LSF_DRIVER:
         driver->submit = lsf_driver_submit_job;
+        driver->submit_array = lsf_driver_submit_job_array;
         driver->get_status = lsf_driver_get_job_status;
         driver->blacklist_node = lsf_driver_blacklist_node;
         driver->kill_job = lsf_driver_kill_job;
@@ -266,6 +276,7 @@ static UTIL_SAFE_CAST_FUNCTION(queue_driver, QUEUE_DRIVER_ID)
         break;
     case TORQUE_DRIVER:
         driver->submit = torque_driver_submit_job;
+        driver->submit_array = torque_driver_submit_job_array;
         driver->get_status = torque_driver_get_job_status;
         driver->kill_job = torque_driver_kill_job;
         driver->free_job = torque_driver_free_job;
@@ -285,6 +296,7 @@ static UTIL_SAFE_CAST_FUNCTION(queue_driver, QUEUE_DRIVER_ID)
         driver->kill_job = slurm_driver_kill_job;
         driver->free_job = slurm_driver_free_job;
         driver->submit = slurm_driver_submit_job;
+        driver->submit_array = slurm_driver_submit_job_array;
         driver->get_status = slurm_driver_get_job_status;
         driver->data = slurm_driver_alloc();
         break;
@@ -372,11 +384,132 @@ void *queue_driver_submit_job(queue_driver_type *driver, const char *run_cmd,
                               int num_cpu, const char *run_path,
                               const char *job_name, int argc,
                               const char **argv) {
+    static const ert::metrics::Timer submit_timer("queue_driver.submit");
+    auto timing = submit_timer.time();
     return driver->submit(driver->data, run_cmd, num_cpu, run_path, job_name,
                           argc, argv);
 }
 
+bool queue_driver_supports_job_array(const queue_driver_type *driver) {
+    return (driver->submit_array != NULL);
+}
+
+/**
+   Submit all the jobs in @jobs as one job array. For drivers without job
+   array support the jobs are submitted one at a time; if one of those submits
+   fails the jobs which were already submitted are killed again, so that the
+   array is either submitted in full or not at all.
+*/
+bool queue_driver_submit_job_array(queue_driver_type *driver, int num_jobs,
+                                   const queue_driver_array_job_type *jobs,
+                                   void **job_data) {
+    if (num_jobs == 0)
+        return true;
+
+    if (driver->submit_array)
+        return driver->submit_array(driver->data, num_jobs, jobs, job_data);
+
+    for (int i = 0; i < num_jobs; i++) {
+        const auto &job = jobs[i];
+        job_data[i] =
+            queue_driver_submit_job(driver, job.cmd, job.num_cpu, job.run_path,
+                                    job.job_name, job.argc, job.argv);
+        if (job_data[i] == NULL) {
+            for (int j = 0; j < i; j++) {
+                queue_driver_kill_job(driver, job_data[j]);
+                queue_driver_free_job(driver, job_data[j]);
+                job_data[j] = NULL;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+   All elements in a job array share the same resource request; we ask for
+   the largest number of cpus any of the elements need.
+*/
+int queue_driver_array_num_cpu(int num_jobs,
+                               const queue_driver_array_job_type *jobs) {
+    int num_cpu = 1;
+    for (int i = 0; i < num_jobs; i++)
+        num_cpu = util_int_max(num_cpu, jobs[i].num_cpu);
+    return num_cpu;
+}
+
+/**
+   Quote @value as one single quoted shell word; a single quote in @value is
+   written as '\''.
+*/
+static std::string queue_driver_shell_quote(const char *value) {
+    std::string quoted = "'";
+    for (const char *c = value; *c; c++) {
+        if (*c == '\'')
+            quoted += "'\\''";
+        else
+            quoted += *c;
+    }
+    quoted += "'";
+    return quoted;
+}
+
+/**
+   Write the shell script which is submitted as a job array. The scheduler
+   starts the same script for every element, and the script uses the array
+   index found in the environment variable @index_variable to select which
+   job to run:
+
+      #!/bin/sh
+      case "$SLURM_ARRAY_TASK_ID" in
+      0)
+         cd '/path/to/realization-0' || exit 1
+         exec 'job_dispatch.py' '/path/to/realization-0' > 'name-0'.stdout \
+                                                         2> 'name-0'.stderr
+         ;;
+      1)
+         ....
+      esac
+
+   The array index of element i is (i + @index_offset); LSF numbers the
+   array elements from 1, whereas Slurm and Torque start at 0. All the paths,
+   commands and arguments are quoted, so they can contain any character.
+*/
+void queue_driver_write_array_script(const char *script_file,
+                                     const char *index_variable,
+                                     int index_offset, int num_jobs,
+                                     const queue_driver_array_job_type *jobs) {
+    FILE *stream = util_fopen(script_file, "w");
+    fprintf(stream, "#!/bin/sh\n");
+    fprintf(stream, "case \"$%s\" in\n", index_variable);
+    for (int i = 0; i < num_jobs; i++) {
+        const auto &job = jobs[i];
+        fprintf(stream, "%d)\n", i + index_offset);
+        std::string job_name = queue_driver_shell_quote(job.job_name);
+        fprintf(stream, "   cd %s || exit 1\n",
+                queue_driver_shell_quote(job.run_path).c_str());
+        fprintf(stream, "   exec %s",
+                queue_driver_shell_quote(job.cmd).c_str());
+        for (int iarg = 0; iarg < job.argc; iarg++)
+            fprintf(stream, " %s",
+                    queue_driver_shell_quote(job.argv[iarg]).c_str());
+        fprintf(stream, " > %s.stdout 2> %s.stderr\n", job_name.c_str(),
+                job_name.c_str());
+        fprintf(stream, "   ;;\n");
+    }
+    fprintf(stream, "*)\n");
+    fprintf(stream, "   echo \"Unknown array index: $%s\" 1>&2\n",
+            index_variable);
+    fprintf(stream, "   exit 1\n");
+    fprintf(stream, "   ;;\n");
+    fprintf(stream, "esac\n");
+    fclose(stream);
+    chmod(script_file, S_IRWXU + S_IRGRP + S_IXGRP + S_IROTH + S_IXOTH);
+}
+
 void queue_driver_free_job(queue_driver_type *driver, void *job_data) {
+    static const ert::metrics::Timer free_timer("queue_driver.free_job");
+    auto timing = free_timer.time();
     driver->free_job(job_data);
 }
 
@@ -386,11 +519,15 @@ void queue_driver_blacklist_node(queue_driver_type *driver, void *job_data) {
 }
 
 void queue_driver_kill_job(queue_driver_type *driver, void *job_data) {
+    static const ert::metrics::Timer kill_timer("queue_driver.kill_job");
+    auto timing = kill_timer.time();
     driver->kill_job(driver->data, job_data);
 }
 
 job_status_type queue_driver_get_status(queue_driver_type *driver,
                                         void *job_data) {
+    static const ert::metrics::Timer status_timer("queue_driver.get_status");
+    auto timing = status_timer.time();
     job_status_type status = driver->get_status(driver->data, job_data);
     return status;
 }
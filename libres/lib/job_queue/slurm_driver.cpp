@@ -42,8 +42,16 @@
 
 static auto logger = ert::get_logger("job_queue.slurm_driver");
 
+/**
+  The string_id is the id used when talking to slurm, i.e. the argument to
+  scancel and scontrol and the id listed by squeue. For an element in a job
+  array the string_id is "<array_job_id>_<array_index>".
+*/
 struct SlurmJob {
     SlurmJob(int job_id) : job_id(job_id), string_id(std::to_string(job_id)) {}
+    SlurmJob(int job_id, int array_index)
+        : job_id(job_id), string_id(std::to_string(job_id) + "_" +
+                                    std::to_string(array_index)) {}
 
     int job_id;
     std::string string_id;
@@ -51,13 +59,15 @@ struct SlurmJob {
 
 class SlurmStatus {
 public:
-    void update(int job_id, job_status_type status) {
+    void update(const std::string &job_id, job_status_type status) {
         pthread_rwlock_wrlock(&this->lock);
         this->jobs[job_id] = status;
         pthread_rwlock_unlock(&this->lock);
     }
 
-    void new_job(int job_id) { this->update(job_id, JOB_QUEUE_PENDING); }
+    void new_job(const std::string &job_id) {
+        this->update(job_id, JOB_QUEUE_PENDING);
+    }
 
     static bool active_status(job_status_type status) {
         if (status == JOB_QUEUE_RUNNING)
@@ -86,9 +96,9 @@ public:
         active, but are not fallen out. Calling scope must update their status
         with calls to scontrol.
     */
-    std::vector<int>
-    squeue_update(const std::unordered_map<int, job_status_type> &squeue_jobs) {
-        std::vector<int> active_jobs;
+    std::vector<std::string> squeue_update(
+        const std::unordered_map<std::string, job_status_type> &squeue_jobs) {
+        std::vector<std::string> active_jobs;
 
         pthread_rwlock_wrlock(&this->lock);
         for (auto &job_pair : this->jobs) {
@@ -107,7 +117,7 @@ public:
         return active_jobs;
     }
 
-    job_status_type get(int job_id) const {
+    job_status_type get(const std::string &job_id) const {
 
         pthread_rwlock_rdlock(&this->lock);
         auto status = this->jobs.at(job_id);
@@ -117,7 +127,7 @@ public:
     }
 
 private:
-    std::unordered_map<int, job_status_type> jobs;
+    std::unordered_map<std::string, job_status_type> jobs;
     mutable pthread_rwlock_t lock = PTHREAD_RWLOCK_INITIALIZER;
 };
 
@@ -450,8 +460,71 @@ void *slurm_driver_submit_job(void *__driver, const char *cmd, int num_cpu,
         return nullptr;
     }
 
-    driver->status.new_job(job_id);
-    return new SlurmJob(job_id);
+    auto job = new SlurmJob(job_id);
+    driver->status.new_job(job->string_id);
+    return job;
+}
+
+/**
+ All the elements of a job array are submitted with one sbatch call; the
+ submit script written by queue_driver_write_array_script() selects the job to
+ run based on the $SLURM_ARRAY_TASK_ID environment variable. The squeue
+ command is invoked with --array so that it lists one line per array element,
+ i.e. the status of all elements is updated by the same squeue call as the
+ ordinary jobs.
+*/
+bool slurm_driver_submit_job_array(void *__driver, int num_jobs,
+                                   const queue_driver_array_job_type *jobs,
+                                   void **job_data) {
+    slurm_driver_type *driver = slurm_driver_safe_cast(__driver);
+    char *submit = (char *)util_alloc_tmp_file("/tmp", "slurm-submit", true);
+    std::string submit_script = submit;
+    free(submit);
+
+    queue_driver_write_array_script(submit_script.c_str(),
+                                    "SLURM_ARRAY_TASK_ID", 0, num_jobs, jobs);
+
+    int num_cpu = queue_driver_array_num_cpu(num_jobs, jobs);
+    std::vector<std::string> sbatch_argv = {
+        "--workdir=" + std::string(jobs[0].run_path),
+        "--job-name=" + std::string(jobs[0].job_name),
+        "--array=0-" + std::to_string(num_jobs - 1),
+        "--ntasks=" + std::to_string(num_cpu),
+        "--output=/dev/null",
+        "--error=/dev/null",
+        "--parsable"};
+    if (!driver->partition.empty())
+        sbatch_argv.push_back("--partition=" + driver->partition);
+    if (driver->memory.size() > 0)
+        sbatch_argv.push_back("--mem=" + driver->memory);
+    if (driver->memory_per_cpu.size() > 0)
+        sbatch_argv.push_back("--mem-per-cpu=" + driver->memory_per_cpu);
+    if (driver->max_runtime.second != 0)
+        sbatch_argv.push_back("--time=" +
+                              std::to_string(driver->max_runtime.second));
+    if (!driver->exclude.first.empty())
+        sbatch_argv.push_back("--exclude=" + driver->exclude.second);
+    if (!driver->include.first.empty())
+        sbatch_argv.push_back("--nodelist=" + driver->include.second);
+    sbatch_argv.push_back(submit_script);
+
+    auto file_content = load_stdout(driver->sbatch_cmd.c_str(), sbatch_argv);
+    util_unlink_existing(submit_script.c_str());
+
+    int job_id;
+    try {
+        job_id = std::stoi(file_content);
+    } catch (std::invalid_argument &exc) {
+        return false;
+    }
+
+    logger->info("Submitted job array {} with {} elements", job_id, num_jobs);
+    for (int i = 0; i < num_jobs; i++) {
+        auto job = new SlurmJob(job_id, i);
+        driver->status.new_job(job->string_id);
+        job_data[i] = job;
+    }
+    return true;
 }
 
 static job_status_type
@@ -540,31 +613,25 @@ slurm_driver_get_job_status_scontrol(const slurm_driver_type *driver,
     return status;
 }
 
-static job_status_type
-slurm_driver_get_job_status_scontrol(const slurm_driver_type *driver,
-                                     int job_id) {
-    return slurm_driver_get_job_status_scontrol(driver, std::to_string(job_id));
-}
-
 static void slurm_driver_update_status_cache(const slurm_driver_type *driver) {
     driver->status_timestamp = time(nullptr);
     const std::string space = " \n";
     auto squeue_output =
         load_stdout(driver->squeue_cmd.c_str(),
-                    {"-h", "--user=" + driver->username, "--format=%i %T"});
+                    {"-h", "--array", "--user=" + driver->username,
+                     "--format=%i %T"});
     auto offset = squeue_output.find_first_not_of(space);
 
-    std::unordered_map<int, job_status_type> squeue_jobs;
+    std::unordered_map<std::string, job_status_type> squeue_jobs;
     while (offset != std::string::npos) {
         auto id_end = squeue_output.find_first_of(space, offset);
-        auto job_string = squeue_output.substr(offset, id_end - offset);
-        int job_id = std::stoi(squeue_output.substr(offset, id_end - offset));
+        auto job_id = squeue_output.substr(offset, id_end - offset);
 
         auto status_start = squeue_output.find_first_not_of(space, id_end + 1);
         auto status_end = squeue_output.find_first_of(space, status_start);
         auto status = slurm_driver_translate_status(
             squeue_output.substr(status_start, status_end - status_start),
-            std::to_string(job_id));
+            job_id);
 
         squeue_jobs.insert({job_id, status});
         offset = squeue_output.find_first_not_of(space, status_end);
@@ -599,7 +666,7 @@ job_status_type slurm_driver_get_job_status(void *__driver, void *__job) {
     if (update_cache)
         slurm_driver_update_status_cache(driver);
 
-    return driver->status.get(job->job_id);
+    return driver->status.get(job->string_id);
 }
 
 void slurm_driver_kill_job(void *__driver, void *__job) {
@@ -18,11 +18,13 @@
 
 #include <filesystem>
 
+#include <pthread.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 
 #include <ert/res_util/file_utils.hpp>
+#include <ert/util/hash.hpp>
 #include <ert/util/type_macros.hpp>
 #include <ert/util/util.hpp>
 
@@ -32,6 +34,8 @@ namespace fs = std::filesystem;
 
 #define TORQUE_DRIVER_TYPE_ID 34873653
 #define TORQUE_JOB_TYPE_ID 12312312
+#define TORQUE_ARRAY_STATUS_REFRESH_TIME 10
+#define TORQUE_ARRAY_STATUS_RETRY_TIME 2
 
 struct torque_driver_struct {
     UTIL_TYPE_ID_DECLARATION;
@@ -48,12 +52,27 @@ struct torque_driver_struct {
     char *cluster_label;
     int submit_sleep;
     FILE *debug_stream;
+
+    /** The status of all elements in the job arrays submitted by this driver
+     * is cached here, and refreshed with one 'qstat -t' call per array. An
+     * array is dropped from array_ids, and no longer queried, when all its
+     * elements are done; array_sizes holds the number of elements of each
+     * array in array_ids. The cache is shared by all the threads polling
+     * the job status, and protected by array_lock. */
+    stringlist_type *array_ids;
+    hash_type *array_sizes;
+    hash_type *array_status;
+    time_t array_status_timestamp;
+    pthread_mutex_t array_lock;
 };
 
 struct torque_job_struct {
     UTIL_TYPE_ID_DECLARATION;
     long int torque_jobnr;
+    /** For array elements this is "jobnr[index]". */
     char *torque_jobnr_char;
+    /** The id of the array - "jobnr[]" - or NULL for ordinary jobs. */
+    char *array_id;
 };
 
 UTIL_SAFE_CAST_FUNCTION(torque_driver, TORQUE_DRIVER_TYPE_ID);
@@ -78,6 +97,11 @@ void *torque_driver_alloc() {
     torque_driver->cluster_label = NULL;
     torque_driver->job_prefix = NULL;
     torque_driver->debug_stream = NULL;
+    torque_driver->array_ids = stringlist_alloc_new();
+    torque_driver->array_sizes = hash_alloc();
+    torque_driver->array_status = hash_alloc();
+    torque_driver->array_status_timestamp = 0;
+    pthread_mutex_init(&torque_driver->array_lock, NULL);
 
     torque_driver_set_option(torque_driver, TORQUE_QSUB_CMD,
                              TORQUE_DEFAULT_QSUB_CMD);
@@ -267,6 +291,7 @@ torque_job_type *torque_job_alloc() {
     torque_job_type *job;
     job = (torque_job_type *)util_malloc(sizeof *job);
     job->torque_jobnr_char = NULL;
+    job->array_id = NULL;
     job->torque_jobnr = 0;
     UTIL_TYPE_ID_INIT(job, TORQUE_JOB_TYPE_ID);
 
@@ -459,6 +484,7 @@ static int torque_driver_submit_shell_job(torque_driver_type *driver,
 void torque_job_free(torque_job_type *job) {
 
     free(job->torque_jobnr_char);
+    free(job->array_id);
     free(job);
 }
 
@@ -502,6 +528,128 @@ void *torque_driver_submit_job(void *__driver, const char *submit_cmd,
     }
 }
 
+static job_status_type torque_driver_translate_status(char status_char) {
+    switch (status_char) {
+    case 'R':
+        return JOB_QUEUE_RUNNING;
+    case 'E':
+        return JOB_QUEUE_DONE;
+    case 'C':
+        return JOB_QUEUE_DONE;
+    case 'H':
+        return JOB_QUEUE_PENDING;
+    case 'Q':
+        return JOB_QUEUE_PENDING;
+    default:
+        return JOB_QUEUE_STATUS_FAILURE;
+    }
+}
+
+/**
+   qsub prints the id of a job array as "jobnr[].server"; returns the jobnr,
+   or 0 if the id can not be parsed.
+*/
+static int torque_job_parse_qsub_array_stdout(const torque_driver_type *driver,
+                                              const char *stdout_file) {
+    int jobid = 0;
+    FILE *stream = util_fopen(stdout_file, "r");
+    char *jobid_string = util_fscanf_alloc_upto(stream, "[", false);
+    fclose(stream);
+
+    torque_debug(driver, "Torque array job ID string: '%s'", jobid_string);
+    if (jobid_string == NULL || !util_sscanf_int(jobid_string, &jobid))
+        jobid = 0;
+
+    free(jobid_string);
+    return jobid;
+}
+
+/**
+   Submit all the jobs as one job array with 'qsub -t 0-(num_jobs - 1)'. The
+   submit script is written to the runpath of the first job, and selects the
+   job to run from the $PBS_ARRAYID environment variable.
+*/
+bool torque_driver_submit_job_array(void *__driver, int num_jobs,
+                                    const queue_driver_array_job_type *jobs,
+                                    void **job_data) {
+    torque_driver_type *driver = torque_driver_safe_cast(__driver);
+    int num_cpu = queue_driver_array_num_cpu(num_jobs, jobs);
+    int p_units_from_driver = driver->num_cpus_per_node * driver->num_nodes;
+    if (num_cpu > p_units_from_driver)
+        util_abort("%s: Error in config, job's config requires %d "
+                   "processing units, but config says %s: %d, and %s: "
+                   "%d, which multiplied becomes: %d \n",
+                   __func__, num_cpu, TORQUE_NUM_CPUS_PER_NODE,
+                   driver->num_cpus_per_node, TORQUE_NUM_NODES,
+                   driver->num_nodes, p_units_from_driver);
+
+    usleep(driver->submit_sleep);
+    char *tmp_std_file =
+        (char *)util_alloc_tmp_file("/tmp", "enkf-submit-std", true);
+    char *script_filename =
+        (char *)util_alloc_filename(jobs[0].run_path, "qsub_array", "sh");
+    char *local_job_name = NULL;
+    if (driver->job_prefix)
+        local_job_name =
+            util_alloc_sprintf("%s%s", driver->job_prefix, jobs[0].job_name);
+    else
+        local_job_name = util_alloc_string_copy(jobs[0].job_name);
+
+    queue_driver_write_array_script(script_filename, "PBS_ARRAYID", 0,
+                                    num_jobs, jobs);
+    {
+        stringlist_type *remote_argv =
+            torque_driver_alloc_cmd(driver, local_job_name, script_filename);
+        char *array_range = util_alloc_sprintf("0-%d", num_jobs - 1);
+        int script_index = stringlist_get_size(remote_argv) - 1;
+        stringlist_insert_copy(remote_argv, script_index, "-t");
+        stringlist_insert_copy(remote_argv, script_index + 1, array_range);
+
+        char *joined_argv = stringlist_alloc_joined_string(remote_argv, " ");
+        torque_debug(driver, "Submit arguments: %s", joined_argv);
+        free(joined_argv);
+
+        char **argv = stringlist_alloc_char_ref(remote_argv);
+        int status = util_spawn_blocking(
+            driver->qsub_cmd, stringlist_get_size(remote_argv),
+            (const char **)argv, tmp_std_file, NULL);
+        if (status != 0)
+            torque_debug_spawn_status_info(driver, status);
+
+        free(argv);
+        free(array_range);
+        stringlist_free(remote_argv);
+    }
+
+    int jobnr = torque_job_parse_qsub_array_stdout(driver, tmp_std_file);
+    util_unlink_existing(tmp_std_file);
+    free(tmp_std_file);
+    free(script_filename);
+    free(local_job_name);
+
+    if (jobnr <= 0)
+        return false;
+
+    char *array_id = util_alloc_sprintf("%d[]", jobnr);
+    pthread_mutex_lock(&driver->array_lock);
+    stringlist_append_copy(driver->array_ids, array_id);
+    hash_insert_int(driver->array_sizes, array_id, num_jobs);
+    // The next status poll should see the new array.
+    driver->array_status_timestamp = 0;
+    pthread_mutex_unlock(&driver->array_lock);
+    for (int i = 0; i < num_jobs; i++) {
+        torque_job_type *job = torque_job_alloc();
+        job->torque_jobnr = jobnr;
+        job->torque_jobnr_char = util_alloc_sprintf("%d[%d]", jobnr, i);
+        job->array_id = util_alloc_string_copy(array_id);
+        torque_debug(driver, "Job:%s Id:%s", jobs[i].run_path,
+                     job->torque_jobnr_char);
+        job_data[i] = job;
+    }
+    free(array_id);
+    return true;
+}
+
 /**
    Will return NULL if "something" fails; that again will be
    translated to JOB_QUEUE_STATUS_FAILURE - which the queue layer will
@@ -565,31 +713,8 @@ job_status_type torque_driver_parse_status(const char *qstat_file,
                     char *job_id_as_char_ptr = util_alloc_substring_copy(
                         job_id_full_string, 0, dotPosition);
                     if (util_string_equal(job_id_as_char_ptr, jobnr_char)) {
-
-                        switch (string_status[0]) {
-                        case 'R':
-                            status = JOB_QUEUE_RUNNING;
-                            break;
-
-                        case 'E':
-                            status = JOB_QUEUE_DONE;
-                            break;
-
-                        case 'C':
-                            status = JOB_QUEUE_DONE;
-                            break;
-
-                        case 'H':
-                            status = JOB_QUEUE_PENDING;
-                            break;
-                        case 'Q':
-                            status = JOB_QUEUE_PENDING;
-                            break;
-
-                        default:
-                            break;
-                        }
-
+                        status = torque_driver_translate_status(
+                            string_status[0]);
                         free(job_id_as_char_ptr);
                     }
                 }
@@ -606,9 +731,133 @@ job_status_type torque_driver_parse_status(const char *qstat_file,
     return status;
 }
 
+/**
+   Parse the output from 'qstat -t jobnr[]', which has one line for each
+   element in the array, and insert the status of all the elements in the
+   @status table, with the element id "jobnr[index]" as key.
+*/
+void torque_driver_parse_array_status(const char *qstat_file,
+                                      hash_type *status) {
+    FILE *stream = util_fopen(qstat_file, "r");
+    bool at_eof = false;
+    util_fskip_lines(stream, 2);
+    while (!at_eof) {
+        char *line = util_fscanf_alloc_line(stream, &at_eof);
+        if (line) {
+            char job_id_full_string[64];
+            char string_status[2];
+
+            if (sscanf(line, "%63s %*s %*s %*s %1s %*s", job_id_full_string,
+                       string_status) == 2) {
+                char *dot_ptr = strchr(job_id_full_string, '.');
+                if (dot_ptr)
+                    *dot_ptr = '\0';
+
+                job_status_type job_status =
+                    torque_driver_translate_status(string_status[0]);
+                if (job_status != JOB_QUEUE_STATUS_FAILURE)
+                    hash_insert_int(status, job_id_full_string, job_status);
+            }
+            free(line);
+        }
+    }
+    fclose(stream);
+}
+
+/**
+   Query the status of all the elements of the job array @array_id, which has
+   @size elements. The previous status of the elements is forgotten first, so
+   that an element missing from the qstat output is reported as a failure.
+   Returns true if all the elements are done.
+*/
+static bool torque_driver_update_one_array_status(torque_driver_type *driver,
+                                                  const char *array_id,
+                                                  int size) {
+    int jobnr = atoi(array_id);
+    for (int index = 0; index < size; index++) {
+        char *element_id = util_alloc_sprintf("%d[%d]", jobnr, index);
+        if (hash_has_key(driver->array_status, element_id))
+            hash_del(driver->array_status, element_id);
+        free(element_id);
+    }
+
+    char *tmp_file = (char *)util_alloc_tmp_file("/tmp", "enkf-qstat", true);
+    const char *argv[2] = {"-t", array_id};
+    util_spawn_blocking(driver->qstat_cmd, 2, argv, tmp_file, NULL);
+    if (fs::exists(tmp_file)) {
+        torque_driver_parse_array_status(tmp_file, driver->array_status);
+        unlink(tmp_file);
+    } else
+        fprintf(stderr, "No such file: %s - reading qstat status failed \n",
+                tmp_file);
+    free(tmp_file);
+
+    bool finished = true;
+    for (int index = 0; index < size && finished; index++) {
+        char *element_id = util_alloc_sprintf("%d[%d]", jobnr, index);
+        finished = hash_has_key(driver->array_status, element_id) &&
+                   hash_get_int(driver->array_status, element_id) ==
+                       JOB_QUEUE_DONE;
+        free(element_id);
+    }
+    return finished;
+}
+
+/**
+   Refresh the status of all the arrays which still have elements running;
+   the final status of the elements of finished arrays stays in the cache.
+   Must be called with the array_lock held.
+*/
+static void torque_driver_update_array_status(torque_driver_type *driver) {
+    for (int i = stringlist_get_size(driver->array_ids) - 1; i >= 0; i--) {
+        const char *array_id = stringlist_iget(driver->array_ids, i);
+        int size = hash_get_int(driver->array_sizes, array_id);
+        if (torque_driver_update_one_array_status(driver, array_id, size)) {
+            torque_debug(driver, "Job array:%s finished", array_id);
+            hash_del(driver->array_sizes, array_id);
+            stringlist_idel(driver->array_ids, i);
+        }
+    }
+    driver->array_status_timestamp = time(NULL);
+}
+
+/**
+   The cache is refreshed every TORQUE_ARRAY_STATUS_REFRESH_TIME seconds; an
+   element which is not in the cache, e.g. because qstat does not list it
+   yet, only forces a refresh every TORQUE_ARRAY_STATUS_RETRY_TIME seconds.
+*/
+static job_status_type
+torque_driver_get_array_element_status(torque_driver_type *driver,
+                                       const torque_job_type *job) {
+    job_status_type status = JOB_QUEUE_STATUS_FAILURE;
+    pthread_mutex_lock(&driver->array_lock);
+    {
+        double age = difftime(time(NULL), driver->array_status_timestamp);
+        bool cached =
+            hash_has_key(driver->array_status, job->torque_jobnr_char);
+        if (age > TORQUE_ARRAY_STATUS_REFRESH_TIME ||
+            (!cached && age > TORQUE_ARRAY_STATUS_RETRY_TIME))
+            torque_driver_update_array_status(driver);
+
+        if (hash_has_key(driver->array_status, job->torque_jobnr_char))
+            status = (job_status_type)hash_get_int(driver->array_status,
+                                                   job->torque_jobnr_char);
+    }
+    pthread_mutex_unlock(&driver->array_lock);
+
+    if (status == JOB_QUEUE_STATUS_FAILURE)
+        fprintf(stderr,
+                "** Warning: failed to get job status for array element:%s\n",
+                job->torque_jobnr_char);
+    return status;
+}
+
 job_status_type torque_driver_get_job_status(void *__driver, void *__job) {
     torque_driver_type *driver = torque_driver_safe_cast(__driver);
     torque_job_type *job = torque_job_safe_cast(__job);
+    if (job->array_id)
+        return torque_driver_get_array_element_status(driver, job);
+
     return torque_driver_get_qstat_status(driver, job->torque_jobnr_char);
 }
 
@@ -628,6 +877,10 @@ void torque_driver_free(torque_driver_type *driver) {
     free(driver->qsub_cmd);
     free(driver->num_cpus_per_node_char);
     free(driver->num_nodes_char);
+    stringlist_free(driver->array_ids);
+    hash_free(driver->array_sizes);
+    hash_free(driver->array_status);
+    pthread_mutex_destroy(&driver->array_lock);
     if (driver->job_prefix)
         free(driver->job_prefix);
 
@@ -1,5 +1,14 @@
-#include <ert/enkf/enkf_plot_gen_kw.hpp>
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <ert/concurrency.hpp>
+#include <ert/enkf/enkf_config_node.hpp>
+#include <ert/enkf/enkf_node.hpp>
 #include <ert/enkf/ensemble_config.hpp>
+#include <ert/enkf/gen_kw.hpp>
+#include <ert/enkf/gen_kw_config.hpp>
 #include <ert/python.hpp>
 #include <math.h>
 #include <pybind11/numpy.h>
@@ -8,6 +17,76 @@
 
 static auto logger = ert::get_logger("enkf_fs");
 
+namespace {
+/** One requested key of the form [LOG10_]GROUP:KEYWORD */
+struct keyword_request {
+    /** Column of the key in the result */
+    int key_index;
+    /** Index of the keyword in the GEN_KW node, -1 if not found */
+    int keyword_index;
+    bool use_log_scale;
+};
+
+/**
+   Load the GEN_KW node once for each of the realizations in
+   [@begin, @end) and fill in all the requested keywords of that node. The
+   raw values are collected per keyword, so that each keyword is
+   transformed for all the realizations in one call.
+*/
+void load_gen_kw_realizations(const enkf_config_node_type *config_node,
+                              enkf_fs_type *fs,
+                              const std::vector<keyword_request> &requests,
+                              const std::vector<int> &realizations, int begin,
+                              int end, int key_count, double *data) {
+    const int size = end - begin;
+    std::vector<bool> loaded(size, false);
+    std::vector<std::vector<double>> values(requests.size(),
+                                            std::vector<double>(size, 0));
+
+    enkf_node_type *node = enkf_node_alloc(config_node);
+    for (int i = 0; i < size; i++) {
+        node_id_type node_id = {.report_step = 0,
+                                .iens = realizations[begin + i]};
+        if (!enkf_node_try_load(node, fs, node_id)) {
+            logger->warning("Could not load {} for realization {}",
+                            enkf_config_node_get_key(config_node),
+                            node_id.iens);
+            continue;
+        }
+
+        loaded[i] = true;
+        const auto *gen_kw = static_cast<const gen_kw_type *>(
+            enkf_node_value_ptr(node));
+        for (size_t r = 0; r < requests.size(); r++)
+            if (requests[r].keyword_index >= 0)
+                values[r][i] =
+                    gen_kw_data_iget(gen_kw, requests[r].keyword_index, false);
+    }
+    enkf_node_free(node);
+
+    const auto *gen_kw_config = static_cast<const gen_kw_config_type *>(
+        enkf_config_node_get_ref(config_node));
+    for (size_t r = 0; r < requests.size(); r++) {
+        const auto &request = requests[r];
+        if (request.keyword_index < 0)
+            continue;
+
+        auto &column = values[r];
+        gen_kw_config_transform_many(gen_kw_config, request.keyword_index,
+                                     column.data(), column.data(), size);
+        for (int i = 0; i < size; i++) {
+            if (!loaded[i])
+                continue;
+
+            auto value = column[i];
+            if (request.use_log_scale)
+                value = log10(value);
+            data[request.key_index + (begin + i) * key_count] = value;
+        }
+    }
+}
+} // namespace
+
 RES_LIB_SUBMODULE("enkf_fs_keyword_data", m) {
     m.def(
         "keyword_data_get_realizations",
@@ -25,8 +104,12 @@ RES_LIB_SUBMODULE("enkf_fs_keyword_data", m) {
             double *data = new double[size];
             std::fill_n(data, size, NAN);
 
+            // Group the requested keywords by GEN_KW node, so that each node
+            // is only loaded once per realization.
+            std::map<const enkf_config_node_type *,
+                     std::vector<keyword_request>>
+                node_requests;
             for (int key_index = 0; key_index < key_count; key_index++) {
-
                 auto key = keys.at(key_index);
                 std::string keyword = "";
                 auto split = key.find(":");
@@ -43,35 +126,45 @@ RES_LIB_SUBMODULE("enkf_fs_keyword_data", m) {
 
                 auto ensemble_config_node =
                     ensemble_config_get_node(ensemble_config, key.c_str());
-                auto ensemble_data =
-                    enkf_plot_gen_kw_alloc(ensemble_config_node);
-                enkf_plot_gen_kw_load(ensemble_data, enkf_fs, true, 0, NULL);
-
-                auto keyword_index =
-                    enkf_plot_gen_kw_get_keyword_index(ensemble_data, keyword);
-                for (int realization_index = 0;
-                     realization_index < realization_size;
-                     realization_index++) {
-                    int realization = realizations.at(realization_index);
-                    enkf_plot_gen_kw_vector_type *vector =
-                        enkf_plot_gen_kw_iget(ensemble_data, realization);
-
-                    auto vector_size = enkf_plot_gen_kw_vector_get_size(vector);
-                    if (keyword_index < vector_size) {
-                        auto value =
-                            enkf_plot_gen_kw_vector_iget(vector, keyword_index);
-                        if (use_log_scale) {
-                            value = log10(value);
-                        }
-                        data[key_index + realization_index * key_count] = value;
-                    } else {
-                        logger->warning("Index out of bounds. keyword_index={} "
-                                        "vector_size={}",
-                                        keyword_index, vector_size);
-                    }
+                if (enkf_config_node_get_impl_type(ensemble_config_node) !=
+                    GEN_KW) {
+                    logger->warning("{} is not a GEN_KW keyword", key);
+                    continue;
+                }
+
+                const auto *gen_kw_config =
+                    static_cast<const gen_kw_config_type *>(
+                        enkf_config_node_get_ref(ensemble_config_node));
+                int keyword_index =
+                    gen_kw_config_get_index(gen_kw_config, keyword.c_str());
+                if (keyword_index < 0)
+                    logger->warning("Unknown keyword {} in {}", keyword, key);
+
+                node_requests[ensemble_config_node].push_back(
+                    {key_index, keyword_index, use_log_scale});
+            }
+
+            if (realization_size > 0) {
+                // The loading threads do not need the GIL, but logging from
+                // them might.
+                py::gil_scoped_release release;
+
+                // The realizations are split in one block per thread, and
+                // every block loads each GEN_KW node into its own node.
+                const int block_count = std::clamp<int>(
+                    std::thread::hardware_concurrency(), 1, realization_size);
+                for (const auto &node_request : node_requests) {
+                    ert::parallel_for(block_count, [&](int block) {
+                        load_gen_kw_realizations(
+                            node_request.first, enkf_fs, node_request.second,
+                            realizations,
+                            block * realization_size / block_count,
+                            (block + 1) * realization_size / block_count,
+                            key_count, data);
+                    });
                 }
-                enkf_plot_gen_kw_free(ensemble_data);
             }
+
             py::capsule free_when_done(data, [](void *f) {
                 double *data = reinterpret_cast<double *>(f);
                 delete[] data;
@@ -1,9 +1,68 @@
+#include <algorithm>
+#include <thread>
+
+#include <ert/concurrency.hpp>
 #include <ert/enkf/enkf_main.hpp>
 #include <ert/python.hpp>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+namespace {
+/**
+   Worker for get_summary_data(): for the realizations [@begin, @end) loads
+   all the summary keys and writes the values straight into the row block of
+   that realization in @data.
+*/
+void load_summary_realizations(
+    const std::vector<const enkf_config_node_type *> &config_nodes,
+    enkf_fs_type *fs, const std::vector<int> &realizations, int time_map_size,
+    int begin, int end, double *data) {
+    const int summary_key_size = std::size(config_nodes);
+    state_map_type *state_map = enkf_fs_get_state_map(fs);
+    std::vector<enkf_node_type *> nodes;
+    for (auto config_node : config_nodes)
+        nodes.push_back(enkf_node_alloc(config_node));
+    double_vector_type *work = double_vector_alloc(0, 0);
+
+    for (int realization_index = begin; realization_index < end;
+         realization_index++) {
+        int iens = realizations[realization_index];
+        if (state_map_iget(state_map, iens) != STATE_HAS_DATA)
+            continue;
+
+        double *realization_data =
+            data + realization_index * time_map_size * summary_key_size;
+        for (int key_index = 0; key_index < summary_key_size; key_index++) {
+            enkf_node_type *node = nodes[key_index];
+            if (enkf_node_vector_storage(node)) {
+                if (!enkf_node_user_get_vector(node, fs, NULL, iens, work))
+                    continue;
+
+                int size =
+                    std::min(double_vector_size(work), time_map_size + 1);
+                for (int index = 1; index < size; index++)
+                    realization_data[(index - 1) * summary_key_size +
+                                     key_index] =
+                        double_vector_iget(work, index);
+            } else {
+                for (int index = 1; index <= time_map_size; index++) {
+                    node_id_type node_id = {.report_step = index, .iens = iens};
+                    double value;
+                    if (enkf_node_user_get(node, fs, NULL, node_id, &value))
+                        realization_data[(index - 1) * summary_key_size +
+                                         key_index] = value;
+                }
+            }
+        }
+    }
+
+    double_vector_free(work);
+    for (auto node : nodes)
+        enkf_node_free(node);
+}
+} // namespace
+
 RES_LIB_SUBMODULE("enkf_fs_summary_data", m) {
     m.def(
         "get_summary_data",
@@ -22,38 +81,24 @@ RES_LIB_SUBMODULE("enkf_fs_summary_data", m) {
             double *data = new double[size];
             std::fill_n(data, size, NAN);
 
-            int summary_key_index = 0;
-            for (const auto &key : summary_keys) {
-                auto ensemble_config_node =
-                    ensemble_config_get_node(ensemble_config, key.c_str());
-                auto ensemble_data = enkf_plot_data_alloc(ensemble_config_node);
+            std::vector<const enkf_config_node_type *> config_nodes;
+            for (const auto &key : summary_keys)
+                config_nodes.push_back(
+                    ensemble_config_get_node(ensemble_config, key.c_str()));
 
-                auto user_key = nullptr;
-                enkf_plot_data_load(ensemble_data, enkfs_fs, user_key);
+            if (realization_size > 0 && summary_key_size > 0) {
+                // The loading threads do not need the GIL, but logging from
+                // them might.
+                py::gil_scoped_release release;
 
-                int realization_index = 0;
-                for (const auto &realization_number : realizations) {
-                    enkf_plot_tvector_type *realization_vector =
-                        enkf_plot_data_iget(ensemble_data, realization_number);
-                    int realization_vector_size =
-                        enkf_plot_tvector_size(realization_vector);
-
-                    for (int index = 1; index < realization_vector_size;
-                         index++) {
-                        if (enkf_plot_tvector_iget_active(realization_vector,
-                                                          index)) {
-                            double value = enkf_plot_tvector_iget_value(
-                                realization_vector, index);
-                            data[realization_index *
-                                     (time_map_size * summary_key_size) +
-                                 (((index - 1) * summary_key_size) +
-                                  summary_key_index)] = value;
-                        }
-                    }
-                    realization_index++;
-                }
-                enkf_plot_data_free(ensemble_data);
-                summary_key_index++;
+                const int block_count = std::clamp<int>(
+                    std::thread::hardware_concurrency(), 1, realization_size);
+                ert::parallel_for(block_count, [&](int block) {
+                    load_summary_realizations(
+                        config_nodes, enkfs_fs, realizations, time_map_size,
+                        block * realization_size / block_count,
+                        (block + 1) * realization_size / block_count, data);
+                });
             }
 
             py::capsule free_when_done(data, [](void *f) {
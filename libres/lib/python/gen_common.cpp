@@ -0,0 +1,29 @@
+#include <cstdlib>
+#include <string>
+
+#include <ert/enkf/gen_common.hpp>
+#include <ert/python.hpp>
+
+namespace {
+int load_size(void *(*loader)(const char *, ecl_data_type, int *),
+              const std::string &file) {
+    int size = 0;
+    free(loader(file.c_str(), ECL_DOUBLE, &size));
+    return size;
+}
+} // namespace
+
+RES_LIB_SUBMODULE("gen_common", m) {
+    m.def(
+        "fscanf_load",
+        [](const std::string &file) {
+            return load_size(gen_common_fscanf_alloc, file);
+        },
+        py::arg("file"));
+    m.def(
+        "fparse_load",
+        [](const std::string &file) {
+            return load_size(gen_common_fparse_alloc, file);
+        },
+        py::arg("file"));
+}
@@ -0,0 +1,53 @@
+#include <ert/python.hpp>
+#include <ert/res_util/metric.hpp>
+
+namespace {
+/**
+   The metrics as a dict from name to a dict with the kind, the count and
+   the total. Timers give the total in seconds, and a histogram as a list of
+   (upper bound in seconds, count) pairs for the non-empty latency buckets,
+   where the upper bound of the last bucket is None.
+*/
+py::dict metrics_snapshot() {
+    std::vector<ert::metrics::metric_snapshot> metrics;
+    {
+        py::gil_scoped_release release;
+        metrics = ert::metrics::snapshot();
+    }
+
+    py::dict result;
+    for (const auto &metric : metrics) {
+        py::dict values;
+        values["count"] = metric.count;
+        if (metric.kind == ert::metrics::metric_kind::counter) {
+            values["kind"] = "counter";
+            values["total"] = metric.total;
+        } else {
+            values["kind"] = "timer";
+            values["seconds"] = metric.total * 1e-9;
+
+            py::list histogram;
+            for (size_t bucket = 0; bucket < metric.histogram.size();
+                 bucket++) {
+                if (metric.histogram[bucket] == 0)
+                    continue;
+
+                py::object upper_bound = py::none();
+                if (bucket + 1 < metric.histogram.size())
+                    upper_bound = py::float_(
+                        ert::metrics::histogram_upper_bound(bucket) * 1e-9);
+                histogram.append(
+                    py::make_tuple(upper_bound, metric.histogram[bucket]));
+            }
+            values["histogram"] = histogram;
+        }
+        result[py::str(metric.name)] = values;
+    }
+    return result;
+}
+} // namespace
+
+RES_LIB_SUBMODULE("metrics", m) {
+    m.def("snapshot", metrics_snapshot);
+    m.def("reset", ert::metrics::reset);
+}
@@ -0,0 +1,48 @@
+#include <string>
+
+#include <ert/enkf/node_codec.hpp>
+#include <ert/python.hpp>
+
+#include <pybind11/numpy.h>
+
+RES_LIB_SUBMODULE("node_codec", m) {
+    m.def(
+        "encode",
+        [](py::object object, const std::string &codec) {
+            // The codec works on the raw bytes, so strided and Fortran
+            // ordered arrays are encoded from a C-contiguous copy
+            auto array = py::array::ensure(object, py::array::c_style);
+            if (!array)
+                throw py::type_error("Can not encode a non-array");
+            node_codec_spec spec = node_codec_parse(codec);
+            buffer_type *buffer = buffer_alloc(array.nbytes() + 64);
+            {
+                py::gil_scoped_release release;
+                node_codec_fwrite(buffer, spec, array.data(), array.itemsize(),
+                                  array.nbytes());
+            }
+            py::bytes payload(
+                static_cast<const char *>(buffer_get_data(buffer)),
+                buffer_get_size(buffer));
+            buffer_free(buffer);
+            return payload;
+        },
+        py::arg("array"), py::arg("codec"));
+    m.def(
+        "decode",
+        [](const std::string &payload, py::array array) {
+            // Decoding into a copy would silently drop the result
+            if (!(array.flags() & py::array::c_style))
+                throw py::value_error("Expected a C-contiguous array");
+            buffer_type *buffer = buffer_alloc(payload.size());
+            buffer_fwrite(buffer, payload.data(), 1, payload.size());
+            buffer_rewind(buffer);
+            {
+                py::gil_scoped_release release;
+                node_codec_fread(buffer, array.mutable_data(), array.itemsize(),
+                                 array.nbytes());
+            }
+            buffer_free(buffer);
+        },
+        py::arg("payload"), py::arg("array"));
+}
@@ -16,6 +16,7 @@
    for more details.
 */
 
+#include <algorithm>
 #include <cstdint>
 #include <filesystem>
 #include <mutex>
@@ -25,21 +26,36 @@
 #include <vector>
 
 #include <errno.h>
+#include <fcntl.h>
 #include <fnmatch.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
+
 #include <fmt/ostream.h>
 
 #include <ert/python.hpp>
 
 #include <ert/res_util/block_fs.hpp>
+#include <ert/res_util/metric.hpp>
 
 namespace fs = std::filesystem;
 
 #define MOUNT_MAP_MAGIC_INT 8861290
+/**
+   Version 1 of the mount map has a list of layers after the version, each
+   given as the name of the layer file relative to the directory of the
+   mount map, and the size of the layer. Only a block_fs created as a
+   layered snapshot is written with version 1; older versions of ERT can not
+   mount it.
+*/
+#define MOUNT_MAP_VERSION 1
 #define BLOCK_FS_TYPE_ID 7100652
 
 /*
@@ -104,6 +120,8 @@ public:
     int32_t node_size{};
     int32_t data_size{};
     node_status_type status = NODE_INVALID;
+    /** The layer holding the block, or -1 for the block_fs' own data file */
+    int layer = -1;
 
     Block() = default;
     Block(const Block &) = default;
@@ -177,6 +195,27 @@ public:
         write_end_tag(data_stream);
     }
 
+    /** The file offset of the first data byte, right before the end tag. */
+    int64_t data_offset() const {
+        return node_offset + node_size - sizeof NODE_END_TAG - data_size;
+    }
+
+    /**
+     * Write the block with the @data_size bytes starting at @src_offset in
+     * the file @src_fd as data, without passing the data through memory.
+     */
+    void write_copy(const char *filename, FILE *data_stream, int src_fd,
+                    int64_t src_offset) {
+        write_active_markers(data_stream);
+        long data_offset = write_header(filename, data_stream);
+        if (fflush(data_stream) != 0)
+            util_abort("%s: flush failed: %s\n", __func__, strerror(errno));
+
+        copy_data(src_fd, src_offset, fileno(data_stream), data_offset,
+                  data_size);
+        write_end_tag(data_stream);
+    }
+
 private:
     /**
      * This marks the start and end of the node with the integer tags:
@@ -215,6 +254,46 @@ private:
         util_fwrite(ptr, 1, data_size, data_stream, __func__);
     }
 
+    /**
+     * Copy @size bytes between the files with copy_file_range(), which lets
+     * the kernel - or the filesystem, for reflink capable filesystems - do
+     * the copy. Falls back to pread()/pwrite() where that is not supported.
+     */
+    static void copy_data(int src_fd, off_t src_offset, int target_fd,
+                          off_t target_offset, size_t size) {
+#ifdef __linux__
+        while (size > 0) {
+            ssize_t copied = copy_file_range(src_fd, &src_offset, target_fd,
+                                             &target_offset, size, 0);
+            if (copied <= 0)
+                break;
+            size -= copied;
+        }
+#endif
+        char buffer[1 << 16];
+        while (size > 0) {
+            ssize_t bytes_read =
+                pread(src_fd, buffer, std::min(size, sizeof buffer),
+                      src_offset);
+            if (bytes_read <= 0)
+                util_abort("%s: read failed: %s\n", __func__,
+                           strerror(errno));
+
+            for (ssize_t written = 0; written < bytes_read;) {
+                ssize_t bytes_written =
+                    pwrite(target_fd, buffer + written, bytes_read - written,
+                           target_offset + written);
+                if (bytes_written < 0)
+                    util_abort("%s: write failed: %s\n", __func__,
+                               strerror(errno));
+                written += bytes_written;
+            }
+            src_offset += bytes_read;
+            target_offset += bytes_read;
+            size -= bytes_read;
+        }
+    }
+
     void write_end_tag(FILE *stream) {
         fseek__(stream, node_offset + node_size - sizeof NODE_END_TAG,
                 SEEK_SET);
@@ -227,11 +306,28 @@ private:
           status(status) {}
 };
 
+/**
+   A sealed data file of another block_fs, which a block_fs created with
+   block_fs_snapshot() reads through to. The @data_file is a hard link, in
+   the directory of the snapshot, to the data file of the other block_fs.
+   Only the first @size bytes - the data present when the snapshot was taken
+   - belong to the layer; data files are only ever appended to, so these
+   bytes do not change.
+*/
+struct block_fs_layer {
+    fs::path data_file;
+    int64_t size;
+    FILE *stream;
+};
+
 struct block_fs_struct {
     UTIL_TYPE_ID_DECLARATION;
 
+    fs::path data_file;
     int data_fd;
     FILE *data_stream;
+    /** The layers, oldest first; blocks in later layers take precedence. */
+    std::vector<block_fs_layer> layers;
 
     std::mutex mutex;
 
@@ -249,6 +345,14 @@ static inline void block_fs_fseek(block_fs_type *block_fs, long offset) {
     fseek__(block_fs->data_stream, offset, SEEK_SET);
 }
 
+/** The stream of the data file holding @block. */
+static FILE *block_fs_block_stream(const block_fs_type *block_fs,
+                                   const Block &block) {
+    if (block.layer < 0)
+        return block_fs->data_stream;
+    return block_fs->layers[block.layer].stream;
+}
+
 static block_fs_type *block_fs_alloc_empty(const fs::path &mount_file,
                                            int fsync_interval, bool read_only) {
     block_fs_type *block_fs = new block_fs_type;
@@ -259,10 +363,22 @@ static block_fs_type *block_fs_alloc_empty(const fs::path &mount_file,
     FILE *stream = util_fopen(mount_file.c_str(), "r");
     int id = util_fread_int(stream);
     int version = util_fread_int(stream);
-    if (version != 0)
+    if (version != 0 && version != MOUNT_MAP_VERSION)
         throw std::runtime_error(fmt::format(
-            "block_fs data version unexpected. Expected 0, got {}", version));
-
+            "block_fs data version unexpected. Expected 0 or {}, got {}",
+            MOUNT_MAP_VERSION, version));
+
+    if (version == MOUNT_MAP_VERSION) {
+        int num_layers = util_fread_int(stream);
+        for (int i = 0; i < num_layers; i++) {
+            char *data_file = util_fread_alloc_string(stream);
+            int64_t size;
+            util_fread(&size, sizeof size, 1, stream, __func__);
+            block_fs->layers.push_back(
+                {mount_file.parent_path() / data_file, size, nullptr});
+            free(data_file);
+        }
+    }
     fclose(stream);
 
     if (id != MOUNT_MAP_MAGIC_INT)
@@ -276,10 +392,23 @@ static block_fs_type *block_fs_alloc_empty(const fs::path &mount_file,
 
 UTIL_IS_INSTANCE_FUNCTION(block_fs, BLOCK_FS_TYPE_ID);
 
-static void block_fs_fwrite_mount_info(const fs::path &mount_file) {
+static void block_fs_fwrite_mount_info(
+    const fs::path &mount_file,
+    const std::vector<block_fs_layer> &layers = {}) {
     FILE *stream = util_fopen(mount_file.c_str(), "w");
     util_fwrite_int(MOUNT_MAP_MAGIC_INT, stream);
-    util_fwrite_int(0 /* data version; unused */, stream);
+    if (layers.empty())
+        util_fwrite_int(0 /* data version; unused */, stream);
+    else {
+        util_fwrite_int(MOUNT_MAP_VERSION, stream);
+        util_fwrite_int(layers.size(), stream);
+        for (const auto &layer : layers) {
+            auto data_file = layer.data_file.lexically_relative(
+                mount_file.parent_path());
+            util_fwrite_string(data_file.c_str(), stream);
+            util_fwrite(&layer.size, sizeof layer.size, 1, stream, __func__);
+        }
+    }
     fclose(stream);
 }
 
@@ -287,9 +416,8 @@ static void block_fs_fwrite_mount_info(const fs::path &mount_file) {
    Will seek the datafile to the end of the current file_node. So that the next read will be "guaranteed" to
    start at a new node.
 */
-static void block_fs_fseek_node_end(block_fs_type *block_fs,
-                                    const Block &block) {
-    block_fs_fseek(block_fs, block.node_offset + block.node_size);
+static void block_fs_fseek_node_end(FILE *stream, const Block &block) {
+    fseek__(stream, block.node_offset + block.node_size, SEEK_SET);
 }
 
 /**
@@ -301,37 +429,35 @@ static void block_fs_fseek_node_end(block_fs_type *block_fs,
    indicator is left at the end of the file; and the calling scope
    will finish from there.
 */
-static bool block_fs_fseek_valid_node(block_fs_type *block_fs) {
+static bool block_fs_fseek_valid_node(FILE *stream) {
     unsigned char byte;
     int status;
     while (true) {
-        if (fread(&byte, sizeof byte, 1, block_fs->data_stream) == 1) {
+        if (fread(&byte, sizeof byte, 1, stream) == 1) {
             if (byte == NODE_IN_USE_BYTE) {
-                long int pos = ftell(block_fs->data_stream);
+                long int pos = ftell(stream);
                 // OK - we found one interesting byte; let us try to read the
                 // whole integer and see if we have hit any of the valid status
                 // identifiers.
-                fseek__(block_fs->data_stream, -1, SEEK_CUR);
-                if (fread(&status, sizeof status, 1, block_fs->data_stream) ==
-                    1) {
+                fseek__(stream, -1, SEEK_CUR);
+                if (fread(&status, sizeof status, 1, stream) == 1) {
                     if (status == NODE_IN_USE) {
                         // OK - we have found a valid identifier. We reposition
                         // to the start of this valid status id and return
                         // true.
-                        fseek__(block_fs->data_stream, -sizeof status,
-                                SEEK_CUR);
+                        fseek__(stream, -sizeof status, SEEK_CUR);
                         return true;
                     } else
                         // OK - this was not a valid id; we go back and
                         // continue reading single bytes.
-                        block_fs_fseek(block_fs, pos);
+                        fseek__(stream, pos, SEEK_SET);
                 } else
                     break; /* EOF */
             }
         } else
             break; /* EOF */
     }
-    fseek__(block_fs->data_stream, 0, SEEK_END);
+    fseek__(stream, 0, SEEK_END);
     return false;
 }
 /**
@@ -366,15 +492,26 @@ static void block_fs_open_data(block_fs_type *block_fs,
         block_fs->data_fd = fileno(block_fs->data_stream);
 }
 
-static void block_fs_build_index(block_fs_type *block_fs,
-                                 const fs::path &data_file) {
+/**
+   Add the blocks in @stream to the index. For a layer the scan stops at
+   the @end of the layer, for the block_fs' own data file (@layer == -1) the
+   whole file is scanned.
+*/
+static void block_fs_build_index(block_fs_type *block_fs, FILE *stream,
+                                 const fs::path &data_file, int layer = -1,
+                                 int64_t end = -1) {
     char *filename = NULL;
 
-    block_fs_fseek(block_fs, 0);
+    fseek__(stream, 0, SEEK_SET);
     for (;;) {
-        auto block = Block::read_header(block_fs->data_stream, &filename);
+        if (end >= 0 && ftell(stream) >= end)
+            break;
+
+        auto block = Block::read_header(stream, &filename);
         if (!block.has_value())
             break;
+        if (end >= 0 && block->node_offset + block->node_size > end)
+            break;
 
         if ((block->status == NODE_INVALID) ||
             (block->status == NODE_WRITE_ACTIVE)) {
@@ -390,11 +527,12 @@ static void block_fs_build_index(block_fs_type *block_fs,
                         "while writing node in %s/%ld - will be discarded.\n",
                         data_file.c_str(), block->node_offset);
 
-            block_fs_fseek_valid_node(block_fs);
+            block_fs_fseek_valid_node(stream);
         } else {
-            if (block->verify_end_tag(block_fs->data_stream)) {
-                block_fs_fseek_node_end(block_fs, *block);
+            if (block->verify_end_tag(stream)) {
+                block_fs_fseek_node_end(stream, *block);
                 if (block->status == NODE_IN_USE) {
+                    block->layer = layer;
                     block_fs->index[filename] = *block;
                 } else {
                     util_abort("%s: node status flag:%d not recognized - "
@@ -410,7 +548,7 @@ static void block_fs_build_index(block_fs_type *block_fs,
                         "** Warning found node:%s at offset:%ld which was "
                         "incomplete - discarded.\n",
                         filename, block->node_offset);
-                block_fs_fseek_valid_node(block_fs);
+                block_fs_fseek_valid_node(stream);
             }
         }
     }
@@ -438,11 +576,24 @@ block_fs_type *block_fs_mount(const fs::path &mount_file, int fsync_interval,
 
     block_fs = block_fs_alloc_empty(mount_file, fsync_interval, read_only);
 
+    for (std::size_t i = 0; i < block_fs->layers.size(); i++) {
+        auto &layer = block_fs->layers[i];
+        layer.stream = fopen(layer.data_file.c_str(), "r");
+        if (layer.stream == nullptr)
+            throw std::runtime_error(fmt::format(
+                "block_fs {} is a snapshot of {} which can not be opened: {}",
+                mount_file.string(), layer.data_file.string(),
+                strerror(errno)));
+        block_fs_build_index(block_fs, layer.stream, layer.data_file, i,
+                             layer.size);
+    }
+
+    block_fs->data_file = data_file;
     block_fs_open_data(block_fs, data_file);
     if (block_fs->data_stream != nullptr) {
         std::error_code ec;
         fs::remove(index_file, ec /* error code is ignored */);
-        block_fs_build_index(block_fs, data_file);
+        block_fs_build_index(block_fs, block_fs->data_stream, data_file);
     }
     return block_fs;
 }
@@ -468,6 +619,10 @@ void block_fs_fwrite_file(block_fs_type *block_fs, const char *filename,
                           const void *ptr, size_t data_size) {
     if (block_fs_is_readonly(block_fs))
         throw std::runtime_error("tried to write to read only filesystem");
+    static const ert::metrics::Timer write_timer("block_fs.write");
+    static const ert::metrics::Counter write_bytes("block_fs.write.bytes");
+    auto timing = write_timer.time();
+    write_bytes.add(data_size);
     std::lock_guard guard{block_fs->mutex};
 
     Block block{NODE_IN_USE, block_fs_get_end(block_fs),
@@ -488,19 +643,153 @@ void block_fs_fwrite_buffer(block_fs_type *block_fs, const char *filename,
                          buffer_get_size(buffer));
 }
 
+/**
+   Copy the file @src_filename in @src to the file @target_filename in
+   @target. The data bytes are copied verbatim, without being read into
+   memory. Returns false if @src does not have @src_filename.
+*/
+bool block_fs_copy_file(block_fs_type *src, const char *src_filename,
+                        block_fs_type *target, const char *target_filename) {
+    if (block_fs_is_readonly(target))
+        throw std::runtime_error("tried to write to read only filesystem");
+
+    std::unique_lock<std::mutex> src_lock{src->mutex, std::defer_lock};
+    std::unique_lock<std::mutex> target_lock{target->mutex, std::defer_lock};
+    if (src == target)
+        src_lock.lock();
+    else
+        std::lock(src_lock, target_lock);
+
+    auto iter = src->index.find(src_filename);
+    if (iter == src->index.end())
+        return false;
+    const Block &src_block = iter->second;
+
+    // Pending writes to the source must reach the file before it is read
+    // through the file descriptor.
+    if (!block_fs_is_readonly(src) && fflush(src->data_stream) != 0)
+        util_abort("%s: flush failed: %s\n", __func__, strerror(errno));
+
+    Block block{NODE_IN_USE, block_fs_get_end(target), src_block.data_size,
+                target_filename};
+    block.write_copy(target_filename, target->data_stream,
+                     fileno(block_fs_block_stream(src, src_block)),
+                     src_block.data_offset());
+
+    target->write_count++;
+    if (target->fsync_interval &&
+        ((target->write_count % target->fsync_interval) == 0))
+        block_fs_fsync(target);
+
+    target->index[target_filename] = block;
+    return true;
+}
+
+/** True if nothing has ever been written to @block_fs. */
+bool block_fs_is_empty(block_fs_type *block_fs) {
+    std::lock_guard guard{block_fs->mutex};
+    return block_fs->index.empty() && block_fs->layers.empty() &&
+           (block_fs->data_stream == NULL || block_fs_get_end(block_fs) == 0);
+}
+
+/**
+   Clone the file @src_fd to @target_file with a reflink, i.e. the two files
+   share the storage until either of them is modified. Returns false if the
+   filesystem does not support reflinks.
+*/
+static bool block_fs_reflink(int src_fd, const fs::path &target_file) {
+#ifdef FICLONE
+    int target_fd = open(target_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                         S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (target_fd < 0)
+        return false;
+
+    bool cloned = ioctl(target_fd, FICLONE, src_fd) == 0;
+    close(target_fd);
+    if (!cloned) {
+        std::error_code ec;
+        fs::remove(target_file, ec);
+    }
+    return cloned;
+#else
+    return false;
+#endif
+}
+
+/**
+   Make @layer_file a hard link to @data_file, or a copy of it if the two
+   are on different filesystems.
+*/
+static void block_fs_link_layer(const fs::path &data_file,
+                                const fs::path &layer_file) {
+    std::error_code ec;
+    fs::remove(layer_file, ec);
+    fs::create_hard_link(data_file, layer_file, ec);
+    if (ec)
+        fs::copy_file(data_file, layer_file);
+}
+
+/**
+   Create the block_fs @target_mount_file - which must not be mounted - as a
+   copy-on-write snapshot of @src.
+
+   Where the filesystem supports it the data file of @src is cloned with a
+   reflink. Otherwise the data written to @src so far becomes a read-only
+   layer of the new block_fs, which is read through to; new data is
+   written to the data file of the new block_fs. The layers of @src are
+   inherited either way. Later writes to @src are not seen by the snapshot
+   and vice versa.
+
+   The layers are hard links in the directory of the snapshot, and the
+   mount map refers to them by relative names; the snapshot is therefore
+   self contained, and remains valid when @src is removed or the storage
+   is moved or copied.
+*/
+void block_fs_snapshot(block_fs_type *src, const fs::path &target_mount_file) {
+    std::lock_guard guard{src->mutex};
+    fs::path target_path = target_mount_file.parent_path();
+    std::string target_name = target_mount_file.stem().string();
+    std::vector<block_fs_layer> layers;
+    auto add_layer = [&](const fs::path &data_file, int64_t size) {
+        fs::path layer_file =
+            target_path /
+            fmt::format("{}.layer_{}", target_name, layers.size());
+        block_fs_link_layer(data_file, layer_file);
+        layers.push_back({layer_file, size, nullptr});
+    };
+
+    for (const auto &layer : src->layers)
+        add_layer(layer.data_file, layer.size);
+
+    if (src->data_stream != NULL) {
+        if (!block_fs_is_readonly(src) && fflush(src->data_stream) != 0)
+            util_abort("%s: flush failed: %s\n", __func__, strerror(errno));
+
+        int64_t size = block_fs_get_end(src);
+        fs::path target_data_file = target_path / (target_name + ".data_0");
+        if (size > 0 && !block_fs_reflink(src->data_fd, target_data_file))
+            add_layer(src->data_file, size);
+    }
+    block_fs_fwrite_mount_info(target_mount_file, layers);
+}
+
 /**
    Reads the full content of 'filename' into the buffer.
 */
 void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
                                    const char *filename, buffer_type *buffer) {
+    static const ert::metrics::Timer read_timer("block_fs.read");
+    static const ert::metrics::Counter read_bytes("block_fs.read.bytes");
+    auto timing = read_timer.time();
     std::lock_guard guard{block_fs->mutex};
     Block &block = block_fs->index.at(filename);
 
     buffer_clear(buffer); /* Setting: content_size = 0; pos = 0;  */
 
-    block.read_data(block_fs->data_stream, buffer);
+    block.read_data(block_fs_block_stream(block_fs, block), buffer);
 
     buffer_rewind(buffer); /* Setting: pos = 0; */
+    read_bytes.add(buffer_get_size(buffer));
 }
 
 /**
@@ -513,6 +802,9 @@ void block_fs_close(block_fs_type *block_fs) {
 
     if (block_fs->data_stream != NULL)
         fclose(block_fs->data_stream);
+    for (auto &layer : block_fs->layers)
+        if (layer.stream != NULL)
+            fclose(layer.stream);
 
     delete block_fs;
 }
@@ -16,16 +16,23 @@
 */
 
 #include <Eigen/Dense>
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fmt/format.h>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <optional>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include <ert/analysis/ies/ies.hpp>
 #include <ert/res_util/es_testdata.hpp>
 
 namespace fs = std::filesystem;
@@ -74,29 +81,183 @@ Eigen::MatrixXd load_matrix_from_file(int rows, int columns, FILE *stream) {
     return matrix;
 }
 
-Eigen::MatrixXd load_matrix(const std::string &name, int rows, int columns) {
-    if (!fs::exists(name))
-        throw std::invalid_argument("File not found");
-
-    FILE *stream = util_fopen(name.c_str(), "r");
-    Eigen::MatrixXd m = load_matrix_from_file(rows, columns, stream);
-    fclose(stream);
-
-    return m;
-}
-
 void save_matrix_to_file(const Eigen::MatrixXd &matrix, FILE *stream) {
     for (int i = 0; i < matrix.rows(); i++) {
         for (int j = 0; j < matrix.cols(); j++)
-            fprintf(stream, "%lg ", matrix(i, j));
+            fprintf(stream, "%.17lg ", matrix(i, j));
         fprintf(stream, "\n");
     }
 }
 
-void save_matrix_data(const std::string &name, const Eigen::MatrixXd &m) {
-    FILE *stream = util_fopen(name.c_str(), "w");
-    save_matrix_to_file(m, stream);
-    fclose(stream);
+/*
+  The binary matrix format is a 40 byte header followed by the elements as
+  little endian IEEE doubles in column major order:
+
+      char[8]  magic     "ESMATRIX"
+      uint32   version
+      uint32   reserved  0
+      uint64   rows
+      uint64   columns
+      uint64   checksum  FNV-1a of the element bytes
+
+  All the header fields are little endian.
+*/
+constexpr char binary_magic[8] = {'E', 'S', 'M', 'A', 'T', 'R', 'I', 'X'};
+constexpr std::uint32_t binary_version = 1;
+
+bool host_is_little_endian() {
+    const std::uint16_t one = 1;
+    unsigned char first_byte;
+    memcpy(&first_byte, &one, 1);
+    return first_byte == 1;
+}
+
+void swap_doubles(unsigned char *data, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        unsigned char *value = data + i * sizeof(double);
+        std::reverse(value, value + sizeof(double));
+    }
+}
+
+std::uint64_t fnv1a(const unsigned char *data, size_t size) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void fwrite_le(std::uint64_t value, int bytes, FILE *stream) {
+    for (int i = 0; i < bytes; i++)
+        fputc((value >> (8 * i)) & 0xff, stream);
+}
+
+std::uint64_t fread_le(int bytes, FILE *stream, const std::string &name) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        int c = fgetc(stream);
+        if (c == EOF)
+            throw std::runtime_error("Premature end of matrix file: " + name);
+        value |= static_cast<std::uint64_t>(c) << (8 * i);
+    }
+    return value;
+}
+
+void save_matrix_to_binary_file(const Eigen::MatrixXd &matrix, FILE *stream) {
+    const size_t size = matrix.size() * sizeof(double);
+    const auto *data = reinterpret_cast<const unsigned char *>(matrix.data());
+    std::vector<unsigned char> swapped;
+    if (!host_is_little_endian()) {
+        swapped.assign(data, data + size);
+        swap_doubles(swapped.data(), matrix.size());
+        data = swapped.data();
+    }
+
+    fwrite(binary_magic, 1, sizeof binary_magic, stream);
+    fwrite_le(binary_version, 4, stream);
+    fwrite_le(0, 4, stream);
+    fwrite_le(matrix.rows(), 8, stream);
+    fwrite_le(matrix.cols(), 8, stream);
+    fwrite_le(fnv1a(data, size), 8, stream);
+    if (fwrite(data, 1, size, stream) != size)
+        throw std::runtime_error("Writing of binary matrix failed");
+}
+
+/** Checks the magic, leaving @stream after it if the matrix is binary */
+bool is_binary_matrix(FILE *stream) {
+    char magic[sizeof binary_magic];
+    if (fread(magic, 1, sizeof magic, stream) == sizeof magic &&
+        memcmp(magic, binary_magic, sizeof magic) == 0)
+        return true;
+
+    rewind(stream);
+    return false;
+}
+
+Eigen::MatrixXd load_matrix_from_binary_file(FILE *stream,
+                                             const std::string &name) {
+    auto version = fread_le(4, stream, name);
+    if (version != binary_version)
+        throw std::invalid_argument(fmt::format(
+            "Unsupported version:{} of binary matrix: {}", version, name));
+
+    fread_le(4, stream, name);
+    auto rows = fread_le(8, stream, name);
+    auto columns = fread_le(8, stream, name);
+    auto checksum = fread_le(8, stream, name);
+
+    // The header is not covered by the checksum, so the shape is validated
+    // against the file size before anything is allocated.
+    long offset = ftell(stream);
+    if (offset < 0 || fseek(stream, 0, SEEK_END) != 0)
+        throw std::runtime_error("Can not determine size of matrix file: " +
+                                 name);
+    const std::uint64_t remaining = ftell(stream) - offset;
+    fseek(stream, offset, SEEK_SET);
+
+    const std::uint64_t max_elements = remaining / sizeof(double);
+    if (rows > static_cast<std::uint64_t>(Eigen::Index(-1) >> 1) ||
+        columns > static_cast<std::uint64_t>(Eigen::Index(-1) >> 1) ||
+        (columns != 0 && rows > max_elements / columns) ||
+        rows * columns * sizeof(double) != remaining)
+        throw std::runtime_error(fmt::format(
+            "Corrupt or truncated matrix file: {} - header size {}x{} does "
+            "not match {} bytes of data",
+            name, rows, columns, remaining));
+
+    Eigen::MatrixXd matrix(rows, columns);
+    const size_t size = remaining;
+    auto *data = reinterpret_cast<unsigned char *>(matrix.data());
+    if (fread(data, 1, size, stream) != size)
+        throw std::runtime_error("Premature end of matrix file: " + name);
+    if (fnv1a(data, size) != checksum)
+        throw std::runtime_error("Checksum mismatch in matrix file: " + name);
+
+    if (!host_is_little_endian())
+        swap_doubles(data, matrix.size());
+    return matrix;
+}
+
+using file_ptr = std::unique_ptr<FILE, decltype(&fclose)>;
+
+/**
+  Loads the binary matrix @name, or returns an empty optional if @name is not
+  a binary matrix file.
+*/
+std::optional<Eigen::MatrixXd> load_binary_matrix(const std::string &name) {
+    file_ptr stream(fopen(name.c_str(), "rb"), &fclose);
+    if (!stream || !is_binary_matrix(stream.get()))
+        return {};
+
+    return load_matrix_from_binary_file(stream.get(), name);
+}
+
+void save_matrix_data(const std::string &name, const Eigen::MatrixXd &m,
+                      es_testdata::format fmt) {
+    if (fmt == es_testdata::format::binary) {
+        file_ptr stream(util_fopen(name.c_str(), "wb"), &fclose);
+        save_matrix_to_binary_file(m, stream.get());
+    } else {
+        file_ptr stream(util_fopen(name.c_str(), "w"), &fclose);
+        save_matrix_to_file(m, stream.get());
+    }
+}
+
+Eigen::MatrixXd load_matrix(const std::string &name, int rows, int columns) {
+    if (!fs::exists(name))
+        throw std::invalid_argument("File not found");
+
+    file_ptr stream(util_fopen(name.c_str(), "rb"), &fclose);
+    if (!is_binary_matrix(stream.get()))
+        return load_matrix_from_file(rows, columns, stream.get());
+
+    Eigen::MatrixXd m = load_matrix_from_binary_file(stream.get(), name);
+    if (m.rows() != rows || m.cols() != columns)
+        throw std::invalid_argument(
+            fmt::format("The matrix: {} has size {}x{}, expected {}x{}", name,
+                        m.rows(), m.cols(), rows, columns));
+    return m;
 }
 
 std::array<int, 2> load_size() {
@@ -163,12 +324,9 @@ Eigen::MatrixXd es_testdata::make_matrix(const std::string &fname, int rows,
 }
 
 void es_testdata::save_matrix(const std::string &name,
-                              const Eigen::MatrixXd &m) const {
+                              const Eigen::MatrixXd &m, format fmt) const {
     pushd tmp_path(this->path);
-
-    FILE *stream = util_fopen(name.c_str(), "w");
-    save_matrix_to_file(m, stream);
-    fclose(stream);
+    save_matrix_data(name, m, fmt);
 }
 
 es_testdata::es_testdata(const Eigen::MatrixXd &S, const Eigen::MatrixXd &R,
@@ -227,27 +385,68 @@ es_testdata::es_testdata(const char *path) : path(path) {
     this->ens_mask = std::vector<bool>(this->active_ens_size, true);
 }
 
-void es_testdata::save(const std::string &path) const {
+/** A rows x columns matrix of standard normal values, filled by columns */
+Eigen::MatrixXd es_testdata::random_matrix(int rows, int columns,
+                                           std::mt19937 &generator) {
+    std::normal_distribution<double> normal;
+    Eigen::MatrixXd matrix(rows, columns);
+    for (int col = 0; col < columns; col++)
+        for (int row = 0; row < rows; row++)
+            matrix(row, col) = normal(generator);
+    return matrix;
+}
+
+/**
+  A synthetic update problem: normally distributed responses S, observations
+  dObs of unit error, an identity R and E and D as in the smoother update.
+  The same arguments give the same matrices.
+*/
+es_testdata es_testdata::random(int ens_size, int obs_size,
+                                unsigned int seed) {
+    std::mt19937 generator(seed);
+    Eigen::MatrixXd S = random_matrix(obs_size, ens_size, generator);
+    Eigen::MatrixXd dObs(obs_size, 2);
+    dObs.col(0) = random_matrix(obs_size, 1, generator);
+    dObs.col(1) = Eigen::VectorXd::Ones(obs_size);
+
+    Eigen::MatrixXd E =
+        ies::makeE(dObs.col(1), random_matrix(obs_size, ens_size, generator));
+    Eigen::MatrixXd D = ies::makeD(dObs.col(0), E, S);
+    Eigen::MatrixXd R = Eigen::MatrixXd::Identity(obs_size, obs_size);
+    return es_testdata(S, R, D, E, dObs);
+}
+
+void es_testdata::save(const std::string &path, format fmt) const {
     pushd tmp_path(path, true);
     save_size(this->active_ens_size, this->active_obs_size);
 
-    save_matrix_data("S", this->S);
-    save_matrix_data("E", this->E);
-    save_matrix_data("R", this->R);
-    save_matrix_data("D", this->D);
-    save_matrix_data("dObs", this->dObs);
+    save_matrix_data("S", this->S, fmt);
+    save_matrix_data("E", this->E, fmt);
+    save_matrix_data("R", this->R, fmt);
+    save_matrix_data("D", this->D, fmt);
+    save_matrix_data("dObs", this->dObs, fmt);
 }
 
 /**
   This function will allocate a matrix based on data found on disk. The data on
   disk is only the actual content of the matrix, in row_major order. Before the
   matrix is constructed it is verified that the number of elements is a multiple
-  of this->active_ens_size.
+  of this->active_ens_size. A binary matrix must have this->active_ens_size
+  columns.
 */
 Eigen::MatrixXd es_testdata::make_state(const std::string &name) const {
 
     pushd tmp_path(this->path);
 
+    if (auto state = load_binary_matrix(name)) {
+        if (state->cols() != this->active_ens_size)
+            throw std::invalid_argument(
+                "The state matrix: " + name +
+                " must have ensemble_size: " +
+                std::to_string(this->active_ens_size) + " columns");
+        return *state;
+    }
+
     std::ifstream stream(name);
     if (!stream)
         throw std::invalid_argument("No such state matrix: " + this->path +
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+#include <ert/res_util/metric.hpp>
+
+namespace ert {
+namespace metrics {
+namespace {
+constexpr int max_metrics = 128;
+
+/** The count, the total and the histogram of one metric. */
+constexpr int value_count = 2 + histogram_buckets;
+typedef std::array<std::uint64_t, value_count> metric_values;
+
+/**
+   The values of all the metrics updated from one thread. Only the owning
+   thread writes the values, so they are updated with relaxed loads and
+   stores instead of read-modify-write operations; they are atomic since
+   snapshot() reads them from another thread.
+*/
+struct shard_type {
+    std::unique_ptr<std::atomic<std::uint64_t>[]> values{
+        new std::atomic<std::uint64_t>[max_metrics * value_count]()};
+
+    void add(int id, int index, std::uint64_t value) {
+        auto &slot = values[id * value_count + index];
+        slot.store(slot.load(std::memory_order_relaxed) + value,
+                   std::memory_order_relaxed);
+    }
+
+    std::uint64_t get(int id, int index) const {
+        return values[id * value_count + index].load(std::memory_order_relaxed);
+    }
+};
+
+struct registry_type {
+    std::mutex mutex;
+    std::vector<std::pair<std::string, metric_kind>> metrics;
+    /** The shards of the running threads */
+    std::vector<const shard_type *> shards;
+    /** The values of the threads which have exited */
+    std::vector<metric_values> retired;
+    /** The values at the last reset() */
+    std::vector<metric_values> baseline;
+
+    registry_type() : retired(max_metrics), baseline(max_metrics) {}
+
+    metric_values totals(int id) const {
+        metric_values values = retired[id];
+        for (const auto *shard : shards)
+            for (int index = 0; index < value_count; index++)
+                values[index] += shard->get(id, index);
+        return values;
+    }
+};
+
+/**
+   The registry is never destroyed, since threads can exit and fold their
+   values into it after the static destructors have run.
+*/
+registry_type &registry() {
+    static auto *registry = new registry_type();
+    return *registry;
+}
+
+struct thread_shard {
+    shard_type shard;
+
+    thread_shard() {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.shards.push_back(&shard);
+    }
+
+    ~thread_shard() {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (size_t id = 0; id < reg.metrics.size(); id++)
+            for (int index = 0; index < value_count; index++)
+                reg.retired[id][index] += shard.get(id, index);
+        reg.shards.erase(
+            std::find(reg.shards.begin(), reg.shards.end(), &shard));
+    }
+};
+
+shard_type &local_shard() {
+    thread_local thread_shard local;
+    return local.shard;
+}
+
+int register_metric(const std::string &name, metric_kind kind) {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (size_t id = 0; id < reg.metrics.size(); id++) {
+        if (reg.metrics[id].first == name) {
+            if (reg.metrics[id].second != kind)
+                throw std::logic_error("The metric " + name +
+                                       " is registered with another kind");
+            return id;
+        }
+    }
+
+    if (reg.metrics.size() == max_metrics)
+        throw std::length_error("Too many metrics, can not register " + name);
+    reg.metrics.emplace_back(name, kind);
+    return reg.metrics.size() - 1;
+}
+
+int histogram_bucket(std::uint64_t nanoseconds) {
+    std::uint64_t microseconds = nanoseconds >> 10;
+    int bucket = 0;
+    while (microseconds > 0 && bucket < histogram_buckets - 1) {
+        microseconds >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+} // namespace
+
+std::uint64_t histogram_upper_bound(int bucket) {
+    return std::uint64_t(1024) << bucket;
+}
+
+Counter::Counter(const std::string &name)
+    : m_id(register_metric(name, metric_kind::counter)) {}
+
+void Counter::add(std::uint64_t value) const {
+    auto &shard = local_shard();
+    shard.add(m_id, 0, 1);
+    shard.add(m_id, 1, value);
+}
+
+Timer::Timer(const std::string &name)
+    : m_id(register_metric(name, metric_kind::timer)) {}
+
+void Timer::record(std::chrono::nanoseconds duration) const {
+    std::uint64_t nanoseconds = std::max<std::int64_t>(duration.count(), 0);
+    auto &shard = local_shard();
+    shard.add(m_id, 0, 1);
+    shard.add(m_id, 1, nanoseconds);
+    shard.add(m_id, 2 + histogram_bucket(nanoseconds), 1);
+}
+
+std::vector<metric_snapshot> snapshot() {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<metric_snapshot> result;
+    for (size_t id = 0; id < reg.metrics.size(); id++) {
+        metric_values values = reg.totals(id);
+        const metric_values &baseline = reg.baseline[id];
+        const auto &[name, kind] = reg.metrics[id];
+
+        metric_snapshot metric{name, kind, values[0] - baseline[0],
+                               values[1] - baseline[1]};
+        if (kind == metric_kind::timer)
+            for (int bucket = 0; bucket < histogram_buckets; bucket++)
+                metric.histogram.push_back(values[2 + bucket] -
+                                           baseline[2 + bucket]);
+        result.push_back(metric);
+    }
+    return result;
+}
+
+/**
+   Values recorded concurrently with reset() may or may not be included in
+   the following snapshot().
+*/
+void reset() {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (size_t id = 0; id < reg.metrics.size(); id++)
+        reg.baseline[id] = reg.totals(id);
+}
+} // namespace metrics
+} // namespace ert
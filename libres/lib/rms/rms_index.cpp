@@ -0,0 +1,320 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ert/util/util.hpp>
+
+#include <ert/rms/rms_index.hpp>
+
+static const char *rms_binary_header = "roff-bin";
+static const char *rms_ascii_header = "roff-asc";
+
+static const char *rms_type_names[6] = {"char", "float", "double",
+                                        "bool", "byte",  "int"};
+
+static const int rms_type_size[6] = {1, 4, 8, 1, 1, 4};
+
+struct rms_index_struct {
+    std::string filename;
+    FILE *stream;
+    bool ascii;
+    bool endian_convert;
+    std::vector<rms_index_entry_type> entries;
+    /** From tag, name and key to the first matching entry */
+    std::unordered_map<std::string, size_t> lookup;
+};
+
+static std::string rms_index_lookup_key(const std::string &tag,
+                                        const std::string &name,
+                                        const std::string &key) {
+    return tag + '\n' + name + '\n' + key;
+}
+
+static void rms_index_premature_eof(const rms_index_type *index) {
+    util_abort("%s: premature end of ROFF file:%s \n", __func__,
+               index->filename.c_str());
+}
+
+/**
+   In binary files the strings are zero terminated. In ASCII files the
+   tokens are separated by whitespace, strings are quoted and comments are
+   enclosed in '#'.
+*/
+static std::string rms_index_fread_token(const rms_index_type *index) {
+    std::string token;
+    int c;
+    if (!index->ascii) {
+        while ((c = fgetc(index->stream)) != EOF && c != '\0')
+            token += c;
+        if (c == EOF)
+            rms_index_premature_eof(index);
+        return token;
+    }
+
+    while (true) {
+        do
+            c = fgetc(index->stream);
+        while (c != EOF && isspace(c));
+
+        if (c != '#')
+            break;
+        do
+            c = fgetc(index->stream);
+        while (c != EOF && c != '#');
+    }
+
+    if (c == EOF)
+        rms_index_premature_eof(index);
+
+    if (c == '"') {
+        while ((c = fgetc(index->stream)) != EOF && c != '"')
+            token += c;
+        return token;
+    }
+
+    do {
+        token += c;
+        c = fgetc(index->stream);
+    } while (c != EOF && !isspace(c));
+    return token;
+}
+
+static int rms_index_fread_int(const rms_index_type *index) {
+    if (index->ascii)
+        return atoi(rms_index_fread_token(index).c_str());
+
+    int value;
+    if (fread(&value, sizeof value, 1, index->stream) != 1)
+        rms_index_premature_eof(index);
+    if (index->endian_convert)
+        util_endian_flip_vector(&value, sizeof value, 1);
+    return value;
+}
+
+static void rms_index_fskip_values(const rms_index_type *index,
+                                   rms_type_enum rms_type, int size) {
+    if (index->ascii || rms_type == rms_char_type) {
+        for (int i = 0; i < size; i++)
+            rms_index_fread_token(index);
+    } else
+        fseek(index->stream, (long)size * rms_type_size[rms_type], SEEK_CUR);
+}
+
+static rms_type_enum rms_index_get_type(const rms_index_type *index,
+                                        const std::string &type_name) {
+    for (int rms_type = 0; rms_type < 6; rms_type++)
+        if (type_name == rms_type_names[rms_type])
+            return (rms_type_enum)rms_type;
+
+    util_abort("%s: unknown type:%s in ROFF file:%s \n", __func__,
+               type_name.c_str(), index->filename.c_str());
+    return rms_char_type;
+}
+
+/**
+   Reads the headers of the tags and their keys; the values are skipped,
+   except for the "name" key of the tags and the byteswaptest of the
+   filedata tag.
+*/
+static void rms_index_fread_headers(rms_index_type *index) {
+    char header[8];
+    if (fread(header, 1, sizeof header, index->stream) != sizeof header)
+        rms_index_premature_eof(index);
+
+    if (strncmp(header, rms_binary_header, sizeof header) == 0) {
+        index->ascii = false;
+        fgetc(index->stream);
+    } else if (strncmp(header, rms_ascii_header, sizeof header) == 0)
+        index->ascii = true;
+    else
+        util_abort("%s: %s is not a ROFF file \n", __func__,
+                   index->filename.c_str());
+
+    /* Binary files start with comment strings */
+    std::string token = rms_index_fread_token(index);
+    while (token != "tag") {
+        if (token.empty() || token[0] != '#')
+            util_abort("%s: expected tag, found:%s in ROFF file:%s \n",
+                       __func__, token.c_str(), index->filename.c_str());
+        token = rms_index_fread_token(index);
+    }
+
+    while (true) {
+        std::string tag = rms_index_fread_token(index);
+        if (tag == "eof")
+            break;
+
+        std::string name;
+        size_t first_entry = index->entries.size();
+        for (token = rms_index_fread_token(index); token != "endtag";
+             token = rms_index_fread_token(index)) {
+            bool is_array = token == "array";
+            if (is_array)
+                token = rms_index_fread_token(index);
+
+            rms_type_enum rms_type = rms_index_get_type(index, token);
+            std::string key = rms_index_fread_token(index);
+            int size = is_array ? rms_index_fread_int(index) : 1;
+            long offset = util_ftell(index->stream);
+
+            if (tag == "filedata" && key == "byteswaptest")
+                index->endian_convert = rms_index_fread_int(index) != 1;
+            else if (key == "name" && rms_type == rms_char_type && size == 1)
+                name = rms_index_fread_token(index);
+            else
+                rms_index_fskip_values(index, rms_type, size);
+
+            index->entries.push_back({tag, "", key, rms_type, size, offset});
+        }
+
+        for (size_t i = first_entry; i < index->entries.size(); i++) {
+            auto &entry = index->entries[i];
+            entry.name = name;
+            index->lookup.emplace(
+                rms_index_lookup_key(entry.tag, entry.name, entry.key), i);
+        }
+
+        token = rms_index_fread_token(index);
+        if (token != "tag")
+            util_abort("%s: expected tag, found:%s in ROFF file:%s \n",
+                       __func__, token.c_str(), index->filename.c_str());
+    }
+}
+
+rms_index_type *rms_index_alloc(const char *filename) {
+    rms_index_type *index = new rms_index_type();
+    index->filename = filename;
+    index->stream = util_fopen(filename, "rb");
+    index->ascii = false;
+    index->endian_convert = false;
+    rms_index_fread_headers(index);
+    return index;
+}
+
+void rms_index_free(rms_index_type *index) {
+    fclose(index->stream);
+    delete index;
+}
+
+bool rms_index_is_ascii(const rms_index_type *index) { return index->ascii; }
+
+/**
+   Finds the key @key of the tag @tag whose "name" key is @name, e.g.
+   ("parameter", "PORO", "data"). With @name == NULL the first tag called
+   @tag is used. Returns NULL if there is no such key.
+*/
+const rms_index_entry_type *rms_index_find(const rms_index_type *index,
+                                           const char *tag, const char *name,
+                                           const char *key) {
+    if (name == NULL) {
+        for (const auto &entry : index->entries)
+            if (entry.tag == tag && entry.key == key)
+                return &entry;
+        return NULL;
+    }
+
+    auto iter = index->lookup.find(rms_index_lookup_key(tag, name, key));
+    if (iter == index->lookup.end())
+        return NULL;
+    return &index->entries[iter->second];
+}
+
+template <typename T>
+static void rms_index_convert(const void *src_data, rms_type_enum src_type,
+                              int size, T *data) {
+    switch (src_type) {
+    case rms_float_type:
+        for (int i = 0; i < size; i++)
+            data[i] = ((const float *)src_data)[i];
+        break;
+    case rms_double_type:
+        for (int i = 0; i < size; i++)
+            data[i] = ((const double *)src_data)[i];
+        break;
+    case rms_int_type:
+        for (int i = 0; i < size; i++)
+            data[i] = ((const int *)src_data)[i];
+        break;
+    case rms_bool_type:
+    case rms_byte_type:
+        for (int i = 0; i < size; i++)
+            data[i] = ((const unsigned char *)src_data)[i];
+        break;
+    default:
+        util_abort("%s: can not convert rms_type:%s to a number \n", __func__,
+                   rms_type_names[src_type]);
+    }
+}
+
+/**
+   The ASCII values are parsed in the type of the entry, so that they are
+   converted to the target type as in binary files.
+*/
+template <typename T>
+static void rms_index_fread_ascii(const rms_index_type *index,
+                                  const rms_index_entry_type *entry, T *data) {
+    for (int i = 0; i < entry->size; i++) {
+        std::string token = rms_index_fread_token(index);
+        if (entry->rms_type == rms_float_type)
+            data[i] = strtof(token.c_str(), NULL);
+        else
+            data[i] = strtod(token.c_str(), NULL);
+    }
+}
+
+/**
+   Reads the values of @entry into @data, which must have room for
+   entry->size values of @target_type; the target type must be float,
+   double or int. Values of the same type in binary files are read in one
+   block and byteswapped in place.
+*/
+void rms_index_fread(const rms_index_type *index,
+                     const rms_index_entry_type *entry,
+                     rms_type_enum target_type, void *data) {
+    if (target_type != rms_float_type && target_type != rms_double_type &&
+        target_type != rms_int_type)
+        util_abort("%s: can not read into rms_type:%s \n", __func__,
+                   rms_type_names[target_type]);
+
+    fseek(index->stream, entry->offset, SEEK_SET);
+    if (index->ascii) {
+        if (target_type == rms_float_type)
+            rms_index_fread_ascii(index, entry, (float *)data);
+        else if (target_type == rms_double_type)
+            rms_index_fread_ascii(index, entry, (double *)data);
+        else
+            rms_index_fread_ascii(index, entry, (int *)data);
+        return;
+    }
+
+    const int sizeof_ctype = rms_type_size[entry->rms_type];
+    std::vector<char> buffer;
+    void *src_data = data;
+    if (entry->rms_type != target_type) {
+        buffer.resize((size_t)entry->size * sizeof_ctype);
+        src_data = buffer.data();
+    }
+
+    if (fread(src_data, sizeof_ctype, entry->size, index->stream) !=
+        (size_t)entry->size)
+        rms_index_premature_eof(index);
+    if (index->endian_convert && sizeof_ctype > 1)
+        util_endian_flip_vector(src_data, sizeof_ctype, entry->size);
+
+    if (entry->rms_type == target_type)
+        return;
+
+    if (target_type == rms_float_type)
+        rms_index_convert(src_data, entry->rms_type, entry->size,
+                          (float *)data);
+    else if (target_type == rms_double_type)
+        rms_index_convert(src_data, entry->rms_type, entry->size,
+                          (double *)data);
+    else
+        rms_index_convert(src_data, entry->rms_type, entry->size, (int *)data);
+}
@@ -15,6 +15,9 @@
    for more details.
 */
 
+#include <mutex>
+#include <vector>
+
 #include <stdio.h>
 #include <string.h>
 
@@ -97,6 +100,13 @@ int history_get_last_restart(const history_type *history) {
     return ecl_sum_get_last_report_step(history->refcase);
 }
 
+static std::mutex refcase_mutex;
+
+/**
+   Fill @value with the values of @summary_key at the report steps of the
+   refcase, and @valid with the report steps present in the refcase. Can be
+   called concurrently from several threads.
+*/
 bool history_init_ts(const history_type *history, const char *summary_key,
                      double_vector_type *value, bool_vector_type *valid) {
     bool initOK = false;
@@ -128,22 +138,32 @@ bool history_init_ts(const history_type *history, const char *summary_key,
         local_key = (char *)summary_key;
 
     if (local_key) {
-        if (ecl_sum_has_general_var(history->refcase, local_key)) {
+        // The summary data of the refcase is loaded lazily, which is not
+        // thread safe; the lock is only held while the whole vector is read
+        // in one call.
+        std::vector<double> data;
+        {
+            std::lock_guard<std::mutex> lock(refcase_mutex);
+            if (ecl_sum_has_general_var(history->refcase, local_key)) {
+                data.resize(ecl_sum_get_data_length(history->refcase));
+                ecl_sum_init_double_vector(history->refcase, local_key,
+                                           data.data());
+                initOK = true;
+            }
+        }
+
+        if (initOK) {
             for (int tstep = 0; tstep <= history_get_last_restart(history);
                  tstep++) {
                 if (ecl_sum_has_report_step(history->refcase, tstep)) {
                     int time_index =
                         ecl_sum_iget_report_end(history->refcase, tstep);
-                    double_vector_iset(value, tstep,
-                                       ecl_sum_get_general_var(history->refcase,
-                                                               time_index,
-                                                               local_key));
+                    double_vector_iset(value, tstep, data[time_index]);
                     bool_vector_iset(valid, tstep, true);
                 } else
                     bool_vector_iset(valid, tstep,
                                      false); /* Did not have this report step */
             }
-            initOK = true;
         }
 
         if (history->source == REFCASE_HISTORY)
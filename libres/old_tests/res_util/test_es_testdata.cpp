@@ -15,6 +15,8 @@
   for more details.
 */
 #include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <stdexcept>
 
 #include <ert/res_util/es_testdata.hpp>
@@ -199,9 +201,92 @@ void test_load_state() {
     }
 }
 
+bool bitwise_equal(const Eigen::MatrixXd &m1, const Eigen::MatrixXd &m2) {
+    return m1.rows() == m2.rows() && m1.cols() == m2.cols() &&
+           memcmp(m1.data(), m2.data(), m1.size() * sizeof(double)) == 0;
+}
+
+void assert_bitwise_equal(const res::es_testdata &td1,
+                          const res::es_testdata &td2) {
+    test_assert_true(bitwise_equal(td1.S, td2.S));
+    test_assert_true(bitwise_equal(td1.E, td2.E));
+    test_assert_true(bitwise_equal(td1.R, td2.R));
+    test_assert_true(bitwise_equal(td1.D, td2.D));
+    test_assert_true(bitwise_equal(td1.dObs, td2.dObs));
+}
+
+void test_binary_roundtrip() {
+    ecl::util::TestArea work_area("es_testdata");
+    int ens_size = 10;
+    int obs_size = 7;
+    res::es_testdata td = res::es_testdata::random(ens_size, obs_size, 1);
+    assert_bitwise_equal(td, res::es_testdata::random(ens_size, obs_size, 1));
+
+    td.save("text");
+    td.save("binary", res::es_testdata::format::binary);
+    res::es_testdata text("text");
+    res::es_testdata binary("binary");
+    assert_bitwise_equal(td, text);
+    assert_bitwise_equal(td, binary);
+    test_assert_int_equal(binary.active_ens_size, ens_size);
+    test_assert_int_equal(binary.active_obs_size, obs_size);
+
+    Eigen::MatrixXd A = res::es_testdata::random(ens_size, 5, 2).E / 3;
+    text.save_matrix("prior", A);
+    binary.save_matrix("prior", A, res::es_testdata::format::binary);
+    test_assert_true(bitwise_equal(text.make_state("prior"), A));
+    test_assert_true(bitwise_equal(binary.make_state("prior"), A));
+    test_assert_true(
+        bitwise_equal(binary.make_matrix("prior", 5, ens_size), A));
+    test_assert_throw(binary.make_matrix("prior", ens_size, 5),
+                      std::invalid_argument);
+
+    binary.save_matrix("transposed", A.transpose(),
+                       res::es_testdata::format::binary);
+    test_assert_throw(binary.make_state("transposed"), std::invalid_argument);
+}
+
+void test_binary_corrupt() {
+    ecl::util::TestArea work_area("es_testdata");
+    res::es_testdata td = res::es_testdata::random(10, 7, 1);
+    td.save("binary", res::es_testdata::format::binary);
+
+    {
+        FILE *stream = util_fopen("binary/S", "r+b");
+        fseek(stream, -1, SEEK_END);
+        int c = fgetc(stream);
+        fseek(stream, -1, SEEK_END);
+        fputc(c ^ 1, stream);
+        fclose(stream);
+    }
+    test_assert_throw(res::es_testdata("binary"), std::runtime_error);
+
+    td.save("binary", res::es_testdata::format::binary);
+    auto size = std::filesystem::file_size("binary/E");
+    std::filesystem::resize_file("binary/E", size - 8);
+    test_assert_throw(res::es_testdata("binary"), std::runtime_error);
+
+    // A corrupt shape in the header must not be used to allocate the matrix
+    for (unsigned char rows_byte : {0x01, 0xff}) {
+        td.save("binary", res::es_testdata::format::binary);
+        FILE *stream = util_fopen("binary/D", "r+b");
+        fseek(stream, 23, SEEK_SET);
+        fputc(rows_byte, stream);
+        fclose(stream);
+        test_assert_throw(res::es_testdata("binary"), std::runtime_error);
+    }
+
+    td.save("binary", res::es_testdata::format::binary);
+    res::es_testdata("binary").save_matrix("R", td.S,
+                                           res::es_testdata::format::binary);
+    test_assert_throw(res::es_testdata("binary"), std::invalid_argument);
+}
+
 int main() {
     test_basic();
     test_load_state();
     test_deactivate();
     test_size_problems();
+    test_binary_roundtrip();
+    test_binary_corrupt();
 }
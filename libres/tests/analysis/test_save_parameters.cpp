@@ -25,11 +25,22 @@ load_parameters(enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
                 const std::vector<int> &iens_active_index,
                 const std::vector<analysis::Parameter> &parameters);
 
+std::optional<Eigen::MatrixXf>
+load_parameters_float(enkf_fs_type *target_fs,
+                      ensemble_config_type *ensemble_config,
+                      const std::vector<int> &iens_active_index,
+                      const std::vector<analysis::Parameter> &parameters);
+
 void save_parameters(enkf_fs_type *target_fs,
                      ensemble_config_type *ensemble_config,
                      const std::vector<int> &iens_active_index,
                      const std::vector<Parameter> &parameters,
                      const Eigen::MatrixXd &A);
+void save_parameters(enkf_fs_type *target_fs,
+                     ensemble_config_type *ensemble_config,
+                     const std::vector<int> &iens_active_index,
+                     const std::vector<Parameter> &parameters,
+                     const Eigen::MatrixXf &A);
 void save_row_scaling_parameters(
     enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
     const std::vector<int> &iens_active_index,
@@ -106,6 +117,25 @@ TEST_CASE("Write and read a matrix to enkf_fs instance",
             }
         }
 
+        WHEN("loading and saving parameters in single precision") {
+            auto B = analysis::load_parameters_float(fs, ensemble_config,
+                                                     active_index, parameters);
+            THEN("Loading parameters yield the rounded matrix") {
+                REQUIRE(B.has_value());
+                REQUIRE(B.value() == A.cast<float>());
+            }
+
+            Eigen::MatrixXf C = B.value() * 2;
+            analysis::save_parameters(fs, ensemble_config, active_index,
+                                      parameters, C);
+            auto D = analysis::load_parameters(fs, ensemble_config,
+                                               active_index, parameters);
+            THEN("Saving parameters stores the single precision values") {
+                REQUIRE(D.has_value());
+                REQUIRE(D.value() == C.cast<double>());
+            }
+        }
+
         //cleanup
         ensemble_config_free(ensemble_config);
         enkf_fs_decref(fs);
@@ -0,0 +1,102 @@
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+
+#include <catch2/catch.hpp>
+
+#include <ert/analysis/ies/ies.hpp>
+#include <ert/analysis/ies/ies_config.hpp>
+#include <ert/enkf/row_scaling.hpp>
+
+namespace analysis {
+void multiply(Eigen::Ref<Eigen::MatrixXf> A, const Eigen::MatrixXd &X);
+} // namespace analysis
+
+namespace {
+constexpr int field_size = 20000;
+constexpr int ens_size = 100;
+constexpr int obs_size = 50;
+
+/** A porosity like field: a smooth trend with a little noise */
+Eigen::MatrixXd make_field(std::mt19937 &rng) {
+    std::normal_distribution<double> noise(0, 0.02);
+    Eigen::MatrixXd A(field_size, ens_size);
+    for (int column = 0; column < ens_size; column++)
+        for (int row = 0; row < field_size; row++)
+            A(row, column) = 0.2 + 0.05 * std::sin(row * 0.01) + noise(rng);
+    return A;
+}
+
+/** The X of an ES update where every 100th cell of the field is observed */
+Eigen::MatrixXd make_X(const Eigen::MatrixXd &A, std::mt19937 &rng) {
+    std::normal_distribution<double> normal(0, 1);
+    Eigen::MatrixXd S(obs_size, ens_size);
+    Eigen::MatrixXd noise(obs_size, ens_size);
+    for (int i = 0; i < obs_size; i++) {
+        S.row(i) = A.row(i * 100);
+        for (int j = 0; j < ens_size; j++)
+            noise(i, j) = normal(rng);
+    }
+    Eigen::VectorXd obs_values = Eigen::VectorXd::Constant(obs_size, 0.25);
+    Eigen::VectorXd obs_errors = Eigen::VectorXd::Constant(obs_size, 0.01);
+
+    Eigen::MatrixXd E = ies::makeE(obs_errors, noise);
+    Eigen::MatrixXd D = ies::makeD(obs_values, E, S);
+    Eigen::MatrixXd R = Eigen::MatrixXd::Identity(obs_size, obs_size);
+    Eigen::MatrixXd W0 = Eigen::MatrixXd::Zero(ens_size, ens_size);
+    D = obs_errors.cwiseInverse().asDiagonal() * D;
+    E = obs_errors.cwiseInverse().asDiagonal() * E;
+    S = obs_errors.cwiseInverse().asDiagonal() * S;
+    return ies::makeX({}, S, R, E, D, ies::IES_INVERSION_EXACT, 0.98, W0, 1,
+                      1);
+}
+
+/**
+  The rounding of A to float and of the updated A back to float, carried
+  through the sum over a column of X.
+*/
+double float_tolerance(const Eigen::MatrixXd &A, const Eigen::MatrixXd &X) {
+    return std::numeric_limits<float>::epsilon() * A.cwiseAbs().maxCoeff() *
+           X.cwiseAbs().colwise().sum().maxCoeff();
+}
+
+double max_deviation(const Eigen::MatrixXf &A, const Eigen::MatrixXd &B) {
+    return (A.cast<double>() - B).cwiseAbs().maxCoeff();
+}
+} // namespace
+
+TEST_CASE("single precision update is close to the double precision update",
+          "[analysis]") {
+    std::mt19937 rng(42);
+    Eigen::MatrixXd A = make_field(rng);
+    Eigen::MatrixXd X = make_X(A, rng);
+    Eigen::MatrixXf A_float = A.cast<float>();
+    double tolerance = float_tolerance(A, X);
+
+    SECTION("multiply") {
+        Eigen::MatrixXd expected = A * X;
+        analysis::multiply(A_float, X);
+
+        REQUIRE(max_deviation(A_float, A) > 100 * tolerance);
+        REQUIRE(max_deviation(A_float, expected) <= tolerance);
+    }
+
+    SECTION("row scaling") {
+        RowScaling row_scaling;
+        for (int row = 0; row < field_size; row++)
+            row_scaling.assign(row, std::exp(-row / 5000.0));
+
+        Eigen::MatrixXd expected = A;
+        row_scaling.multiply(expected, X);
+        row_scaling.multiply(A_float, X);
+
+        REQUIRE(max_deviation(A_float, expected) <= tolerance);
+    }
+
+    SECTION("size mismatch") {
+        Eigen::MatrixXd X_small = X.topLeftCorner(10, 10);
+        REQUIRE_THROWS_AS(analysis::multiply(A_float, X_small),
+                          std::invalid_argument);
+    }
+}
@@ -0,0 +1,104 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#include "catch2/catch.hpp"
+
+#include <ert/config/config_parser.hpp>
+#include <ert/config/config_snapshot.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace fs = std::filesystem;
+
+TEST_CASE("config snapshots follow the file content", "[config]") {
+    WITH_TMPDIR;
+    config_snapshot_clear();
+    {
+        std::ofstream stream("config");
+        stream << "KEY1 A B -- comment\n\nKEY2 \"C D\"\n";
+    }
+
+    REQUIRE(config_snapshot_load("config", "--") == nullptr);
+
+    auto lines = std::make_shared<config_token_lines>(
+        config_token_lines{{"KEY1", "A", "B"}, {"KEY2", "C D"}});
+    config_snapshot_store("config", "--", lines);
+    REQUIRE(config_snapshot_load("config", "--") == lines);
+    REQUIRE(config_snapshot_load("config", NULL) == nullptr);
+
+    WHEN("The file is modified") {
+        {
+            std::ofstream stream("config", std::ios::app);
+            stream << "KEY3 E\n";
+        }
+        THEN("The snapshot is no longer used") {
+            REQUIRE(config_snapshot_load("config", "--") == nullptr);
+        }
+    }
+
+    WHEN("The file is modified keeping the size and modification time") {
+        auto mtime = fs::last_write_time("config");
+        {
+            std::ofstream stream("config");
+            stream << "KEY1 X B -- comment\n\nKEY2 \"C D\"\n";
+        }
+        fs::last_write_time("config", mtime);
+        THEN("The snapshot is no longer used") {
+            REQUIRE(config_snapshot_load("config", "--") == nullptr);
+        }
+    }
+}
+
+TEST_CASE("config snapshots are stored in ERT_CONFIG_CACHE_DIR",
+          "[config]") {
+    WITH_TMPDIR;
+    config_snapshot_clear();
+    setenv("ERT_CONFIG_CACHE_DIR", "cache", 1);
+    {
+        std::ofstream stream("config");
+        stream << "KEY1 A B\n";
+    }
+
+    auto lines = std::make_shared<config_token_lines>(
+        config_token_lines{{"KEY1", "A", "B"}});
+    config_snapshot_store("config", "--", lines);
+    REQUIRE(!fs::is_empty("cache"));
+
+    config_snapshot_clear();
+    auto loaded = config_snapshot_load("config", "--");
+    REQUIRE(loaded != nullptr);
+    REQUIRE(*loaded == *lines);
+    unsetenv("ERT_CONFIG_CACHE_DIR");
+}
+
+TEST_CASE("parsing from a snapshot gives the same content", "[config]") {
+    WITH_TMPDIR;
+    config_snapshot_clear();
+    {
+        std::ofstream stream("include");
+        stream << "KEY2 <NAME> -- comment\n";
+    }
+    {
+        std::ofstream stream("config");
+        stream << "DEFINE <NAME> value\nKEY1 A B\nINCLUDE include\n";
+    }
+
+    config_parser_type *config = config_alloc();
+    config_add_schema_item(config, "KEY1", true);
+    config_add_schema_item(config, "KEY2", true);
+
+    for (int i = 0; i < 2; i++) {
+        config_content_type *content =
+            config_parse(config, "config", "--", "INCLUDE", "DEFINE", NULL,
+                         CONFIG_UNRECOGNIZED_ERROR, true);
+        REQUIRE(config_content_is_valid(content));
+        REQUIRE(config_content_iget(content, "KEY1", 0, 1) ==
+                std::string("B"));
+        REQUIRE(config_content_iget(content, "KEY2", 0, 0) ==
+                std::string("value"));
+        config_content_free(content);
+    }
+    REQUIRE(config_snapshot_load("include", "--") != nullptr);
+    config_free(config);
+}
@@ -1,5 +1,6 @@
 #include <filesystem>
 #include <fstream>
+#include <vector>
 
 #include "catch2/catch.hpp"
 
@@ -151,3 +152,128 @@ TEST_CASE("block_fs", "[enkf_fs]") {
         block_fs_close(bfs);
     }
 }
+
+TEST_CASE("block_fs copy", "[enkf_fs]") {
+    const int fsync_interval = 10;
+
+    std::vector<char> random(100000);
+    {
+        std::ifstream s{"/dev/urandom"};
+        s.read(random.data(), random.size());
+    }
+
+    GIVEN("Two read-write instances of block_fs") {
+        WITH_TMPDIR;
+        auto src = block_fs_mount("src", fsync_interval, false);
+        auto target = block_fs_mount("target", fsync_interval, false);
+        block_fs_fwrite_file(src, "FOO.0.1", random.data(), random.size());
+
+        WHEN("a file is copied between them") {
+            REQUIRE(block_fs_copy_file(src, "FOO.0.1", target, "FOO.0.1"));
+            REQUIRE(block_fs_copy_file(src, "FOO.0.1", src, "FOO.1.1"));
+            REQUIRE(!block_fs_copy_file(src, "BAR.0.1", target, "BAR.0.1"));
+
+            THEN("the copies have the same data after reopening") {
+                block_fs_close(src);
+                block_fs_close(target);
+                src = block_fs_mount("src", fsync_interval, true);
+                target = block_fs_mount("target", fsync_interval, true);
+
+                auto buf = buffer_alloc(100);
+                block_fs_fread_realloc_buffer(target, "FOO.0.1", buf);
+                REQUIRE(random.size() == buffer_get_size(buf));
+                REQUIRE(std::memcmp(random.data(), buffer_get_data(buf),
+                                    random.size()) == 0);
+
+                block_fs_fread_realloc_buffer(src, "FOO.1.1", buf);
+                REQUIRE(random.size() == buffer_get_size(buf));
+                REQUIRE(std::memcmp(random.data(), buffer_get_data(buf),
+                                    random.size()) == 0);
+                REQUIRE(!block_fs_has_file(target, "BAR.0.1"));
+                buffer_free(buf);
+            }
+        }
+
+        block_fs_close(target);
+        block_fs_close(src);
+    }
+}
+
+TEST_CASE("block_fs snapshot", "[enkf_fs]") {
+    const int fsync_interval = 10;
+    const std::string one = "one";
+    const std::string two = "two";
+
+    auto read = [](block_fs_type *bfs, const char *filename) {
+        auto buf = buffer_alloc(100);
+        block_fs_fread_realloc_buffer(bfs, filename, buf);
+        std::string data(static_cast<char *>(buffer_get_data(buf)),
+                         buffer_get_size(buf));
+        buffer_free(buf);
+        return data;
+    };
+
+    GIVEN("A block_fs with data and a snapshot of it") {
+        WITH_TMPDIR;
+        auto src = block_fs_mount("src", fsync_interval, false);
+        block_fs_fwrite_file(src, "FOO", one.data(), one.size());
+        block_fs_fwrite_file(src, "BAR", one.data(), one.size());
+
+        auto snapshot = block_fs_mount("snapshot", fsync_interval, false);
+        REQUIRE(block_fs_is_empty(snapshot));
+        block_fs_close(snapshot);
+        block_fs_snapshot(src, "snapshot");
+        snapshot = block_fs_mount("snapshot", fsync_interval, false);
+
+        THEN("the snapshot has the data") {
+            REQUIRE(!block_fs_is_empty(snapshot));
+            REQUIRE(read(snapshot, "FOO") == one);
+            REQUIRE(read(snapshot, "BAR") == one);
+        }
+
+        WHEN("both are written to after the snapshot") {
+            block_fs_fwrite_file(src, "FOO", two.data(), two.size());
+            block_fs_fwrite_file(src, "NEW", two.data(), two.size());
+            block_fs_fwrite_file(snapshot, "BAR", two.data(), two.size());
+
+            THEN("the writes are only seen by the one written to") {
+                block_fs_close(src);
+                block_fs_close(snapshot);
+                src = block_fs_mount("src", fsync_interval, true);
+                snapshot = block_fs_mount("snapshot", fsync_interval, true);
+
+                REQUIRE(read(src, "FOO") == two);
+                REQUIRE(read(src, "BAR") == one);
+                REQUIRE(read(snapshot, "FOO") == one);
+                REQUIRE(read(snapshot, "BAR") == two);
+                REQUIRE(!block_fs_has_file(snapshot, "NEW"));
+            }
+        }
+
+        WHEN("the source is removed and the snapshot is moved") {
+            block_fs_close(src);
+            block_fs_close(snapshot);
+            std::vector<std::filesystem::path> files;
+            for (const auto &entry : std::filesystem::directory_iterator("."))
+                files.push_back(entry.path().filename());
+
+            std::filesystem::create_directory("moved");
+            for (const auto &file : files) {
+                if (file.string().rfind("src", 0) == 0)
+                    std::filesystem::remove(file);
+                else if (file.string().rfind("snapshot", 0) == 0)
+                    std::filesystem::rename(file, "moved" / file);
+            }
+            src = block_fs_mount("src", fsync_interval, false);
+            snapshot = block_fs_mount("moved/snapshot", fsync_interval, true);
+
+            THEN("the snapshot still has the data") {
+                REQUIRE(read(snapshot, "FOO") == one);
+                REQUIRE(read(snapshot, "BAR") == one);
+            }
+        }
+
+        block_fs_close(snapshot);
+        block_fs_close(src);
+    }
+}
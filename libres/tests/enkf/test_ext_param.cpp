@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/util/stringlist.h>
+
+#include <ert/enkf/ext_param.hpp>
+#include <ert/enkf/ext_param_config.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace {
+const std::vector<std::string> suffixes = {"A", "B", "C"};
+
+/** @size keys, where every fourth key has the suffixes A, B and C */
+ext_param_config_type *alloc_config(int size) {
+    stringlist_type *keys = stringlist_alloc_new();
+    for (int ikey = 0; ikey < size; ikey++)
+        stringlist_append_copy(keys, ("KEY" + std::to_string(ikey)).c_str());
+    ext_param_config_type *config = ext_param_config_alloc("CONTROLS", keys);
+    stringlist_free(keys);
+
+    stringlist_type *suffix_list = stringlist_alloc_new();
+    for (const auto &suffix : suffixes)
+        stringlist_append_copy(suffix_list, suffix.c_str());
+    for (int ikey = 0; ikey < size; ikey += 4)
+        ext_param_config_ikey_set_suffixes(config, ikey, suffix_list);
+    stringlist_free(suffix_list);
+    return config;
+}
+
+/** Exactly representable with the %g format of ext_param_json_export */
+double value(int ikey, int isuffix) { return ikey * 10 + isuffix; }
+
+void set_by_key(ext_param_type *param, int size) {
+    for (int ikey = 0; ikey < size; ikey++) {
+        auto key = "KEY" + std::to_string(ikey);
+        if (ikey % 4 == 0)
+            for (size_t isuffix = 0; isuffix < suffixes.size(); isuffix++)
+                REQUIRE(ext_param_key_suffix_set(param, key.c_str(),
+                                                 suffixes[isuffix].c_str(),
+                                                 value(ikey, isuffix)));
+        else
+            REQUIRE(ext_param_key_set(param, key.c_str(), value(ikey, 0)));
+    }
+}
+} // namespace
+
+TEST_CASE("ext_param keys are looked up by name", "[enkf]") {
+    ext_param_config_type *config = alloc_config(8);
+
+    REQUIRE(ext_param_config_get_key_index(config, "KEY5") == 5);
+    REQUIRE(ext_param_config_has_key(config, "KEY7"));
+    REQUIRE(ext_param_config_get_key_index(config, "KEY8") == -1);
+    REQUIRE_FALSE(ext_param_config_has_key(config, "KEY"));
+
+    REQUIRE(ext_param_config_ikey_get_suffix_index(config, 4, "C") == 2);
+    REQUIRE(ext_param_config_ikey_get_suffix_index(config, 4, "D") == -1);
+    REQUIRE(ext_param_config_ikey_get_suffix_index(config, 5, "A") == -1);
+
+    ext_param_type *param = ext_param_alloc(config);
+    REQUIRE_FALSE(ext_param_key_set(param, "KEY8", 1.0));
+    REQUIRE_FALSE(ext_param_key_suffix_set(param, "KEY0", "D", 1.0));
+    ext_param_free(param);
+    ext_param_config_free(config);
+}
+
+TEST_CASE("ext_param values are set from a JSON file", "[enkf]") {
+    WITH_TMPDIR;
+    const int size = 20000;
+    ext_param_config_type *config = alloc_config(size);
+    ext_param_type *expected = ext_param_alloc(config);
+    set_by_key(expected, size);
+    ext_param_json_export(expected, "controls.json");
+
+    ext_param_type *param = ext_param_alloc(config);
+    REQUIRE(ext_param_set_from_json(param, "controls.json"));
+    for (int ikey = 0; ikey < size; ikey++) {
+        int suffix_count = ext_param_config_ikey_get_suffix_count(config, ikey);
+        for (int isuffix = 0; isuffix < std::max(suffix_count, 1); isuffix++) {
+            REQUIRE(ext_param_iiget(param, ikey, isuffix) ==
+                    ext_param_iiget(expected, ikey, isuffix));
+            REQUIRE(ext_param_iiget(param, ikey, isuffix) ==
+                    value(ikey, isuffix));
+        }
+    }
+
+    SECTION("invalid files are rejected") {
+        for (auto json : {"{\"KEY1\": 1, \"NOT_A_KEY\": 2}",
+                          "{\"KEY0\": {\"A\": 1, \"D\": 2}}",
+                          "{\"KEY0\": 1}", "{\"KEY1\": {\"A\": 1}}",
+                          "{\"KEY1\": \"one\"}", "[1, 2]", "{\"KEY1\": "}) {
+            INFO(json);
+            std::ofstream{"invalid.json"} << json;
+            REQUIRE_FALSE(ext_param_set_from_json(param, "invalid.json"));
+        }
+    }
+
+    SECTION("a missing file is rejected") {
+        REQUIRE_FALSE(ext_param_set_from_json(param, "missing.json"));
+    }
+
+    SECTION("values are set from JSON text") {
+        REQUIRE(ext_param_set_from_json_string(param, "{\"KEY1\": 2.5}"));
+        REQUIRE(ext_param_iiget(param, 1, 0) == 2.5);
+        REQUIRE(ext_param_iiget(param, 2, 0) == value(2, 0));
+        REQUIRE_FALSE(ext_param_set_from_json_string(param, "{\"KEY1\": "));
+    }
+
+    ext_param_free(param);
+    ext_param_free(expected);
+    ext_param_config_free(config);
+}
+
+TEST_CASE("ext_param key lookups find every key of a large config",
+          "[enkf]") {
+    const int size = 20000;
+    ext_param_config_type *config = alloc_config(size);
+
+    for (int ikey = 0; ikey < size; ikey++) {
+        auto key = "KEY" + std::to_string(ikey);
+        REQUIRE(ext_param_config_get_key_index(config, key.c_str()) == ikey);
+        for (size_t isuffix = 0; isuffix < suffixes.size(); isuffix++)
+            REQUIRE(ext_param_config_ikey_get_suffix_index(
+                        config, ikey, suffixes[isuffix].c_str()) ==
+                    (ikey % 4 == 0 ? (int)isuffix : -1));
+    }
+    REQUIRE(ext_param_config_get_key_index(config, "KEY20000") == -1);
+
+    ext_param_config_free(config);
+}
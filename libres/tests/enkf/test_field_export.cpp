@@ -0,0 +1,220 @@
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/ecl/ecl_endian_flip.h>
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/fortio.h>
+#include <ert/rms/rms_util.hpp>
+
+#include <ert/enkf/field.hpp>
+#include <ert/enkf/field_config.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace {
+constexpr int nx = 4;
+constexpr int ny = 3;
+constexpr int nz = 5;
+constexpr int volume = nx * ny * nz;
+
+ecl_grid_type *alloc_grid() {
+    std::vector<int> actnum(volume);
+    for (int index = 0; index < volume; index++)
+        actnum[index] = index % 3 == 1 ? 0 : 1;
+    return ecl_grid_alloc_rectangular(nx, ny, nz, 1, 1, 1, actnum.data());
+}
+
+std::vector<float> global_values(float offset) {
+    std::vector<float> values(volume);
+    for (int index = 0; index < volume; index++)
+        values[index] = offset + index * 0.25;
+    return values;
+}
+
+/** The export of the cell by cell lookups field_export3D used to do */
+std::vector<float> reference_export(const ecl_grid_type *grid,
+                                    const std::vector<float> &active_values,
+                                    bool rms_index_order, float fill,
+                                    const std::vector<float> *initial_values) {
+    std::vector<float> target(volume);
+    for (int k = 0; k < nz; k++)
+        for (int j = 0; j < ny; j++)
+            for (int i = 0; i < nx; i++) {
+                int active_index = ecl_grid_get_active_index3(grid, i, j, k);
+                int global_index = ecl_grid_get_global_index3(grid, i, j, k);
+                int target_index =
+                    rms_index_order
+                        ? rms_util_global_index_from_eclipse_ijk(nx, ny, nz, i,
+                                                                 j, k)
+                        : i + j * nx + k * nx * ny;
+                if (active_index >= 0)
+                    target[target_index] = active_values[active_index];
+                else if (initial_values)
+                    target[target_index] = (*initial_values)[global_index];
+                else
+                    target[target_index] = fill;
+            }
+    return target;
+}
+
+std::string read_file(const char *filename) {
+    std::ifstream stream{filename, std::ios::binary};
+    return {std::istreambuf_iterator<char>(stream),
+            std::istreambuf_iterator<char>()};
+}
+
+void write_grdecl(const char *filename, const char *key,
+                  const std::vector<float> &values) {
+    ecl_kw_type *ecl_kw =
+        ecl_kw_alloc_new(key, values.size(), ECL_FLOAT, values.data());
+    FILE *stream = fopen(filename, "w");
+    ecl_kw_fprintf_grdecl(ecl_kw, stream);
+    fclose(stream);
+    ecl_kw_free(ecl_kw);
+}
+} // namespace
+
+TEST_CASE("field export gathers through the index permutation",
+          "[enkf_field]") {
+    WITH_TMPDIR;
+    ecl_grid_type *grid = alloc_grid();
+    field_config_type *config =
+        field_config_alloc_empty("PORO", grid, NULL, false);
+    field_type *field = field_alloc(config);
+
+    int active_size = ecl_grid_get_active_size(grid);
+    std::vector<float> active_values(active_size);
+    for (int index = 0; index < active_size; index++)
+        active_values[index] = 100 + index;
+    {
+        ecl_kw_type *ecl_kw = ecl_kw_alloc_new("PORO", active_size, ECL_FLOAT,
+                                               active_values.data());
+        field_copy_ecl_kw_data(field, ecl_kw);
+        ecl_kw_free(ecl_kw);
+    }
+
+    float fill = -1;
+    for (bool rms_index_order : {false, true}) {
+        auto expected =
+            reference_export(grid, active_values, rms_index_order, fill, NULL);
+        std::vector<float> exported(volume);
+        field_export3D(field, exported.data(), rms_index_order, ECL_FLOAT,
+                       &fill, NULL);
+        REQUIRE(std::memcmp(exported.data(), expected.data(),
+                            volume * sizeof(float)) == 0);
+
+        std::vector<double> exported_double(volume);
+        double fill_double = fill;
+        field_export3D(field, exported_double.data(), rms_index_order,
+                       ECL_DOUBLE, &fill_double, NULL);
+        for (int index = 0; index < volume; index++)
+            REQUIRE(exported_double[index] == expected[index]);
+    }
+
+    SECTION("inactive cells are taken from the init file") {
+        auto initial_values = global_values(-50);
+        write_grdecl("init.grdecl", "PORO", initial_values);
+
+        for (bool rms_index_order : {false, true}) {
+            auto expected = reference_export(grid, active_values,
+                                             rms_index_order, fill,
+                                             &initial_values);
+            std::vector<float> exported(volume);
+            field_export3D(field, exported.data(), rms_index_order, ECL_FLOAT,
+                           &fill, "init.grdecl");
+            REQUIRE(std::memcmp(exported.data(), expected.data(),
+                                volume * sizeof(float)) == 0);
+        }
+    }
+
+    SECTION("GRDECL export is unchanged") {
+        field_export(field, "field.grdecl", NULL, ECL_GRDECL_FILE, false,
+                     NULL);
+        write_grdecl("expected.grdecl", "PORO",
+                     reference_export(grid, active_values, false, 0, NULL));
+        REQUIRE(read_file("field.grdecl") == read_file("expected.grdecl"));
+    }
+
+    SECTION("ECL_KW export is unchanged") {
+        field_export(field, "field.kw", NULL, ECL_KW_FILE_ALL_CELLS, false,
+                     NULL);
+        auto expected = reference_export(grid, active_values, false, 0, NULL);
+        fortio_type *fortio =
+            fortio_open_writer("expected.kw", false, ECL_ENDIAN_FLIP);
+        ecl_kw_fwrite_param_fortio(fortio, "PORO", ECL_FLOAT, volume,
+                                   expected.data());
+        fortio_fclose(fortio);
+        REQUIRE(read_file("field.kw") == read_file("expected.kw"));
+    }
+
+    SECTION("ROFF export and import round trips") {
+        field_export(field, "field.roff", NULL, RMS_ROFF_FILE, false, NULL);
+
+        field_type *loaded = field_alloc(config);
+        REQUIRE(field_fload(loaded, "field.roff"));
+        for (int index = 0; index < active_size; index++)
+            REQUIRE(field_iget_float(loaded, index) == active_values[index]);
+        field_free(loaded);
+
+        field_config_type *global_config =
+            field_config_alloc_empty("PORO", grid, NULL, true);
+        loaded = field_alloc(global_config);
+        REQUIRE(field_fload_rms(loaded, "field.roff", true));
+        for (int index = 0; index < volume; index++) {
+            int active_index = ecl_grid_get_active_index1(grid, index);
+            float expected = active_index >= 0 ? active_values[active_index]
+                                               : RMS_INACTIVE_FLOAT;
+            REQUIRE(field_iget_float(loaded, index) == expected);
+        }
+        field_free(loaded);
+        field_config_free(global_config);
+    }
+
+    field_free(field);
+    field_config_free(config);
+    ecl_grid_free(grid);
+}
+
+TEST_CASE("field import scatters through the index permutation",
+          "[enkf_field]") {
+    WITH_TMPDIR;
+    ecl_grid_type *grid = alloc_grid();
+    auto values = global_values(10);
+    write_grdecl("field.grdecl", "PORO", values);
+
+    SECTION("only the active cells are imported") {
+        field_config_type *config =
+            field_config_alloc_empty("PORO", grid, NULL, false);
+        field_type *field = field_alloc(config);
+        REQUIRE(field_fload(field, "field.grdecl"));
+
+        for (int global_index = 0; global_index < volume; global_index++) {
+            int active_index = ecl_grid_get_active_index1(grid, global_index);
+            if (active_index >= 0)
+                REQUIRE(field_iget_float(field, active_index) ==
+                        values[global_index]);
+        }
+        field_free(field);
+        field_config_free(config);
+    }
+
+    SECTION("inactive cells are kept") {
+        field_config_type *config =
+            field_config_alloc_empty("PORO", grid, NULL, true);
+        field_type *field = field_alloc(config);
+        REQUIRE(field_fload(field, "field.grdecl"));
+        for (int index = 0; index < volume; index++)
+            REQUIRE(field_iget_float(field, index) == values[index]);
+
+        field_free(field);
+        field_config_free(config);
+    }
+
+    ecl_grid_free(grid);
+}
@@ -0,0 +1,39 @@
+#include "catch2/catch.hpp"
+
+#include <vector>
+
+#include <ert/enkf/field_trans.hpp>
+
+TEST_CASE("array field transforms agree with the scalar transforms",
+          "[field_trans]") {
+    field_trans_table_type *table = field_trans_table_alloc();
+    const std::vector<float> input = {0.001f, 0.25f, 0.5f, 1.0f,  1.5f,
+                                      2.0f,   3.0f,  7.5f, 10.0f, 99.0f};
+
+    auto key = GENERATE("POW10", "TRUNC_POW10", "LOG", "LN", "LOG10", "EXP",
+                        "LN0", "EXP0", "NORMALIZE_PERMX", "denormalize_poro");
+    field_func_type *func = field_trans_table_lookup(table, key);
+    field_array_func_type *array_func =
+        field_trans_table_lookup_array(table, key);
+    REQUIRE(array_func != nullptr);
+
+    std::vector<float> data = input;
+    array_func(data.data(), data.size());
+    for (size_t i = 0; i < input.size(); i++)
+        REQUIRE(data[i] == Approx(func(input[i])));
+
+    field_trans_table_free(table);
+}
+
+TEST_CASE("transforms added without an array version have none",
+          "[field_trans]") {
+    field_trans_table_type *table = field_trans_table_alloc();
+    field_trans_table_add(
+        table, "SQUARE", "y = x*x", [](float x) { return x * x; }, nullptr);
+
+    REQUIRE(field_trans_table_has_key(table, "square"));
+    REQUIRE(field_trans_table_lookup(table, "SQUARE")(3.0f) == 9.0f);
+    REQUIRE(field_trans_table_lookup_array(table, "SQUARE") == nullptr);
+
+    field_trans_table_free(table);
+}
@@ -0,0 +1,85 @@
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/gen_common.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace {
+void write_file(const char *fname, const std::string &content) {
+    std::ofstream stream{fname};
+    stream << content;
+}
+} // namespace
+
+TEST_CASE("fparse loads the same values as fscanf", "[gen_common]") {
+    WITH_TMPDIR;
+    write_file("data",
+               " 1.5\n+2e3\t-3\n\n 4.25e-2  \n1e-300\n1e-320\n0x1p-3\n7");
+
+    int fscanf_size = 0;
+    auto *expected = static_cast<double *>(
+        gen_common_fscanf_alloc("data", ECL_DOUBLE, &fscanf_size));
+    int fparse_size = 0;
+    auto *values = static_cast<double *>(
+        gen_common_fparse_alloc("data", ECL_DOUBLE, &fparse_size));
+
+    REQUIRE(fparse_size == 8);
+    REQUIRE(fparse_size == fscanf_size);
+    for (int i = 0; i < fparse_size; i++)
+        REQUIRE(values[i] == expected[i]);
+
+    free(expected);
+    free(values);
+}
+
+TEST_CASE("fparse of a number at the very end of the file", "[gen_common]") {
+    WITH_TMPDIR;
+    write_file("data", "1 2 3.75");
+
+    int size = 0;
+    auto *values =
+        static_cast<float *>(gen_common_fparse_alloc("data", ECL_FLOAT, &size));
+    REQUIRE(size == 3);
+    REQUIRE(values[2] == 3.75f);
+    free(values);
+}
+
+TEST_CASE("fparse grows beyond the size hint", "[gen_common]") {
+    WITH_TMPDIR;
+    std::string content;
+    for (int i = 0; i < 1000; i++)
+        content += std::to_string(i) + "\n";
+    write_file("data", content);
+
+    int size = 10;
+    auto *values =
+        static_cast<float *>(gen_common_fparse_alloc("data", ECL_FLOAT, &size));
+    REQUIRE(size == 1000);
+    REQUIRE(values[999] == 999);
+    free(values);
+}
+
+TEST_CASE("fparse of empty file", "[gen_common]") {
+    WITH_TMPDIR;
+    write_file("data", "");
+
+    int size = 0;
+    free(gen_common_fparse_alloc("data", ECL_DOUBLE, &size));
+    REQUIRE(size == 0);
+}
+
+TEST_CASE("active mask is parsed from 0 and 1 integers", "[gen_common]") {
+    WITH_TMPDIR;
+    write_file("data_active", "1 0\n0\n   1\n1 1");
+
+    bool mask[4];
+    gen_common_fparse_active_mask("data_active", 4, mask);
+    REQUIRE(mask[0]);
+    REQUIRE_FALSE(mask[1]);
+    REQUIRE_FALSE(mask[2]);
+    REQUIRE(mask[3]);
+}
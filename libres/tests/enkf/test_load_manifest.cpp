@@ -0,0 +1,196 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/res_util/metric.hpp>
+#include <ert/util/int_vector.h>
+
+#include <ert/enkf/enkf_config_node.hpp>
+#include <ert/enkf/enkf_fs.hpp>
+#include <ert/enkf/enkf_state.hpp>
+#include <ert/enkf/ensemble_config.hpp>
+#include <ert/enkf/realization_manifest.hpp>
+#include <ert/enkf/run_arg.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr int ens_size = 4;
+
+std::string runpath(int iens) {
+    return (fs::current_path() / ("real-" + std::to_string(iens))).string();
+}
+
+void write_result(int iens, int size) {
+    fs::create_directories(runpath(iens));
+    std::ofstream stream{runpath(iens) + "/result_0.out"};
+    for (int i = 0; i < size; i++)
+        stream << iens + i * 0.5 << "\n";
+}
+
+std::uint64_t block_fs_writes() {
+    for (const auto &metric : ert::metrics::snapshot())
+        if (metric.name == "block_fs.write")
+            return metric.count;
+    return 0;
+}
+
+/** Loads all the realizations and returns the number of block_fs writes */
+std::uint64_t load_ensemble(enkf_fs_type *enkf_fs,
+                            ensemble_config_type *ensemble_config,
+                            model_config_type *model_config,
+                            const ecl_config_type *ecl_config, bool force) {
+    ert::metrics::reset();
+    for (int iens = 0; iens < ens_size; iens++) {
+        run_arg_type *run_arg = run_arg_alloc_ENSEMBLE_EXPERIMENT(
+            "run_id", enkf_fs, iens, 0, runpath(iens).c_str(), "job", NULL);
+        auto result = enkf_state_load_from_forward_model__(
+            ensemble_config, model_config, ecl_config, run_arg, force);
+        REQUIRE(result.first == LOAD_SUCCESSFUL);
+        REQUIRE(state_map_iget(enkf_fs_get_state_map(enkf_fs), iens) ==
+                STATE_HAS_DATA);
+        run_arg_free(run_arg);
+    }
+    return block_fs_writes();
+}
+} // namespace
+
+TEST_CASE("unchanged realizations are not loaded again", "[enkf]") {
+    WITH_TMPDIR;
+    auto mount_point = fs::current_path() / "storage";
+    enkf_fs_type *enkf_fs =
+        enkf_fs_create_fs(mount_point.c_str(), BLOCK_FS_DRIVER_ID, true);
+
+    ensemble_config_type *ensemble_config = ensemble_config_alloc_full("name");
+    int_vector_type *report_steps = int_vector_alloc(0, 0);
+    int_vector_append(report_steps, 0);
+    ensemble_config_add_node(ensemble_config,
+                             enkf_config_node_alloc_GEN_DATA_full(
+                                 "RESULT", "result_%d.out", ASCII, report_steps,
+                                 NULL, NULL, NULL, NULL));
+    model_config_type *model_config = model_config_alloc_empty();
+    ecl_config_type *ecl_config = ecl_config_alloc(NULL);
+
+    for (int iens = 0; iens < ens_size; iens++)
+        write_result(iens, 10);
+
+    auto load = [&](bool force) {
+        return load_ensemble(enkf_fs, ensemble_config, model_config,
+                             ecl_config, force);
+    };
+    auto first_load = load(false);
+    REQUIRE(first_load > 0);
+    REQUIRE(load(false) == 0);
+
+    SECTION("changed realizations are loaded again") {
+        write_result(1, 12);
+        auto writes = load(false);
+        REQUIRE(writes > 0);
+        REQUIRE(writes < first_load);
+        REQUIRE(load(false) == 0);
+    }
+
+    SECTION("files the loaders do not read are not checked") {
+        std::ofstream{runpath(1) + "/unrelated"} << "content";
+        REQUIRE(load(false) == 0);
+    }
+
+    SECTION("a changed result file is loaded again") {
+        ensemble_config_type *other_config = ensemble_config_alloc_full("name");
+        ensemble_config_add_node(other_config,
+                                 enkf_config_node_alloc_GEN_DATA_full(
+                                     "RESULT", "copy_%d.out", ASCII,
+                                     report_steps, NULL, NULL, NULL, NULL));
+        for (int iens = 0; iens < ens_size; iens++)
+            fs::copy_file(runpath(iens) + "/result_0.out",
+                          runpath(iens) + "/copy_0.out");
+
+        REQUIRE(load_ensemble(enkf_fs, other_config, model_config, ecl_config,
+                              false) > 0);
+        REQUIRE(load_ensemble(enkf_fs, other_config, model_config, ecl_config,
+                              false) == 0);
+        ensemble_config_free(other_config);
+    }
+
+    SECTION("force loads all the realizations") {
+        REQUIRE(load(true) == first_load);
+    }
+
+    SECTION("realizations without data are loaded again") {
+        state_map_iset(enkf_fs_get_state_map(enkf_fs), 2, STATE_LOAD_FAILURE);
+        REQUIRE(load(false) > 0);
+    }
+
+    SECTION("the manifest is stored in the case") {
+        enkf_fs_fsync(enkf_fs);
+        enkf_fs_decref(enkf_fs);
+        enkf_fs = enkf_fs_mount(mount_point.c_str());
+        REQUIRE(load(false) == 0);
+
+        // Same size, only the modification time differs
+        auto result_file = runpath(3) + "/result_0.out";
+        fs::last_write_time(result_file, fs::last_write_time(result_file) +
+                                             std::chrono::seconds(10));
+        REQUIRE(load(false) > 0);
+    }
+
+    int_vector_free(report_steps);
+    ecl_config_free(ecl_config);
+    model_config_free(model_config);
+    ensemble_config_free(ensemble_config);
+    enkf_fs_decref(enkf_fs);
+}
+
+TEST_CASE("realization manifest compares the runpath files", "[enkf]") {
+    WITH_TMPDIR;
+    write_result(0, 10);
+    fs::create_directories(runpath(0) + "/sub");
+    std::ofstream{runpath(0) + "/sub/file"} << "content";
+
+    auto rp = runpath(0);
+    std::vector<std::string> paths{"sub/file", "result_0.out", "missing",
+                                   "sub/file"};
+    auto files = realization_manifest_stat(rp.c_str(), paths);
+    REQUIRE(files.size() == 3);
+    REQUIRE(files[0].path == "missing");
+    REQUIRE(files[0].size == -1);
+    REQUIRE(files[1].path == "result_0.out");
+    REQUIRE(files[2].path == "sub/file");
+    REQUIRE(files[2].size == 7);
+
+    realization_manifest_type *manifest = realization_manifest_alloc();
+    REQUIRE_FALSE(
+        realization_manifest_is_current(manifest, 0, rp.c_str(), "A", files));
+    realization_manifest_iset(manifest, 0, rp.c_str(), "A", files);
+    REQUIRE(
+        realization_manifest_is_current(manifest, 0, rp.c_str(), "A", files));
+    REQUIRE_FALSE(
+        realization_manifest_is_current(manifest, 1, rp.c_str(), "A", files));
+    REQUIRE_FALSE(
+        realization_manifest_is_current(manifest, 0, rp.c_str(), "B", files));
+    REQUIRE_FALSE(
+        realization_manifest_is_current(manifest, 0, "other", "A", files));
+
+    realization_manifest_fwrite(manifest, "manifest");
+    realization_manifest_type *copy = realization_manifest_alloc();
+    realization_manifest_fread(copy, "manifest");
+    REQUIRE(realization_manifest_is_current(copy, 0, rp.c_str(), "A", files));
+
+    std::ofstream{runpath(0) + "/missing"} << "";
+    auto changed = realization_manifest_stat(rp.c_str(), paths);
+    REQUIRE_FALSE(
+        realization_manifest_is_current(copy, 0, rp.c_str(), "A", changed));
+
+    realization_manifest_clear(copy, 0);
+    REQUIRE_FALSE(
+        realization_manifest_is_current(copy, 0, rp.c_str(), "A", files));
+
+    realization_manifest_free(copy);
+    realization_manifest_free(manifest);
+}
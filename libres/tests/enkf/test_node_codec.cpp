@@ -0,0 +1,113 @@
+#include "catch2/catch.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <ert/enkf/node_codec.hpp>
+
+namespace {
+/** A smooth, porosity like field with some noise. */
+std::vector<float> smooth_field(int size) {
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0.0, 0.002);
+    std::vector<float> field(size);
+    for (int index = 0; index < size; index++)
+        field[index] = 0.2 + 0.05 * std::sin(index / 100.0) + noise(rng);
+    return field;
+}
+
+std::vector<char> lz_roundtrip(const void *data, size_t byte_size) {
+    std::vector<char> compressed = node_codec_lz_compress(data, byte_size);
+    std::vector<char> result(byte_size);
+    REQUIRE(node_codec_lz_decompress(compressed.data(), compressed.size(),
+                                     result.data(), byte_size));
+    return result;
+}
+} // namespace
+
+TEST_CASE("codec names are parsed", "[node_codec]") {
+    node_codec_spec spec = node_codec_parse("lz+shuffle");
+    REQUIRE(spec.codec == node_codec_type::lz);
+    REQUIRE(spec.shuffle);
+    REQUIRE(node_codec_name(spec) == "lz+shuffle");
+
+    spec = node_codec_parse("none");
+    REQUIRE(spec.codec == node_codec_type::none);
+    REQUIRE_FALSE(spec.shuffle);
+
+    REQUIRE_THROWS_AS(node_codec_parse("lzma"), std::invalid_argument);
+    REQUIRE_THROWS_AS(node_codec_parse("+shuffle"), std::invalid_argument);
+}
+
+TEST_CASE("byte shuffle is reversible", "[node_codec]") {
+    std::vector<char> data(4 * 1001 + 3);
+    for (size_t index = 0; index < data.size(); index++)
+        data[index] = char(index * 7);
+
+    std::vector<char> shuffled(data.size());
+    std::vector<char> result(data.size());
+    node_codec_shuffle(data.data(), shuffled.data(), 4, data.size());
+    node_codec_unshuffle(shuffled.data(), result.data(), 4, data.size());
+
+    REQUIRE(shuffled[1] == data[4]);
+    REQUIRE(shuffled[1001] == data[1]);
+    REQUIRE(result == data);
+}
+
+TEST_CASE("lz compression round trips", "[node_codec]") {
+    SECTION("empty") {
+        std::vector<char> compressed = node_codec_lz_compress(nullptr, 0);
+        REQUIRE(node_codec_lz_decompress(compressed.data(), compressed.size(),
+                                         nullptr, 0));
+    }
+
+    SECTION("short and incompressible") {
+        std::mt19937 rng(1);
+        for (size_t size : {1, 3, 4, 5, 15, 16, 300, 70000}) {
+            std::vector<char> data(size);
+            for (auto &byte : data)
+                byte = char(rng());
+            REQUIRE(lz_roundtrip(data.data(), size) == data);
+        }
+    }
+
+    SECTION("long runs and matches far apart") {
+        std::vector<char> data(200000, 'a');
+        for (size_t index = 0; index < data.size(); index += 1000)
+            data[index] = char(index / 1000);
+        REQUIRE(lz_roundtrip(data.data(), data.size()) == data);
+        REQUIRE(node_codec_lz_compress(data.data(), data.size()).size() <
+                data.size() / 10);
+    }
+
+    SECTION("shuffled field") {
+        std::vector<float> field = smooth_field(100000);
+        size_t byte_size = field.size() * sizeof(float);
+        std::vector<char> shuffled(byte_size);
+        node_codec_shuffle(field.data(), shuffled.data(), sizeof(float),
+                           byte_size);
+
+        auto plain = node_codec_lz_compress(field.data(), byte_size);
+        auto compressed = node_codec_lz_compress(shuffled.data(), byte_size);
+        REQUIRE(compressed.size() < plain.size());
+        REQUIRE(lz_roundtrip(shuffled.data(), byte_size) == shuffled);
+    }
+}
+
+TEST_CASE("corrupt lz data is rejected", "[node_codec]") {
+    std::vector<char> data(10000, 'x');
+    std::vector<char> compressed =
+        node_codec_lz_compress(data.data(), data.size());
+    std::vector<char> result(data.size());
+
+    REQUIRE_FALSE(node_codec_lz_decompress(
+        compressed.data(), compressed.size() - 1, result.data(), data.size()));
+    REQUIRE_FALSE(node_codec_lz_decompress(
+        compressed.data(), compressed.size(), result.data(), data.size() - 1));
+
+    // A match pointing before the start of the output
+    const char bad[] = {0x10, 'a', 0x05, 0x00};
+    REQUIRE_FALSE(node_codec_lz_decompress(bad, sizeof bad, result.data(), 5));
+}
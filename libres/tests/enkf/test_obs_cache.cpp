@@ -0,0 +1,79 @@
+#include <filesystem>
+#include <fstream>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/obs_cache.hpp>
+
+#include "../tmpdir.hpp"
+
+TEST_CASE("history observation cache round trip", "[obs_cache]") {
+    WITH_TMPDIR;
+    HistoryObsCache cache(42);
+    cache.set("FOPR", {true, {1, 2, 5}, {10.0, 20.0, 50.0}, {1.0, 2.0, 5.0}});
+    cache.set("WWCT", {false});
+    REQUIRE(cache.save("obs.cache"));
+
+    GIVEN("A cache with the same key") {
+        HistoryObsCache loaded(42);
+        REQUIRE(loaded.load("obs.cache"));
+
+        const auto *fopr = loaded.get("FOPR");
+        REQUIRE(fopr != nullptr);
+        REQUIRE(fopr->valid);
+        REQUIRE(fopr->step == std::vector<int>{1, 2, 5});
+        REQUIRE(fopr->value == std::vector<double>{10.0, 20.0, 50.0});
+        REQUIRE(fopr->stddev == std::vector<double>{1.0, 2.0, 5.0});
+
+        const auto *wwct = loaded.get("WWCT");
+        REQUIRE(wwct != nullptr);
+        REQUIRE_FALSE(wwct->valid);
+        REQUIRE(loaded.get("GOPR") == nullptr);
+    }
+
+    GIVEN("A cache with a different key") {
+        HistoryObsCache loaded(43);
+        REQUIRE_FALSE(loaded.load("obs.cache"));
+    }
+
+    GIVEN("A truncated cache file") {
+        std::ofstream stream("obs.cache", std::ios::binary | std::ios::trunc);
+        stream << "ERTHOBS1";
+        stream.close();
+
+        HistoryObsCache loaded(42);
+        REQUIRE_FALSE(loaded.load("obs.cache"));
+    }
+}
+
+TEST_CASE("saving the cache creates the directory and leaves no temp files",
+          "[obs_cache]") {
+    WITH_TMPDIR;
+    HistoryObsCache cache(42);
+    cache.set("FOPR", {true, {1}, {10.0}, {1.0}});
+    REQUIRE(cache.save("storage/obs.cache"));
+    REQUIRE(cache.save("storage/obs.cache"));
+
+    std::vector<std::string> files;
+    for (const auto &entry : std::filesystem::directory_iterator("storage"))
+        files.push_back(entry.path().filename().string());
+    REQUIRE(files == std::vector<std::string>{"obs.cache"});
+
+    HistoryObsCache loaded(42);
+    REQUIRE(loaded.load("storage/obs.cache"));
+}
+
+TEST_CASE("hashing files depends on the content", "[obs_cache]") {
+    WITH_TMPDIR;
+    std::ofstream("a.txt") << "OBS A";
+    std::ofstream("b.txt") << "OBS B";
+
+    std::uint64_t hash_a = obs_cache_hash_bytes(nullptr, 0, 0);
+    std::uint64_t hash_b = hash_a;
+    REQUIRE(obs_cache_hash_file("a.txt", hash_a));
+    REQUIRE(obs_cache_hash_file("b.txt", hash_b));
+    REQUIRE(hash_a != hash_b);
+
+    std::uint64_t hash = 0;
+    REQUIRE_FALSE(obs_cache_hash_file("does_not_exist.txt", hash));
+}
@@ -0,0 +1,149 @@
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/enkf_config_node.hpp>
+#include <ert/enkf/enkf_fs.hpp>
+#include <ert/enkf/enkf_node.hpp>
+#include <ert/enkf/enkf_plot_data.hpp>
+#include <ert/enkf/ensemble_config.hpp>
+#include <ert/enkf/gen_kw.hpp>
+#include <ert/enkf/summary.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace {
+constexpr int ens_size = 6;
+constexpr int step_count = 8;
+/** The realization which has no data */
+constexpr int failed_iens = 3;
+
+/**
+   A case with a summary vector FOPR and a GEN_KW parameter TEST with the
+   keywords COEFF and OTHER. The summary vectors have a hole at step 2 and
+   realization 1 only has data up to step 4.
+*/
+void store_ensemble(enkf_fs_type *fs, const enkf_config_node_type *summary,
+                    const enkf_config_node_type *gen_kw) {
+    time_map_type *time_map = enkf_fs_get_time_map(fs);
+    for (int step = 0; step < step_count; step++)
+        time_map_update(time_map, step, 1000000 + step * 86400);
+
+    state_map_type *state_map = enkf_fs_get_state_map(fs);
+    enkf_node_type *gen_kw_node = enkf_node_alloc(gen_kw);
+    for (int iens = 0; iens < ens_size; iens++) {
+        enkf_node_type *summary_node = enkf_node_alloc(summary);
+        auto *summary_data =
+            static_cast<summary_type *>(enkf_node_value_ptr(summary_node));
+        int size = iens == 1 ? 5 : step_count;
+        for (int step = 0; step < size; step++)
+            summary_set(summary_data, step,
+                        step == 2 ? summary_undefined_value()
+                                  : iens * 100 + step);
+        enkf_node_store_vector(summary_node, fs, iens);
+        enkf_node_free(summary_node);
+
+        auto *gen_kw_data =
+            static_cast<gen_kw_type *>(enkf_node_value_ptr(gen_kw_node));
+        gen_kw_data_iset(gen_kw_data, 0, iens * 0.25 - 0.5);
+        gen_kw_data_iset(gen_kw_data, 1, 1 - iens * 0.5);
+        enkf_node_store(gen_kw_node, fs, {.report_step = 0, .iens = iens});
+
+        state_map_iset(state_map, iens,
+                       iens == failed_iens ? STATE_LOAD_FAILURE
+                                           : STATE_HAS_DATA);
+    }
+    enkf_node_free(gen_kw_node);
+}
+
+/** Checks the matrix loader against enkf_plot_data_load() */
+void require_same_as_plot_data(const enkf_config_node_type *config_node,
+                               enkf_fs_type *fs, const char *index_key) {
+    REQUIRE(enkf_plot_data_get_step_count(fs) == step_count);
+    std::vector<double> matrix(ens_size * step_count);
+    enkf_plot_data_load_matrix(config_node, fs, index_key, matrix.data());
+
+    enkf_plot_data_type *plot_data = enkf_plot_data_alloc(config_node);
+    enkf_plot_data_load(plot_data, fs, index_key);
+    REQUIRE(enkf_plot_data_get_size(plot_data) == ens_size);
+
+    int active_count = 0;
+    for (int iens = 0; iens < ens_size; iens++) {
+        const auto *vector = enkf_plot_data_iget(plot_data, iens);
+        for (int step = 0; step < step_count; step++) {
+            double value = matrix[iens * step_count + step];
+            INFO("iens:" << iens << " step:" << step);
+            if (step < enkf_plot_tvector_size(vector) &&
+                enkf_plot_tvector_iget_active(vector, step)) {
+                REQUIRE(value == enkf_plot_tvector_iget_value(vector, step));
+                active_count++;
+            } else
+                REQUIRE(std::isnan(value));
+        }
+    }
+    REQUIRE(active_count > 0);
+    enkf_plot_data_free(plot_data);
+}
+} // namespace
+
+TEST_CASE("the plot data matrix has the values of enkf_plot_data_load",
+          "[enkf_plot_data]") {
+    WITH_TMPDIR;
+    auto file_path = std::filesystem::current_path() / "storage";
+    enkf_fs_type *fs =
+        enkf_fs_create_fs(file_path.c_str(), BLOCK_FS_DRIVER_ID, true);
+
+    ensemble_config_type *ensemble_config = ensemble_config_alloc_full("name");
+    enkf_config_node_type *summary =
+        ensemble_config_add_summary(ensemble_config, "FOPR", LOAD_FAIL_SILENT);
+    enkf_config_node_type *gen_kw =
+        ensemble_config_add_gen_kw(ensemble_config, "TEST", false);
+    std::ofstream{"template"} << "<COEFF> <OTHER>\n";
+    std::ofstream{"param"} << "COEFF UNIFORM 0 1\nOTHER NORMAL 2 0.5\n";
+    enkf_config_node_update_gen_kw(gen_kw, "test.txt", "template", "param",
+                                   nullptr, nullptr);
+    store_ensemble(fs, summary, gen_kw);
+
+    SECTION("SUMMARY") {
+        require_same_as_plot_data(summary, fs, NULL);
+
+        std::vector<double> matrix(ens_size * step_count);
+        enkf_plot_data_load_matrix(summary, fs, NULL, matrix.data());
+        REQUIRE(matrix[5 * step_count + 7] == 507);
+        REQUIRE(std::isnan(matrix[5 * step_count + 2]));
+        REQUIRE(std::isnan(matrix[1 * step_count + 6]));
+        REQUIRE(std::isnan(matrix[failed_iens * step_count]));
+    }
+
+    SECTION("SUMMARY for some realizations") {
+        std::vector<double> matrix(ens_size * step_count);
+        enkf_plot_data_load_matrix(summary, fs, NULL, matrix.data());
+
+        std::vector<int> realizations{5, failed_iens, 0, ens_size};
+        std::vector<double> rows(realizations.size() * step_count);
+        enkf_plot_data_load_matrix(summary, fs, NULL, realizations,
+                                   rows.data());
+        for (int step = 0; step < step_count; step++) {
+            INFO("step:" << step);
+            REQUIRE(std::isnan(rows[1 * step_count + step]));
+            REQUIRE(std::isnan(rows[3 * step_count + step]));
+            for (int row : {0, 2}) {
+                double value = matrix[realizations[row] * step_count + step];
+                double row_value = rows[row * step_count + step];
+                REQUIRE((row_value == value ||
+                         (std::isnan(row_value) && std::isnan(value))));
+            }
+        }
+    }
+
+    SECTION("GEN_KW") {
+        require_same_as_plot_data(gen_kw, fs, "COEFF");
+        require_same_as_plot_data(gen_kw, fs, "OTHER");
+    }
+
+    ensemble_config_free(ensemble_config);
+    enkf_fs_decref(fs);
+}
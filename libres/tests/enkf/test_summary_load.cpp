@@ -0,0 +1,118 @@
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_tstep.h>
+#include <ert/util/int_vector.h>
+
+#include <ert/enkf/summary.hpp>
+#include <ert/enkf/summary_config.hpp>
+
+namespace {
+/** The value of @key at ministep @ministep of the synthetic case */
+double value(int key, int ministep) { return 100 * key + ministep; }
+
+/**
+   A case with FOPR and WOPR:OP1 and two ministeps for each of the report
+   steps 1, 2 and 4; report step 3 is missing.
+*/
+ecl_sum_type *alloc_ecl_sum() {
+    ecl_sum_type *ecl_sum = ecl_sum_alloc_writer("CASE", false, true, ":", 0,
+                                                 true, 10, 10, 10);
+    ecl_sum_add_var(ecl_sum, "FOPR", NULL, 0, "SM3/DAY", 0);
+    ecl_sum_add_var(ecl_sum, "WOPR", "OP1", 0, "SM3/DAY", 0);
+
+    int ministep = 0;
+    for (int report_step : {1, 2, 4})
+        for (int i = 0; i < 2; i++) {
+            double sim_seconds = (ministep + 1) * 86400.0;
+            ecl_sum_tstep_type *tstep =
+                ecl_sum_add_tstep(ecl_sum, report_step, sim_seconds);
+            ecl_sum_tstep_set_from_key(tstep, "FOPR", value(0, ministep));
+            ecl_sum_tstep_set_from_key(tstep, "WOPR:OP1", value(1, ministep));
+            ministep++;
+        }
+    return ecl_sum;
+}
+
+/** Stores the report steps 1 to 4 at the same index, skipping step 0 */
+int_vector_type *alloc_time_index() {
+    int_vector_type *time_index = int_vector_alloc(0, -1);
+    for (int report_step : {-1, 1, 2, 3, 4})
+        int_vector_append(time_index, report_step);
+    return time_index;
+}
+
+std::vector<double> data(const summary_type *summary) {
+    std::vector<double> values;
+    for (int i = 0; i < summary_length(summary); i++)
+        values.push_back(summary_get(summary, i));
+    return values;
+}
+} // namespace
+
+TEST_CASE("all summary keys are loaded in one pass", "[summary]") {
+    ecl_sum_type *ecl_sum = alloc_ecl_sum();
+    int_vector_type *time_index = alloc_time_index();
+    const double undef = summary_undefined_value();
+
+    load_fail_type load_fail = GENERATE(LOAD_FAIL_SILENT, LOAD_FAIL_WARN);
+    std::vector<summary_config_type *> configs;
+    std::vector<summary_type *> summaries;
+    for (auto key : {"FOPR", "WOPR:OP1", "WOPR:MISSING"}) {
+        configs.push_back(summary_config_alloc(key, load_fail));
+        summaries.push_back(summary_alloc(configs.back()));
+    }
+
+    REQUIRE(summary_forward_load_vectors(summaries, ecl_sum, time_index));
+
+    /* The last ministep of each report step; step 3 is left undefined */
+    REQUIRE(data(summaries[0]) ==
+            std::vector<double>{undef, value(0, 1), value(0, 3), undef,
+                                value(0, 5)});
+    REQUIRE(data(summaries[1]) ==
+            std::vector<double>{undef, value(1, 1), value(1, 3), undef,
+                                value(1, 5)});
+    /* A missing key is filled with zeros */
+    REQUIRE(data(summaries[2]) == std::vector<double>{undef, 0, 0, 0, 0});
+
+    SECTION("loading one key gives the same values") {
+        summary_type *summary = summary_alloc(configs[1]);
+        REQUIRE(summary_forward_load_vectors({summary}, ecl_sum, time_index));
+        REQUIRE(data(summary) == data(summaries[1]));
+        summary_free(summary);
+    }
+
+    for (size_t i = 0; i < summaries.size(); i++) {
+        summary_free(summaries[i]);
+        summary_config_free(configs[i]);
+    }
+    int_vector_free(time_index);
+    ecl_sum_free(ecl_sum);
+}
+
+TEST_CASE("summary keys with LOAD_FAIL_EXIT fail the load", "[summary]") {
+    ecl_sum_type *ecl_sum = alloc_ecl_sum();
+    int_vector_type *time_index = alloc_time_index();
+    summary_config_type *silent =
+        summary_config_alloc("FOPR", LOAD_FAIL_SILENT);
+    summary_config_type *failing =
+        summary_config_alloc("FOPR", LOAD_FAIL_EXIT);
+    summary_type *loaded = summary_alloc(silent);
+    summary_type *failed = summary_alloc(failing);
+
+    REQUIRE_FALSE(
+        summary_forward_load_vectors({loaded, failed}, ecl_sum, time_index));
+    REQUIRE(summary_length(loaded) == 5);
+    REQUIRE(summary_length(failed) == 0);
+
+    REQUIRE_FALSE(summary_forward_load_vectors({loaded}, NULL, time_index));
+
+    summary_free(failed);
+    summary_free(loaded);
+    summary_config_free(failing);
+    summary_config_free(silent);
+    int_vector_free(time_index);
+    ecl_sum_free(ecl_sum);
+}
@@ -0,0 +1,107 @@
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/obs_vector.hpp>
+#include <ert/enkf/summary_obs.hpp>
+
+TEST_CASE("summary observations are stored sorted on report step",
+          "[summary_obs]") {
+    SummaryObsStore store("FOPR", "FOPR");
+    store.add(10, 1.0, 0.1);
+    store.add(2, 2.0, 0.2);
+    store.add(5, 3.0, 0.3);
+    store.add(2, 4.0, 0.4);
+
+    REQUIRE(store.size() == 3);
+    REQUIRE(store.step == std::vector<int>{2, 5, 10});
+    REQUIRE(store.value == std::vector<double>{4.0, 3.0, 1.0});
+    REQUIRE(store.stddev == std::vector<double>{0.4, 0.3, 0.1});
+    REQUIRE(store.find(5) == 1);
+    REQUIRE(store.find(6) == -1);
+}
+
+TEST_CASE("installed summary observations are views into the obs_vector",
+          "[summary_obs]") {
+    obs_vector_type *obs_vector =
+        obs_vector_alloc(SUMMARY_OBS, "WOPR:OP_1", NULL, 10);
+
+    summary_obs_type *obs5 = summary_obs_alloc("WOPR:OP_1", "X", 5.0, 0.5);
+    summary_obs_type *obs2 = summary_obs_alloc("WOPR:OP_1", "X", 2.0, 0.2);
+    summary_obs_set_std_scale(obs2, 2.0);
+    obs_vector_install_node(obs_vector, 5, obs5);
+    obs_vector_install_node(obs_vector, 2, obs2);
+
+    REQUIRE(obs_vector_get_num_active(obs_vector) == 2);
+    REQUIRE(obs_vector_get_step_list(obs_vector) == std::vector<int>{2, 5});
+    REQUIRE(obs_vector_get_next_active_step(obs_vector, 2) == 5);
+    REQUIRE(obs_vector_get_next_active_step(obs_vector, 5) == -1);
+    REQUIRE(obs_vector_iget_active(obs_vector, 2));
+    REQUIRE_FALSE(obs_vector_iget_active(obs_vector, 3));
+
+    const SummaryObsStore *store = obs_vector_get_summary_obs(obs_vector);
+    REQUIRE(store->obs_key == "WOPR:OP_1");
+    REQUIRE(store->key(0) == "X");
+    REQUIRE(store->key(1) == "X");
+    REQUIRE(store->value == std::vector<double>{2.0, 5.0});
+    REQUIRE(store->std_scaling == std::vector<double>{2.0, 1.0});
+
+    REQUIRE(summary_obs_is_view(obs5));
+    summary_obs_set_std_scale(obs5, 3.0);
+    REQUIRE(store->std_scaling[1] == 3.0);
+
+    auto node = static_cast<summary_obs_type *>(
+        obs_vector_iget_node(obs_vector, 2));
+    REQUIRE(node == obs2);
+    REQUIRE(summary_obs_get_value(node) == 2.0);
+    REQUIRE(obs_vector_iget_node(obs_vector, 3) == nullptr);
+
+    obs_vector_free(obs_vector);
+}
+
+TEST_CASE("summary observations keep their own observation key",
+          "[summary_obs]") {
+    obs_vector_type *obs_vector =
+        obs_vector_alloc(SUMMARY_OBS, "FOPR", NULL, 10);
+    obs_vector_add_summary_obs(obs_vector, 1, "FOPR", "FOPR", 1.0, 0.1);
+    obs_vector_add_summary_obs(obs_vector, 3, "FOPR", "FOPR_3", 3.0, 0.3);
+    obs_vector_install_node(obs_vector, 2,
+                            summary_obs_alloc("FOPR", "FOPR_2", 2.0, 0.2));
+
+    const SummaryObsStore *store = obs_vector_get_summary_obs(obs_vector);
+    REQUIRE(store->key(store->find(1)) == "FOPR");
+    REQUIRE(store->key(store->find(2)) == "FOPR_2");
+    REQUIRE(store->key(store->find(3)) == "FOPR_3");
+
+    obs_vector_add_summary_obs(obs_vector, 3, "FOPR", "FOPR", 3.0, 0.3);
+    REQUIRE(store->key(store->find(3)) == "FOPR");
+
+    obs_vector_free(obs_vector);
+}
+
+TEST_CASE("summary observation views are shared by concurrent getters",
+          "[summary_obs]") {
+    const int num_steps = 100;
+    obs_vector_type *obs_vector =
+        obs_vector_alloc(SUMMARY_OBS, "FOPR", NULL, num_steps);
+    for (int step = 0; step < num_steps; step++)
+        obs_vector_add_summary_obs(obs_vector, step, "FOPR", "FOPR", step, 1);
+
+    std::vector<std::vector<void *>> nodes(4);
+    std::vector<std::thread> threads;
+    for (auto &thread_nodes : nodes)
+        threads.emplace_back([&] {
+            for (int step = 0; step < num_steps; step++)
+                thread_nodes.push_back(obs_vector_iget_node(obs_vector, step));
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    for (const auto &thread_nodes : nodes)
+        REQUIRE(thread_nodes == nodes[0]);
+    REQUIRE(summary_obs_get_value(static_cast<summary_obs_type *>(
+                nodes[0][7])) == 7.0);
+
+    obs_vector_free(obs_vector);
+}
@@ -0,0 +1,66 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/util/stringlist.h>
+
+#include <ert/enkf/trans_func.hpp>
+
+namespace {
+trans_func_type *alloc_trans_func(const std::vector<std::string> &args) {
+    stringlist_type *stringlist = stringlist_alloc_new();
+    for (const auto &arg : args)
+        stringlist_append_copy(stringlist, arg.c_str());
+    trans_func_type *trans_func = trans_func_alloc(stringlist);
+    stringlist_free(stringlist);
+    return trans_func;
+}
+
+std::vector<double> normal_values(size_t size) {
+    std::mt19937 generator(42);
+    std::normal_distribution<double> normal;
+    std::vector<double> values(size);
+    for (auto &value : values)
+        value = normal(generator);
+    /* The tails and the points where the transformations switch branch */
+    values.insert(values.end(), {-8.0, -3.0, 0.0, 3.0, 8.0, -0.0});
+    return values;
+}
+} // namespace
+
+TEST_CASE("trans_func_eval_many agrees with trans_func_eval", "[enkf]") {
+    auto args = GENERATE(as<std::vector<std::string>>{},
+                         std::vector<std::string>{"NORMAL", "1.5", "0.25"},
+                         std::vector<std::string>{"LOGNORMAL", "0.5", "1.25"},
+                         std::vector<std::string>{"UNIFORM", "-2", "5"},
+                         std::vector<std::string>{"LOGUNIF", "0.01", "100"},
+                         std::vector<std::string>{"TRIANGULAR", "1", "2", "4"},
+                         std::vector<std::string>{"ERRF", "-1", "3", "0.5",
+                                                  "0.75"},
+                         std::vector<std::string>{"DERRF", "5", "0", "10",
+                                                  "0.5", "0.75"},
+                         std::vector<std::string>{"TRUNCATED_NORMAL", "0", "2",
+                                                  "-1", "1.5"},
+                         std::vector<std::string>{"DUNIF", "4", "1", "7"},
+                         std::vector<std::string>{"CONST", "3.5"},
+                         std::vector<std::string>{"RAW"});
+    trans_func_type *trans_func = alloc_trans_func(args);
+    REQUIRE(trans_func != NULL);
+    INFO(args[0]);
+
+    auto x = normal_values(1000);
+    std::vector<double> y(x.size());
+    trans_func_eval_many(trans_func, x.data(), y.data(), x.size());
+    for (size_t i = 0; i < x.size(); i++)
+        REQUIRE_THAT(y[i], Catch::Matchers::WithinULP(
+                               trans_func_eval(trans_func, x[i]), 2));
+
+    SECTION("the values can be transformed in place") {
+        trans_func_eval_many(trans_func, x.data(), x.data(), x.size());
+        REQUIRE(x == y);
+    }
+
+    trans_func_free(trans_func);
+}
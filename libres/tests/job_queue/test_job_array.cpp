@@ -0,0 +1,194 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "catch2/catch.hpp"
+
+#include <ert/job_queue/queue_driver.hpp>
+#include <ert/job_queue/slurm_driver.hpp>
+#include <ert/job_queue/torque_driver.hpp>
+#include <ert/util/util.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+void make_script(const fs::path &fname, const std::string &content) {
+    std::ofstream stream{fname};
+    stream << content;
+    stream.close();
+    chmod(fname.c_str(), S_IRWXU);
+}
+
+std::string read_file(const fs::path &fname) {
+    std::ifstream stream{fname};
+    return {std::istreambuf_iterator<char>(stream),
+            std::istreambuf_iterator<char>()};
+}
+} // namespace
+
+TEST_CASE("array script selects job from array index", "[job_array]") {
+    WITH_TMPDIR;
+    auto cwd = fs::current_path();
+    std::vector<std::string> run_paths;
+    std::vector<std::string> job_names;
+    // The paths, names and arguments must survive the shell unchanged
+    for (int i = 0; i < 3; i++) {
+        run_paths.push_back(
+            (cwd / ("real $HOME 'x'-" + std::to_string(i))).string());
+        job_names.push_back("job name-" + std::to_string(i));
+        fs::create_directory(run_paths.back());
+    }
+
+    auto cmd = cwd / "the cmd.sh";
+    make_script(cmd, "#!/bin/sh\necho \"$1\" > output\n");
+
+    std::vector<std::string> args = {"A B", "it's", "$PATH;`true`"};
+    std::vector<const char *> argv;
+    for (const auto &arg : args)
+        argv.push_back(arg.c_str());
+
+    std::vector<queue_driver_array_job_type> jobs;
+    for (int i = 0; i < 3; i++)
+        jobs.push_back({cmd.c_str(), 1, run_paths[i].c_str(),
+                        job_names[i].c_str(), 1, &argv[i]});
+
+    auto script = cwd / "array.sh";
+    queue_driver_write_array_script(script.c_str(), "ARRAY_INDEX", 1,
+                                    jobs.size(), jobs.data());
+
+    for (int i = 0; i < 3; i++) {
+        std::string index = std::to_string(i + 1);
+        setenv("ARRAY_INDEX", index.c_str(), 1);
+        REQUIRE(util_spawn_blocking(script.c_str(), 0, nullptr, nullptr,
+                                    nullptr) == 0);
+    }
+    unsetenv("ARRAY_INDEX");
+
+    for (int i = 0; i < 3; i++) {
+        REQUIRE(read_file(fs::path(run_paths[i]) / "output") ==
+                args[i] + "\n");
+        REQUIRE(
+            fs::exists(fs::path(run_paths[i]) / (job_names[i] + ".stdout")));
+    }
+}
+
+TEST_CASE("largest num_cpu is used for the array", "[job_array]") {
+    std::vector<queue_driver_array_job_type> jobs = {
+        {"cmd", 1, "path", "job", 0, nullptr},
+        {"cmd", 4, "path", "job", 0, nullptr},
+        {"cmd", 2, "path", "job", 0, nullptr}};
+    REQUIRE(queue_driver_array_num_cpu(jobs.size(), jobs.data()) == 4);
+}
+
+TEST_CASE("slurm job array status from one squeue call", "[job_array]") {
+    WITH_TMPDIR;
+    auto cwd = fs::current_path();
+    queue_driver_type *driver = queue_driver_alloc_slurm();
+    REQUIRE(queue_driver_supports_job_array(driver));
+
+    make_script(cwd / "sbatch", "#!/bin/sh\necho 77\n");
+    make_script(cwd / "squeue", "#!/bin/sh\n"
+                                "echo \"77_0 RUNNING\"\n"
+                                "echo \"77_1 PENDING\"\n"
+                                "echo \"77_2 RUNNING\"\n");
+    queue_driver_set_option(driver, SLURM_SBATCH_OPTION,
+                            (cwd / "sbatch").c_str());
+    queue_driver_set_option(driver, SLURM_SQUEUE_OPTION,
+                            (cwd / "squeue").c_str());
+
+    std::vector<std::string> run_paths;
+    for (int i = 0; i < 3; i++) {
+        run_paths.push_back((cwd / ("real-" + std::to_string(i))).string());
+        fs::create_directory(run_paths.back());
+    }
+
+    std::vector<queue_driver_array_job_type> jobs;
+    for (const auto &run_path : run_paths)
+        jobs.push_back({"cmd", 1, run_path.c_str(), "job", 0, nullptr});
+
+    std::vector<void *> job_data(jobs.size(), nullptr);
+    REQUIRE(queue_driver_submit_job_array(driver, jobs.size(), jobs.data(),
+                                          job_data.data()));
+    REQUIRE(queue_driver_get_status(driver, job_data[0]) == JOB_QUEUE_RUNNING);
+    REQUIRE(queue_driver_get_status(driver, job_data[1]) == JOB_QUEUE_PENDING);
+    REQUIRE(queue_driver_get_status(driver, job_data[2]) == JOB_QUEUE_RUNNING);
+
+    for (auto job : job_data)
+        queue_driver_free_job(driver, job);
+    queue_driver_free(driver);
+}
+
+TEST_CASE("torque job array status is shared by concurrent polls",
+          "[job_array]") {
+    WITH_TMPDIR;
+    auto cwd = fs::current_path();
+    queue_driver_type *driver = queue_driver_alloc_TORQUE();
+    REQUIRE(queue_driver_supports_job_array(driver));
+
+    make_script(cwd / "qsub", "#!/bin/sh\necho 12[].server\n");
+    make_script(cwd / "qstat",
+                "#!/bin/sh\n"
+                "echo qstat >> qstat_calls\n"
+                "echo \"Job ID  Name  User  Time S Queue\"\n"
+                "echo \"------  ----  ----  ---- - -----\"\n"
+                "for i in 0 1 2 3; do\n"
+                "  echo \"12[$i].server job-$i user 00:00:01 C batch\"\n"
+                "done\n");
+    queue_driver_set_option(driver, TORQUE_QSUB_CMD, (cwd / "qsub").c_str());
+    queue_driver_set_option(driver, TORQUE_QSTAT_CMD, (cwd / "qstat").c_str());
+    queue_driver_set_option(driver, TORQUE_SUBMIT_SLEEP, "0");
+
+    std::vector<queue_driver_array_job_type> jobs(
+        4, {"cmd", 1, cwd.c_str(), "job", 0, nullptr});
+    std::vector<void *> job_data(jobs.size(), nullptr);
+    REQUIRE(queue_driver_submit_job_array(driver, jobs.size(), jobs.data(),
+                                          job_data.data()));
+
+    std::vector<job_status_type> status(jobs.size());
+    std::vector<std::thread> pollers;
+    for (std::size_t i = 0; i < jobs.size(); i++)
+        pollers.emplace_back([&, i] {
+            status[i] = queue_driver_get_status(driver, job_data[i]);
+        });
+    for (auto &poller : pollers)
+        poller.join();
+
+    for (auto job_status : status)
+        REQUIRE(job_status == JOB_QUEUE_DONE);
+    // One qstat call served all the polls
+    REQUIRE(read_file(cwd / "qstat_calls") == "qstat\n");
+
+    for (auto job : job_data)
+        queue_driver_free_job(driver, job);
+    queue_driver_free(driver);
+}
+
+TEST_CASE("parse torque array status", "[job_array]") {
+    WITH_TMPDIR;
+    std::ofstream stream{"qstat"};
+    stream << "Job ID                    Name             User            "
+              "Time Use S Queue\n";
+    stream << "------------------------- ---------------- --------------- "
+              "-------- - -----\n";
+    stream << "123[0].server             job-0            user            "
+              "00:00:01 R batch\n";
+    stream << "123[1].server             job-1            user            "
+              "0        Q batch\n";
+    stream << "123[2].server             job-2            user            "
+              "00:00:09 C batch\n";
+    stream.close();
+
+    hash_type *status = hash_alloc();
+    torque_driver_parse_array_status("qstat", status);
+    REQUIRE(hash_get_size(status) == 3);
+    REQUIRE(hash_get_int(status, "123[0]") == JOB_QUEUE_RUNNING);
+    REQUIRE(hash_get_int(status, "123[1]") == JOB_QUEUE_PENDING);
+    REQUIRE(hash_get_int(status, "123[2]") == JOB_QUEUE_DONE);
+    hash_free(status);
+}
@@ -0,0 +1,93 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/job_queue/job_queue.hpp>
+#include <ert/job_queue/queue_driver.hpp>
+
+#include "../tmpdir.hpp"
+
+using namespace std::chrono_literals;
+
+/*
+  These tests only check the generation of the queue and the order of the
+  changes; how fast a waiter wakes up is left to the benchmarks.
+*/
+
+TEST_CASE("waiting returns when a job is added", "[job_queue_wait]") {
+    WITH_TMPDIR;
+    job_queue_type *queue = job_queue_alloc(1, "OK", "STATUS", "ERROR");
+
+    long generation = job_queue_get_generation(queue);
+    job_queue_node_type *node =
+        job_queue_node_alloc_simple("job", ".", "/bin/true", 0, nullptr);
+    job_queue_add_job_node(queue, node);
+    REQUIRE(job_queue_get_generation(queue) != generation);
+    REQUIRE(job_queue_wait_for_change(queue, generation));
+
+    SECTION("status changes wake up the waiting thread") {
+        generation = job_queue_get_generation(queue);
+        std::thread setter{[node] {
+            std::this_thread::sleep_for(20ms);
+            job_queue_node_set_status(node, JOB_QUEUE_SUBMITTED);
+        }};
+        bool changed = false;
+        while (!changed)
+            changed = job_queue_wait_for_change(queue, generation);
+        setter.join();
+        REQUIRE(job_queue_get_generation(queue) != generation);
+        REQUIRE(job_queue_node_get_status(node) == JOB_QUEUE_SUBMITTED);
+    }
+
+    SECTION("setting the same status is not a change") {
+        job_queue_node_set_status(node, JOB_QUEUE_SUBMITTED);
+        generation = job_queue_get_generation(queue);
+        job_queue_node_set_status(node, JOB_QUEUE_SUBMITTED);
+        REQUIRE(job_queue_get_generation(queue) == generation);
+        REQUIRE_FALSE(job_queue_wait_for_change(queue, generation));
+    }
+
+    job_queue_free(queue);
+}
+
+TEST_CASE("every status change of a job moves the generation",
+          "[job_queue_wait]") {
+    WITH_TMPDIR;
+    job_queue_type *queue = job_queue_alloc(1, "OK", "STATUS", "ERROR");
+    queue_driver_type *driver = queue_driver_alloc(LOCAL_DRIVER);
+    job_queue_set_driver(queue, driver);
+
+    const char *argv[] = {"1"};
+    job_queue_node_type *node =
+        job_queue_node_alloc_simple("job", ".", "/bin/sleep", 1, argv);
+    job_queue_add_job_node(queue, node);
+
+    long generation = job_queue_get_generation(queue);
+    REQUIRE(job_queue_node_submit_simple(node, driver) == SUBMIT_OK);
+    REQUIRE(job_queue_get_generation(queue) != generation);
+
+    // The run loop of the queue: poll the driver, then wait for the next
+    // change of the queue
+    std::vector<job_status_type> statuses{job_queue_node_get_status(node)};
+    while (!(statuses.back() & JOB_QUEUE_COMPLETE_STATUS)) {
+        generation = job_queue_get_generation(queue);
+        job_status_type status = job_queue_node_refresh_status(node, driver);
+        if (status != statuses.back()) {
+            REQUIRE(job_queue_get_generation(queue) != generation);
+            statuses.push_back(status);
+        } else
+            job_queue_wait_for_change(queue, generation);
+    }
+
+    REQUIRE(statuses.front() == JOB_QUEUE_SUBMITTED);
+    REQUIRE(statuses.back() == JOB_QUEUE_DONE);
+    for (std::size_t i = 1; i + 1 < statuses.size(); i++)
+        REQUIRE((statuses[i] == JOB_QUEUE_PENDING ||
+                 statuses[i] == JOB_QUEUE_RUNNING));
+
+    job_queue_node_free_driver_data(node, driver);
+    job_queue_free(queue);
+    queue_driver_free(driver);
+}
@@ -0,0 +1,138 @@
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/job_queue/job_queue.hpp>
+#include <ert/job_queue/job_status_event.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace {
+job_status_event_type make_event(int queue_index) {
+    return {queue_index, JOB_QUEUE_WAITING, JOB_QUEUE_SUBMITTED,
+            std::chrono::system_clock::now()};
+}
+} // namespace
+
+TEST_CASE("capacity is rounded up to power of two", "[job_status_event]") {
+    JobStatusEventRing ring(100);
+    REQUIRE(ring.capacity() == 128);
+}
+
+TEST_CASE("events are dropped when the ring is full", "[job_status_event]") {
+    JobStatusEventRing ring(4);
+    for (int i = 0; i < 6; i++)
+        ring.push(make_event(i));
+    REQUIRE(ring.dropped() == 2);
+
+    std::vector<job_status_event_type> events;
+    REQUIRE(ring.drain(events) == 4);
+    for (int i = 0; i < 4; i++)
+        REQUIRE(events[i].queue_index == i);
+
+    REQUIRE(ring.push(make_event(10)));
+    job_status_event_type event;
+    REQUIRE(ring.pop(event));
+    REQUIRE(event.queue_index == 10);
+    REQUIRE_FALSE(ring.pop(event));
+}
+
+TEST_CASE("concurrent producers with one consumer", "[job_status_event]") {
+    const int num_threads = 4;
+    const int per_thread = 10000;
+    JobStatusEventRing ring(1024);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < num_threads; t++)
+        producers.emplace_back([&ring, t] {
+            for (int i = 0; i < per_thread; i++)
+                ring.push(make_event(t * per_thread + i));
+        });
+
+    std::vector<job_status_event_type> events;
+    std::vector<int> last(num_threads, -1);
+    bool ordered = true;
+    std::size_t received = 0;
+    auto consume = [&] {
+        events.clear();
+        received += ring.drain(events);
+        for (const auto &event : events) {
+            int t = event.queue_index / per_thread;
+            int i = event.queue_index % per_thread;
+            if (i <= last[t])
+                ordered = false;
+            last[t] = i;
+        }
+    };
+
+    while (received + ring.dropped() <
+           static_cast<std::size_t>(num_threads * per_thread))
+        consume();
+    for (auto &producer : producers)
+        producer.join();
+    consume();
+
+    REQUIRE(ordered);
+    REQUIRE(received + ring.dropped() ==
+            static_cast<std::size_t>(num_threads * per_thread));
+}
+
+TEST_CASE("job queue publishes node status changes", "[job_status_event]") {
+    WITH_TMPDIR;
+    job_queue_type *queue = job_queue_alloc(1, "OK", "STATUS", "ERROR");
+    job_queue_node_type *node = job_queue_node_alloc_simple(
+        "job", ".", "/bin/true", 0, nullptr);
+    int queue_index = job_queue_add_job_node(queue, node);
+
+    job_queue_node_set_status(node, JOB_QUEUE_SUBMITTED);
+    job_queue_node_set_status(node, JOB_QUEUE_SUBMITTED);
+    job_queue_node_set_status(node, JOB_QUEUE_RUNNING);
+
+    std::vector<job_status_event_type> events;
+    REQUIRE(job_queue_drain_status_events(queue, events) == 3);
+    REQUIRE(events[0].queue_index == queue_index);
+    REQUIRE(events[0].new_status == JOB_QUEUE_WAITING);
+    REQUIRE(events[1].old_status == JOB_QUEUE_WAITING);
+    REQUIRE(events[1].new_status == JOB_QUEUE_SUBMITTED);
+    REQUIRE(events[2].old_status == JOB_QUEUE_SUBMITTED);
+    REQUIRE(events[2].new_status == JOB_QUEUE_RUNNING);
+
+    job_queue_free(queue);
+}
+
+TEST_CASE("status changes are drained into vectors", "[job_status_event]") {
+    WITH_TMPDIR;
+    job_queue_type *queue = job_queue_alloc(1, "OK", "STATUS", "ERROR");
+    job_queue_node_type *node = job_queue_node_alloc_simple(
+        "job", ".", "/bin/true", 0, nullptr);
+    int queue_index = job_queue_add_job_node(queue, node);
+    job_queue_node_set_status(node, JOB_QUEUE_SUBMITTED);
+
+    int_vector_type *queue_indices = int_vector_alloc(0, 0);
+    int_vector_type *statuses = int_vector_alloc(0, 0);
+    REQUIRE(job_queue_drain_status_changes(queue, queue_indices, statuses));
+    REQUIRE(int_vector_size(queue_indices) == 2);
+    REQUIRE(int_vector_iget(queue_indices, 1) == queue_index);
+    REQUIRE(int_vector_iget(statuses, 0) == JOB_QUEUE_WAITING);
+    REQUIRE(int_vector_iget(statuses, 1) == JOB_QUEUE_SUBMITTED);
+
+    SECTION("dropped events are reported once") {
+        JobStatusEventRing *ring = job_queue_get_status_events(queue);
+        for (std::size_t i = 0; i <= ring->capacity(); i++)
+            job_queue_node_set_status(
+                node, i % 2 ? JOB_QUEUE_SUBMITTED : JOB_QUEUE_RUNNING);
+
+        int_vector_reset(queue_indices);
+        int_vector_reset(statuses);
+        REQUIRE_FALSE(
+            job_queue_drain_status_changes(queue, queue_indices, statuses));
+        REQUIRE(int_vector_size(statuses) ==
+                static_cast<int>(ring->capacity()));
+        REQUIRE(job_queue_drain_status_changes(queue, queue_indices, statuses));
+    }
+
+    int_vector_free(queue_indices);
+    int_vector_free(statuses);
+    job_queue_free(queue);
+}
@@ -1,5 +1,6 @@
 #include <chrono>
 #include <regex>
+#include <stdexcept>
 #include <thread>
 
 #include "catch2/catch.hpp"
@@ -22,3 +23,75 @@ TEST_CASE("simple time benchmark test", "[res_util]") {
     REQUIRE(std::regex_search(logger->calls[0], std::regex("2\\.\\d{4}")));
     REQUIRE(logger->calls[0].find("some_function's") != std::string::npos);
 }
+
+namespace {
+const ert::metrics::metric_snapshot &
+find_metric(const std::vector<ert::metrics::metric_snapshot> &metrics,
+            const std::string &name) {
+    for (const auto &metric : metrics)
+        if (metric.name == name)
+            return metric;
+    FAIL("No metric " << name);
+    throw std::logic_error("unreachable");
+}
+} // namespace
+
+TEST_CASE("counters sum over all threads", "[res_util]") {
+    static const ert::metrics::Counter counter("test.counter");
+    ert::metrics::reset();
+
+    counter.add(5);
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; thread++)
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; i++)
+                counter.add(2);
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    auto metric = find_metric(ert::metrics::snapshot(), "test.counter");
+    REQUIRE(metric.kind == ert::metrics::metric_kind::counter);
+    REQUIRE(metric.count == 4001);
+    REQUIRE(metric.total == 8005);
+    REQUIRE(metric.histogram.empty());
+
+    ert::metrics::reset();
+    metric = find_metric(ert::metrics::snapshot(), "test.counter");
+    REQUIRE(metric.count == 0);
+    REQUIRE(metric.total == 0);
+}
+
+TEST_CASE("timers record a latency histogram", "[res_util]") {
+    static const ert::metrics::Timer timer("test.timer");
+    ert::metrics::reset();
+
+    timer.record(std::chrono::nanoseconds(100));
+    timer.record(std::chrono::microseconds(3));
+    timer.record(std::chrono::microseconds(3));
+    {
+        auto timing = timer.time();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    auto metric = find_metric(ert::metrics::snapshot(), "test.timer");
+    REQUIRE(metric.kind == ert::metrics::metric_kind::timer);
+    REQUIRE(metric.count == 4);
+    REQUIRE(metric.total >= 10000000 + 6100);
+    REQUIRE(metric.histogram.size() == ert::metrics::histogram_buckets);
+    REQUIRE(metric.histogram[0] == 1);
+    REQUIRE(metric.histogram[2] == 2);
+    REQUIRE(ert::metrics::histogram_upper_bound(2) > 3000);
+    REQUIRE(ert::metrics::histogram_upper_bound(1) <= 3000);
+}
+
+TEST_CASE("metrics are identified by name", "[res_util]") {
+    ert::metrics::Counter first("test.shared");
+    ert::metrics::Counter second("test.shared");
+    ert::metrics::reset();
+    first.add();
+    second.add();
+    REQUIRE(find_metric(ert::metrics::snapshot(), "test.shared").count == 2);
+
+    REQUIRE_THROWS_AS(ert::metrics::Timer("test.shared"), std::logic_error);
+}
@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/rms/rms_file.hpp>
+#include <ert/rms/rms_index.hpp>
+#include <ert/rms/rms_tag.hpp>
+#include <ert/rms/rms_tagkey.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace {
+constexpr int size = 24;
+
+std::vector<float> poro_values() {
+    std::vector<float> values(size);
+    for (int i = 0; i < size; i++)
+        values[i] = 0.1 + i * 0.01;
+    return values;
+}
+
+std::vector<double> permx_values() {
+    std::vector<double> values(size);
+    for (int i = 0; i < size; i++)
+        values[i] = 1000.5 - i * 3.25;
+    return values;
+}
+
+std::vector<int> facies_values() {
+    std::vector<int> values(size);
+    for (int i = 0; i < size; i++)
+        values[i] = i % 4;
+    return values;
+}
+
+/** A binary ROFF file with three parameters, written by rms_file */
+void write_binary_fixture(const char *filename) {
+    rms_file_type *rms_file = rms_file_alloc(filename, false);
+    rms_file_fopen_w(rms_file);
+    rms_file_init_fwrite(rms_file, "parameter");
+    FILE *stream = rms_file_get_FILE(rms_file);
+    rms_tag_fwrite_dimensions(2, 3, 4, stream);
+
+    auto poro = poro_values();
+    auto permx = permx_values();
+    auto facies = facies_values();
+    for (auto [name, rms_type, data] :
+         {std::make_tuple("PORO", rms_float_type, (const void *)poro.data()),
+          std::make_tuple("PERMX", rms_double_type, (const void *)permx.data()),
+          std::make_tuple("FACIES", rms_int_type,
+                          (const void *)facies.data())}) {
+        rms_tagkey_type *data_key =
+            rms_tagkey_alloc_complete("data", size, rms_type, data, true);
+        rms_tag_fwrite_parameter(name, data_key, stream);
+        rms_tagkey_free(data_key);
+    }
+    rms_file_complete_fwrite(rms_file);
+    rms_file_fclose(rms_file);
+    rms_file_free(rms_file);
+}
+
+void write_ascii_fixture(const char *filename) {
+    std::ofstream stream{filename};
+    stream << "roff-asc\n#ROFF file#\n#Creator: test#\n"
+           << "tag filedata\nint byteswaptest 1\n"
+           << "char filetype \"parameter\"\nendtag\n"
+           << "tag dimensions\nint nX 2\nint nY 3\nint nZ 4\nendtag\n";
+
+    stream << "tag parameter\nchar name \"PERMX\"\narray double data " << size
+           << "\n";
+    stream.precision(17);
+    for (double value : permx_values())
+        stream << " " << value;
+    stream << "\nendtag\n";
+
+    stream << "tag parameter\nchar name \"PORO\"\narray float data " << size
+           << "\n";
+    stream.precision(9);
+    for (float value : poro_values())
+        stream << " " << value;
+    stream << "\nendtag\ntag eof\nendtag\n";
+}
+
+template <typename T>
+void put_value(std::string &file, T value, bool swap) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if (swap)
+        std::reverse(bytes, bytes + sizeof(T));
+    file.append(bytes, sizeof(T));
+}
+
+void put_string(std::string &file, const std::string &string) {
+    file += string;
+    file += '\0';
+}
+
+/** A binary ROFF file written with the opposite byte order */
+void write_swapped_fixture(const char *filename) {
+    std::string file;
+    put_string(file, "roff-bin");
+    put_string(file, "#ROFF file#");
+    for (auto string : {"tag", "filedata", "int", "byteswaptest"})
+        put_string(file, string);
+    put_value(file, 1, true);
+    for (auto string : {"endtag", "tag", "parameter", "char", "name", "PORO",
+                        "array", "float", "data"})
+        put_string(file, string);
+    put_value(file, size, true);
+    for (float value : poro_values())
+        put_value(file, value, true);
+    for (auto string : {"endtag", "tag", "eof", "endtag"})
+        put_string(file, string);
+
+    std::ofstream{filename, std::ios::binary} << file;
+}
+
+/** The values of @name as loaded by rms_file */
+template <typename T>
+std::vector<T> fread_rms_file(const char *filename, const char *name) {
+    rms_file_type *rms_file = rms_file_alloc(filename, false);
+    rms_tagkey_type *data_key =
+        rms_file_fread_alloc_data_tagkey(rms_file, "parameter", "name", name);
+    const T *data = static_cast<const T *>(rms_tagkey_get_data_ref(data_key));
+    std::vector<T> values(data, data + rms_tagkey_get_size(data_key));
+    rms_tagkey_free(data_key);
+    rms_file_free(rms_file);
+    return values;
+}
+
+template <typename T>
+std::vector<T> fread_index(const rms_index_type *index, const char *name,
+                           rms_type_enum rms_type) {
+    const rms_index_entry_type *entry =
+        rms_index_find(index, "parameter", name, "data");
+    REQUIRE(entry != NULL);
+    std::vector<T> values(entry->size);
+    rms_index_fread(index, entry, rms_type, values.data());
+    return values;
+}
+} // namespace
+
+TEST_CASE("rms_index reads the same values as rms_file", "[rms]") {
+    WITH_TMPDIR;
+    write_binary_fixture("fixture.roff");
+    rms_index_type *index = rms_index_alloc("fixture.roff");
+    REQUIRE(!rms_index_is_ascii(index));
+
+    REQUIRE(fread_index<float>(index, "PORO", rms_float_type) ==
+            fread_rms_file<float>("fixture.roff", "PORO"));
+    REQUIRE(fread_index<double>(index, "PERMX", rms_double_type) ==
+            fread_rms_file<double>("fixture.roff", "PERMX"));
+    REQUIRE(fread_index<int>(index, "FACIES", rms_int_type) ==
+            fread_rms_file<int>("fixture.roff", "FACIES"));
+
+    SECTION("parameters are converted to the requested type") {
+        auto poro = fread_rms_file<float>("fixture.roff", "PORO");
+        auto values = fread_index<double>(index, "PORO", rms_double_type);
+        for (int i = 0; i < size; i++)
+            REQUIRE(values[i] == poro[i]);
+
+        auto facies = fread_index<float>(index, "FACIES", rms_float_type);
+        for (int i = 0; i < size; i++)
+            REQUIRE(facies[i] == facies_values()[i]);
+    }
+
+    SECTION("keys are looked up by tag, name and key") {
+        const auto *entry = rms_index_find(index, "parameter", "PERMX", "data");
+        REQUIRE(entry->rms_type == rms_double_type);
+        REQUIRE(entry->size == size);
+        REQUIRE(entry->name == "PERMX");
+
+        REQUIRE(rms_index_find(index, "parameter", "NTG", "data") == NULL);
+        REQUIRE(rms_index_find(index, "parameter", "PORO", "codes") == NULL);
+        REQUIRE(rms_index_find(index, "parameter", NULL, "data")->name ==
+                "PORO");
+
+        const auto *nx = rms_index_find(index, "dimensions", "", "nX");
+        int value;
+        rms_index_fread(index, nx, rms_int_type, &value);
+        REQUIRE(value == 2);
+    }
+
+    rms_index_free(index);
+}
+
+TEST_CASE("rms_index reads ASCII ROFF files", "[rms]") {
+    WITH_TMPDIR;
+    write_binary_fixture("fixture.roff");
+    write_ascii_fixture("fixture_ascii.roff");
+    rms_index_type *index = rms_index_alloc("fixture_ascii.roff");
+    REQUIRE(rms_index_is_ascii(index));
+
+    REQUIRE(fread_index<float>(index, "PORO", rms_float_type) ==
+            fread_rms_file<float>("fixture.roff", "PORO"));
+    REQUIRE(fread_index<double>(index, "PERMX", rms_double_type) ==
+            fread_rms_file<double>("fixture.roff", "PERMX"));
+
+    rms_index_free(index);
+}
+
+TEST_CASE("rms_index byteswaps files of the other byte order", "[rms]") {
+    WITH_TMPDIR;
+    write_swapped_fixture("swapped.roff");
+    rms_index_type *index = rms_index_alloc("swapped.roff");
+
+    REQUIRE(fread_index<float>(index, "PORO", rms_float_type) == poro_values());
+    rms_index_free(index);
+}
@@ -14,6 +14,8 @@
 #  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
 #  for more details.
 
+import json
+
 from cwrap import BaseCClass
 
 from res import ResPrototype
@@ -35,6 +37,9 @@ class ExtParam(BaseCClass):
         "double ext_param_key_suffix_get( ext_param, char*, char*)"
     )
     _export = ResPrototype("void   ext_param_json_export( ext_param, char*)")
+    _set_from_json_string = ResPrototype(
+        "bool   ext_param_set_from_json_string( ext_param, char*)"
+    )
     _get_config = ResPrototype("void* ext_param_get_config(ext_param)")
 
     def __init__(self, config):
@@ -154,6 +159,22 @@ class ExtParam(BaseCClass):
         for index, value in enumerate(values):
             self[index] = value
 
+    def set_values(self, values):
+        """Set the values in the dictionary values, with a number for each
+        key without suffixes and a dictionary with a number for each suffix
+        otherwise, in one call. Keys which are not in values keep their
+        values."""
+        if not self._set_from_json_string(json.dumps(values, default=float)):
+            # Set the values one by one to raise the error for the offending
+            # key or value
+            for key, value in values.items():
+                if isinstance(value, dict):
+                    for suffix, suffix_value in value.items():
+                        self[key, suffix] = suffix_value
+                else:
+                    self[key] = value
+            raise ValueError(f"Invalid values: {values}")
+
     def free(self):
         self._free()
 
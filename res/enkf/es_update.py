@@ -37,6 +37,16 @@ class SmootherSnapshot:
     update_step_snapshots: Dict[str, UpdateSnapshot] = field(default_factory=dict)
 
 
+def _make_X_parameters(A: "npt.NDArray") -> "npt.NDArray[np.double]":
+    """make_X only uses the parameters when there are fewer of them than
+    realizations, so a large single precision A is not converted to double."""
+    if A.dtype == np.double:
+        return A
+    if A.shape[0] < A.shape[1]:
+        return A.astype(np.double)
+    return np.empty(shape=(0, 0))
+
+
 def analysis_ES(
     updatestep: UpdateConfiguration,
     obs: EnkfObs,
@@ -50,12 +60,23 @@ def analysis_ES(
     ensemble_config: EnsembleConfig,
     source_fs: EnkfFs,
     target_fs: EnkfFs,
+    single_precision: bool = False,
 ) -> None:
+    """With single_precision the parameters are loaded and updated as
+    float32, which halves the memory of the update; X is still computed,
+    and the update accumulated, in double precision."""
 
     iens_active_index = [i for i in range(len(ens_mask)) if ens_mask[i]]
 
     update.copy_parameters(source_fs, target_fs, ensemble_config, ens_mask)
 
+    if single_precision:
+        load_parameters = update.load_parameters_float32
+        load_row_scaling_parameters = update.load_row_scaling_parameters_float32
+    else:
+        load_parameters = update.load_parameters
+        load_row_scaling_parameters = update.load_row_scaling_parameters
+
     # Looping over local analysis update_step
     for update_step in updatestep:
 
@@ -79,10 +100,10 @@ def analysis_ES(
                 f"No active observations for update step: {update_step.name}."
             )
 
-        A = update.load_parameters(
+        A = load_parameters(
             target_fs, ensemble_config, iens_active_index, update_step.parameters
         )
-        A_with_rowscaling = update.load_row_scaling_parameters(
+        A_with_rowscaling = load_row_scaling_parameters(
             target_fs,
             ensemble_config,
             iens_active_index,
@@ -102,11 +123,14 @@ def analysis_ES(
                 R,
                 E,
                 D,
-                A,
+                _make_X_parameters(A),
                 ies_inversion=module_config.inversion,
                 truncation=module_config.get_truncation(),
             )
-            A = A @ X
+            if single_precision:
+                update.multiply(A, X)
+            else:
+                A = A @ X
 
             update.save_parameters(
                 target_fs,
@@ -123,7 +147,7 @@ def analysis_ES(
                     R,
                     E,
                     D,
-                    A,
+                    _make_X_parameters(A),
                     ies_inversion=module_config.inversion,
                     truncation=module_config.get_truncation(),
                 )
@@ -286,7 +310,9 @@ class ESUpdate:
     def setGlobalStdScaling(self, weight: float) -> None:
         self.ert.analysisConfig().setGlobalStdScaling(weight)
 
-    def smootherUpdate(self, run_context: "ErtRunContext") -> None:
+    def smootherUpdate(
+        self, run_context: "ErtRunContext", single_precision: bool = False
+    ) -> None:
         source_fs = run_context.get_sim_fs()
         target_fs = run_context.get_target_fs()
 
@@ -322,6 +348,7 @@ class ESUpdate:
             ensemble_config,
             source_fs,
             target_fs,
+            single_precision,
         )
 
         _write_update_report(
@@ -57,3 +57,48 @@ class SummaryCollector:
         )
 
         return DataFrame(data=summary_data, index=multi_index, columns=summary_keys)
+
+    @staticmethod
+    def loadSummaryMatrix(
+        ert: EnKFMain, case_name, key, realization_index=None
+    ) -> DataFrame:
+        """
+        Loads one summary key in the same format as loadAllSummaryData(), with
+        the wanted realizations read into one matrix by a single library call.
+
+        @type ert: EnKFMain
+        @type case_name: str
+        @type key: str
+        @rtype: DataFrame
+        """
+
+        fs = ert.getEnkfFsManager().getFileSystem(case_name)
+
+        time_map = fs.getTimeMap()
+        dates = [time_map[index].datetime() for index in range(1, len(time_map))]
+
+        realizations = SummaryCollector.createActiveList(ert, fs)
+        if realization_index is not None:
+            if realization_index not in realizations:
+                raise IndexError(f"No such realization {realization_index}")
+            realizations = [realization_index]
+
+        if key not in ert.getKeyManager().summaryKeys():
+            return DataFrame()
+
+        # One row per realization, and one column per report step from 0
+        matrix = _lib.enkf_plot_data.load_matrix(
+            ert.ensembleConfig()[key], fs, realizations=realizations
+        )
+        summary_data = matrix[:, 1 : len(dates) + 1]
+
+        if np.isnan(summary_data).all():
+            return DataFrame()
+
+        multi_index = MultiIndex.from_product(
+            [realizations, dates], names=["Realization", "Date"]
+        )
+
+        return DataFrame(
+            data=summary_data.reshape(-1, 1), index=multi_index, columns=[key]
+        )
@@ -59,6 +59,9 @@ class Driver(BaseCClass):
     _get_max_running = ResPrototype("int queue_driver_get_max_running( driver )")
     _set_max_running = ResPrototype("void queue_driver_set_max_running( driver , int)")
     _get_name = ResPrototype("char* queue_driver_get_name( driver )")
+    _supports_job_array = ResPrototype(
+        "bool queue_driver_supports_job_array( driver )"
+    )
 
     def __init__(self, driver_type, max_running=1, options=None):
         """
@@ -109,6 +112,10 @@ class Driver(BaseCClass):
     def name(self):
         return self._get_name()
 
+    @property
+    def supports_job_array(self):
+        return self._supports_job_array()
+
     def free(self):
         self._free()
 
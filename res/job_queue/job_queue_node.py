@@ -172,11 +172,12 @@ class JobQueueNode(BaseCClass):
             self._max_runtime is not None and self.runtime >= self._max_runtime
         )
 
-    def _job_monitor(self, driver, pool_sema, max_submit):
+    def _job_monitor(self, driver, pool_sema, max_submit, submitted):
 
-        submit_status = self.submit(driver)
-        if submit_status is not JobSubmitStatusType.SUBMIT_OK:
-            self._set_status(JobStatusType.JOB_QUEUE_DONE)
+        if not submitted:
+            submit_status = self.submit(driver)
+            if submit_status is not JobSubmitStatusType.SUBMIT_OK:
+                self._set_status(JobStatusType.JOB_QUEUE_DONE)
 
         current_status = self.refresh_status(driver)
 
@@ -258,7 +259,7 @@ class JobQueueNode(BaseCClass):
         self._run_kill(driver)
         self._tried_killing += 1
 
-    def run(self, driver, pool_sema, max_submit=2):
+    def run(self, driver, pool_sema, max_submit=2, submitted=False):
         # Prevent multiple threads working on the same object
         self.wait_for()
         # Do not start if already kill signal is sent
@@ -269,7 +270,8 @@ class JobQueueNode(BaseCClass):
         self._set_thread_status(ThreadStatus.RUNNING)
         self._start_time = None
         self._thread = Thread(
-            target=self._job_monitor, args=(driver, pool_sema, max_submit)
+            target=self._job_monitor,
+            args=(driver, pool_sema, max_submit, submitted),
         )
         self._thread.start()
 
@@ -29,6 +29,7 @@ from typing import Any, Callable, Dict, Mapping, Optional, Union, TYPE_CHECKING
 
 from cloudevents.http import CloudEvent, to_json
 from cwrap import BaseCClass
+from ecl.util.util import IntVector
 from job_runner import CERT_FILE, JOBS_FILE
 from res import ResPrototype
 from res.job_queue.job_queue_node import JobQueueNode
@@ -92,6 +93,9 @@ class JobQueue(BaseCClass):
     # necessary to explitly inform the queue layer when all jobs have
     # been submitted.
     TYPE_NAME = "job_queue"
+    # The shortest time in seconds between two publishings of changes from
+    # execute_queue_async().
+    publish_interval = 1.0
     _alloc = ResPrototype(
         "void* job_queue_alloc( int , char* , char* , char* )", bind=False
     )
@@ -118,6 +122,14 @@ class JobQueue(BaseCClass):
     _get_exit_file = ResPrototype("char* job_queue_get_exit_file(job_queue)")
     _get_status_file = ResPrototype("char* job_queue_get_status_file(job_queue)")
     _add_job = ResPrototype("int job_queue_add_job_node(job_queue, job_queue_node)")
+    _get_generation = ResPrototype("long job_queue_get_generation(job_queue)")
+    _wait_for_change = ResPrototype("bool job_queue_wait_for_change(job_queue, long)")
+    _submit_waiting_array = ResPrototype(
+        "int job_queue_submit_waiting_array(job_queue, int)"
+    )
+    _drain_status_changes = ResPrototype(
+        "bool job_queue_drain_status_changes(job_queue, int_vector, int_vector)"
+    )
 
     def __repr__(self):
         nrun, ncom, nwait, npend = (
@@ -322,7 +334,26 @@ class JobQueue(BaseCClass):
                 )
                 raise AssertionError(msg.format(job.status, job.thread_status))
 
+    def submit_waiting_array(self):
+        """Submit the waiting jobs which fit in the available capacity as one
+        job array, in queue order; these are the first jobs to be launched
+        by launch_jobs(). Returns the number of jobs submitted, which is 0 if
+        the array submission failed and the jobs must be submitted one by
+        one."""
+        not_launched = sum(
+            job.thread_status == ThreadStatus.READY
+            and job.status == JobStatusType.JOB_QUEUE_SUBMITTED
+            for job in self.job_list
+        )
+        capacity = self.max_running() - self.count_running() - not_launched
+        if self.stopped or capacity <= 0:
+            return 0
+        return self._submit_waiting_array(capacity)
+
     def launch_jobs(self, pool_sema):
+        if self.driver.supports_job_array:
+            self.submit_waiting_array()
+
         # Start waiting jobs
         while self.available_capacity():
             job = self.fetch_next_waiting()
@@ -332,13 +363,17 @@ class JobQueue(BaseCClass):
                 driver=self.driver,
                 pool_sema=pool_sema,
                 max_submit=self.max_submit,
+                submitted=job.status == JobStatusType.JOB_QUEUE_SUBMITTED,
             )
 
     def execute_queue(self, pool_sema, evaluators):
         while self.is_active() and not self.stopped:
             self.launch_jobs(pool_sema)
 
-            time.sleep(1)
+            # Read after launch_jobs(), whose own submissions are not news,
+            # and return as soon as a job is added or changes status
+            generation = self._get_generation()
+            self._wait_for_change(generation)
 
             if evaluators is not None:
                 for func in evaluators:
@@ -409,6 +444,18 @@ class JobQueue(BaseCClass):
 
                 await asyncio.sleep(backoff)
 
+    async def _wait_for_change_async(self, generation, timeout=1.0):
+        """Wait in an executor thread until the queue has changed since
+        generation, or for at most timeout seconds. Every wait in the
+        library returns after the usleep time of the queue, so the wait is
+        repeated until the timeout has passed."""
+        loop = asyncio.get_running_loop()
+        deadline = loop.time() + timeout
+        while loop.time() < deadline:
+            if await loop.run_in_executor(None, self._wait_for_change, generation):
+                return True
+        return False
+
     async def execute_queue_async(  # pylint: disable=too-many-arguments
         self,
         ws_uri: str,
@@ -429,21 +476,38 @@ class JobQueue(BaseCClass):
         if token is not None:
             headers["token"] = token
 
+        loop = asyncio.get_running_loop()
         try:
             await JobQueue._publish_changes(
                 ee_id, self._differ.snapshot(), ws_uri, ssl_context, headers
             )
+            # Every publishing opens a new websocket connection, so the
+            # changes are collected and published at most once per
+            # publish_interval even though the loop wakes on every change.
+            changes = {}
+            next_publish = loop.time() + self.publish_interval
             while True:
                 self.launch_jobs(pool_sema)
 
-                await asyncio.sleep(1)
+                # Read after launch_jobs(), whose own submissions are not
+                # news; returns as soon as a job is added or changes status,
+                # or when the collected changes are due to be published
+                generation = self._get_generation()
+                timeout = self.publish_interval
+                if changes:
+                    timeout = max(0.0, next_publish - loop.time())
+                await self._wait_for_change_async(generation, timeout)
 
                 for func in evaluators:
                     func()
 
-                await JobQueue._publish_changes(
-                    ee_id, self.changes_after_transition(), ws_uri, ssl_context, headers
-                )
+                changes.update(self.changes_after_transition())
+                if changes and (self.stopped or loop.time() >= next_publish):
+                    await JobQueue._publish_changes(
+                        ee_id, changes, ws_uri, ssl_context, headers
+                    )
+                    changes = {}
+                    next_publish = loop.time() + self.publish_interval
 
                 if self.stopped:
                     raise asyncio.CancelledError
@@ -548,6 +612,12 @@ class JobQueue(BaseCClass):
         return self._differ.snapshot()
 
     def changes_after_transition(self) -> Dict[int, str]:
+        """Return the changes since the last call. The status changes are
+        drained from the queue, and the status of every job is only read
+        again if the queue had to drop some of them."""
+        queue_index, status = IntVector(), IntVector()
+        if self._drain_status_changes(queue_index, status):
+            return self._differ.apply_changes(zip(queue_index, status))
         old_state, new_state = self._differ.transition(self.job_list)
         return self._differ.diff_states(old_state, new_state)
 
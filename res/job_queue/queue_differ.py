@@ -26,6 +26,24 @@ class QueueDiffer:
         self._state = new_state
         return old_state, new_state
 
+    def apply_changes(
+        self, changes: typing.Iterable[typing.Tuple[int, int]]
+    ) -> typing.Dict[int, str]:
+        """Apply the (queue_index, state) changes in order, and return the
+        states which differ from before by iens."""
+        old_state = {}
+        for q_index, state in changes:
+            if q_index not in self._qindex_to_iens:
+                continue
+            old_state.setdefault(q_index, self._state[q_index])
+            self._state[q_index] = state
+
+        return {
+            self._qindex_to_iens[q_index]: str(JobStatusType(self._state[q_index]))
+            for q_index, state in old_state.items()
+            if state != self._state[q_index]
+        }
+
     def diff_states(
         self,
         old_state: typing.List[JobStatusType],
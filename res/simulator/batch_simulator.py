@@ -94,7 +94,7 @@ class BatchSimulator:
             ens_config.addNode(EnkfConfigNode.create_gen_data(key, f"{key}_%d"))
 
     def _setup_sim(self, sim_id, controls, file_system):
-        def _set_ext_param(ext_param, key, assignment):
+        def _check_suffixes(ext_param, key, assignment):
             if isinstance(assignment, dict):  # handle suffixes
                 suffixes = ext_param.config[key]
                 if len(assignment) != len(suffixes):
@@ -103,10 +103,6 @@ class BatchSimulator:
                         f"Key {key} is missing values for "
                         f"these suffixes: {missingsuffixes}"
                     )
-                for suffix, value in assignment.items():
-                    ext_node[key, suffix] = value
-            else:  # assume assignment is a single numerical value
-                ext_node[key] = assignment
 
         node_id = NodeId(0, sim_id)
         if set(controls.keys()) != self.control_keys:
@@ -126,7 +122,11 @@ class BatchSimulator:
                     )
                 )
             for var_name, var_setting in control.items():
-                _set_ext_param(ext_node, var_name, var_setting)
+                if var_name not in ext_node:
+                    raise KeyError(f"No such key: {var_name}")
+                _check_suffixes(ext_node, var_name, var_setting)
+            # All the values of the control are set in one call
+            ext_node.set_values(control)
             node.save(file_system, node_id)
 
     def start(self, case_name, case_data):
@@ -13,10 +13,10 @@ from ert_shared.libres_facade import LibresFacade
 from res.enkf import EnKFMain, ResConfig
 
 # This hack allows us to call the original method when
-# mocking loadAllSummaryData()
+# mocking loadSummaryMatrix()
 from res.enkf.export import SummaryCollector
 
-_orig_loader = SummaryCollector.loadAllSummaryData
+_orig_loader = SummaryCollector.loadSummaryMatrix
 
 
 # Define this in the module-scope. If defined as a class-method
@@ -285,7 +285,7 @@ class LibresFacadeTest(TestCase):
 
     @tmpdir(SOURCE_DIR / "test-data/local/snake_oil")
     @patch(
-        "res.enkf.export.SummaryCollector.loadAllSummaryData", wraps=_add_duplicate_row
+        "res.enkf.export.SummaryCollector.loadSummaryMatrix", wraps=_add_duplicate_row
     )
     def test_summary_data_verify_remove_duplicates(self, *args):
         facade = self.facade()
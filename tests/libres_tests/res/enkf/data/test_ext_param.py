@@ -137,3 +137,24 @@ class ExtParamTest(ResTest):
 
         # We don't know what the value is, but it should be possible to read it
         _ = data["key3", "zxc"]
+
+    def test_set_values(self):
+        data = ExtParam(ExtParamConfig("Key", ["key1", "key2"]))
+        data["key1"] = 3
+        data.set_values({"key2": 2.5})
+        self.assertEqual(data["key1"], 3)
+        self.assertEqual(data["key2"], 2.5)
+
+        with self.assertRaises(KeyError):
+            data.set_values({"NoSuchKey": 1})
+
+        data = ExtParam(ExtParamConfig("Key", {"key1": ["a", "b"]}))
+        data["key1", "b"] = 3
+        data.set_values({"key1": {"a": 1}})
+        self.assertEqual(data["key1", "a"], 1)
+        self.assertEqual(data["key1", "b"], 3)
+
+        with self.assertRaises(KeyError):
+            data.set_values({"key1": {"no_such_suffix": 1}})
+        with self.assertRaises(KeyError):
+            data.set_values({"key1": 1})
@@ -1,3 +1,4 @@
+import pandas as pd
 from libres_utils import ResTest
 from pytest import MonkeyPatch
 
@@ -69,3 +70,27 @@ class SummaryCollectorTest(ResTest):
                     ["WWCT:OP1", "WWCT:OP2"],
                     realization_index=non_existing_realization_index,
                 )
+
+    def test_summary_matrix_matches_all_summary_data(self):
+        with ErtTestContext(
+            "python/enkf/export/summary_matrix", self.config
+        ) as context:
+            ert = context.getErt()
+
+            for key in ["FOPR", "WWCT:OP2"]:
+                for realization_index in [None, 10]:
+                    expected = SummaryCollector.loadAllSummaryData(
+                        ert, "default_0", [key], realization_index=realization_index
+                    )
+                    data = SummaryCollector.loadSummaryMatrix(
+                        ert, "default_0", key, realization_index=realization_index
+                    )
+                    pd.testing.assert_frame_equal(data, expected, check_dtype=False)
+
+            assert SummaryCollector.loadSummaryMatrix(
+                ert, "default_0", "NOT_A_KEY"
+            ).empty
+            with pytest.raises(IndexError):
+                SummaryCollector.loadSummaryMatrix(
+                    ert, "default_0", "FOPR", realization_index=150
+                )
@@ -175,6 +175,32 @@ def test_update(setup_case, module, expected_gen_kw):
     assert target_gen_kw == pytest.approx(expected_gen_kw)
 
 
+def test_update_single_precision(setup_case):
+    res_config = setup_case("local/snake_oil", "snake_oil.ert")
+
+    ert = EnKFMain(res_config)
+    es_update = ESUpdate(ert)
+    ert.analysisConfig().selectModule("STD_ENKF")
+    fsm = ert.getEnkfFsManager()
+    sim_fs = fsm.getFileSystem("default_0")
+    conf = ert.ensembleConfig()["SNAKE_OIL_PARAM"]
+
+    target_gen_kw = {}
+    for single_precision in [False, True]:
+        ert.rng().setState("ABCDEFGHIJ012345")
+        target_fs = fsm.getFileSystem(f"target_{single_precision}")
+        run_context = ErtRunContext.ensemble_smoother_update(sim_fs, target_fs)
+        es_update.smootherUpdate(run_context, single_precision=single_precision)
+
+        target_node = EnkfNode(conf)
+        target_node.load(target_fs, NodeId(0, 0))
+        target_gen_kw[single_precision] = list(target_node.asGenKw())
+
+    assert target_gen_kw[True] == pytest.approx(
+        target_gen_kw[False], rel=1e-5, abs=1e-6
+    )
+
+
 @pytest.mark.parametrize(
     "expected_target_gen_kw",
     [
@@ -0,0 +1,20 @@
+import numpy as np
+import pytest
+
+from res._lib import node_codec
+
+
+@pytest.mark.parametrize("codec", ["none", "zlib+shuffle"])
+def test_non_contiguous_arrays_are_encoded_in_c_order(codec):
+    matrix = np.arange(24, dtype=np.float64).reshape(4, 6)
+    for view in [matrix.T, matrix[:, ::2], np.asfortranarray(matrix)]:
+        result = np.empty(view.shape, dtype=view.dtype)
+        node_codec.decode(node_codec.encode(view, codec), result)
+        assert np.array_equal(result, view)
+
+
+def test_decoding_into_non_contiguous_arrays_is_rejected():
+    matrix = np.arange(24, dtype=np.float64).reshape(4, 6)
+    payload = node_codec.encode(matrix.T, "none")
+    with pytest.raises(ValueError):
+        node_codec.decode(payload, np.empty((4, 6)).T)
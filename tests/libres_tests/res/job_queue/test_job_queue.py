@@ -6,7 +6,7 @@ from pathlib import Path
 from dataclasses import dataclass
 from threading import BoundedSemaphore
 from typing import Any, Dict, Optional
-from unittest.mock import patch
+from unittest.mock import PropertyMock, patch
 
 from res._lib.model_callbacks import LoadStatus
 
@@ -161,6 +161,56 @@ def test_add_jobs(tmpdir):
         job.wait_for()
 
 
+@pytest.mark.timeout(20)
+@pytest.mark.asyncio
+async def test_wait_for_change_async(tmpdir):
+    # pylint: disable=protected-access
+    os.chdir(tmpdir)
+    job_queue = create_local_queue(SIMPLE_SCRIPT)
+    generation = job_queue._get_generation()
+    assert not await job_queue._wait_for_change_async(generation, timeout=0.1)
+
+    pool_sema = BoundedSemaphore(value=10)
+    start_all(job_queue, pool_sema)
+    assert await job_queue._wait_for_change_async(generation, timeout=10)
+
+    for job in job_queue.job_list:
+        job.wait_for()
+
+
+@pytest.mark.timeout(60)
+@pytest.mark.asyncio
+async def test_execute_queue_async_coalesces_published_changes(tmpdir):
+    os.chdir(tmpdir)
+    job_queue = create_local_queue(SIMPLE_SCRIPT)
+    job_queue.publish_interval = 0.5
+    pool_sema = BoundedSemaphore(value=10)
+
+    loop = asyncio.get_running_loop()
+    start_time = loop.time()
+    with patch.object(
+        JobQueue, "_publish_changes", new_callable=AsyncMock
+    ) as publish_changes:
+        await job_queue.execute_queue_async(
+            ws_uri="ws://example.org",
+            ee_id="",
+            pool_sema=pool_sema,
+            evaluators=[],
+        )
+    elapsed = loop.time() - start_time
+
+    # The first and last publishings are whole snapshots; in between the
+    # changes of all the jobs are merged into at most one publishing per
+    # publish_interval
+    num_rounds = publish_changes.call_count - 2
+    assert num_rounds <= elapsed / job_queue.publish_interval + 1
+    for publish_call in publish_changes.call_args_list[1:-1]:
+        assert publish_call.args[1]
+    assert publish_changes.call_args.args[1] == {
+        iens: str(JobStatusType.JOB_QUEUE_SUCCESS) for iens in range(10)
+    }
+
+
 def test_failing_jobs(tmpdir):
     os.chdir(tmpdir)
     job_queue = create_local_queue(FAILING_SCRIPT, max_submit=1)
@@ -187,6 +237,51 @@ def test_failing_jobs(tmpdir):
         assert job_queue.snapshot()[iens] == str(JobStatusType.JOB_QUEUE_FAILED)
 
 
+def test_array_submission(tmpdir):
+    os.chdir(tmpdir)
+    job_queue = create_local_queue(SIMPLE_SCRIPT)
+
+    # The first max_running waiting jobs are submitted as one array, in queue
+    # order
+    assert job_queue.submit_waiting_array() == 5
+    statuses = [job.status for job in job_queue.job_list]
+    assert statuses == 5 * [JobStatusType.JOB_QUEUE_SUBMITTED] + 5 * [
+        JobStatusType.JOB_QUEUE_WAITING
+    ]
+
+    pool_sema = BoundedSemaphore(value=10)
+    with patch.object(
+        Driver, "supports_job_array", new_callable=PropertyMock, return_value=True
+    ):
+        job_queue.execute_queue(pool_sema, None)
+
+    for job in job_queue.job_list:
+        assert job.status == JobStatusType.JOB_QUEUE_SUCCESS
+        assert job.submit_attempt == 1
+
+
+def test_changes_after_transition_drains_status_changes(tmpdir):
+    os.chdir(tmpdir)
+    job_queue = create_local_queue(SIMPLE_SCRIPT)
+    assert job_queue.changes_after_transition() == {}
+
+    assert job_queue.submit_waiting_array() == 5
+    assert job_queue.changes_after_transition() == {
+        iens: str(JobStatusType.JOB_QUEUE_SUBMITTED) for iens in range(5)
+    }
+    assert job_queue.changes_after_transition() == {}
+
+    pool_sema = BoundedSemaphore(value=10)
+    with patch.object(
+        Driver, "supports_job_array", new_callable=PropertyMock, return_value=True
+    ):
+        job_queue.execute_queue(pool_sema, None)
+
+    success = {iens: str(JobStatusType.JOB_QUEUE_SUCCESS) for iens in range(10)}
+    assert job_queue.changes_after_transition() == success
+    assert job_queue.snapshot() == success
+
+
 def test_timeout_jobs(tmpdir):
     os.chdir(tmpdir)
     job_numbers = set()
@@ -0,0 +1,52 @@
+import os
+
+import pytest
+
+from res.config import ConfigParser, UnrecognizedEnum
+
+
+@pytest.fixture(name="large_config")
+def fixture_large_config(tmp_path):
+    include_count = 50
+    keyword_count = 1000
+    for include in range(include_count):
+        (tmp_path / f"include_{include}.ert").write_text(
+            "\n".join(
+                f"KEY_{include}_{keyword} <ARG> value_{keyword} "
+                f'"quoted {keyword}" -- comment'
+                for keyword in range(keyword_count)
+            )
+        )
+    config = tmp_path / "config.ert"
+    config.write_text(
+        "DEFINE <ARG> argument\n"
+        + "\n".join(f"INCLUDE include_{i}.ert" for i in range(include_count))
+    )
+    return config
+
+
+def parse(config):
+    content = ConfigParser().parse(
+        str(config), unrecognized=UnrecognizedEnum.CONFIG_UNRECOGNIZED_ADD
+    )
+    assert content.isValid()
+
+
+def touch_all(config):
+    for path in config.parent.iterdir():
+        stat = path.stat()
+        os.utime(path, ns=(stat.st_atime_ns, stat.st_mtime_ns + 1))
+
+
+def test_config_parse_tokenize(benchmark, large_config):
+    benchmark.pedantic(
+        parse,
+        args=(large_config,),
+        setup=lambda: touch_all(large_config),
+        rounds=5,
+    )
+
+
+def test_config_parse_snapshot(benchmark, large_config):
+    parse(large_config)
+    benchmark(parse, large_config)
@@ -0,0 +1,23 @@
+import random
+
+import pytest
+
+from res._lib import gen_common
+
+
+@pytest.fixture(name="gen_data_file")
+def fixture_gen_data_file(tmp_path):
+    size = 1_000_000
+    path = tmp_path / "gen_data_0.out"
+    path.write_text("\n".join(str(random.uniform(-1e3, 1e3)) for _ in range(size)))
+    return str(path), size
+
+
+def test_gen_data_load_fscanf(benchmark, gen_data_file):
+    path, size = gen_data_file
+    assert benchmark(gen_common.fscanf_load, path) == size
+
+
+def test_gen_data_load_fparse(benchmark, gen_data_file):
+    path, size = gen_data_file
+    assert benchmark(gen_common.fparse_load, path) == size
@@ -10,7 +10,9 @@ def test_load_from_context(benchmark, template_config):
         expected_reals = template_config["reals"]
         realisations = [True] * expected_reals
         run_context = ert.getRunContextENSEMPLE_EXPERIMENT(load_into, realisations)
-        loaded_reals = benchmark(ert.loadFromRunContext, run_context, load_into)
+        loaded_reals = benchmark(
+            ert.loadFromRunContext, run_context, load_into, force=True
+        )
         assert loaded_reals == expected_reals
 
 
@@ -21,5 +23,7 @@ def test_load_from_fs(benchmark, template_config):
         load_from = ert.getEnkfFsManager().getFileSystem("default")
         expected_reals = template_config["reals"]
         realisations = [True] * expected_reals
-        loaded_reals = benchmark(ert.loadFromForwardModel, realisations, 0, load_from)
+        loaded_reals = benchmark(
+            ert.loadFromForwardModel, realisations, 0, load_from, force=True
+        )
         assert loaded_reals == expected_reals
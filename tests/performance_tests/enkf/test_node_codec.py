@@ -0,0 +1,41 @@
+import numpy as np
+import pytest
+
+from res._lib import node_codec
+
+CODECS = ["zlib", "zlib+shuffle", "none", "lz", "lz+shuffle"]
+
+
+@pytest.fixture(name="payload", params=["field", "summary"])
+def fixture_payload(request):
+    rng = np.random.default_rng(42)
+    if request.param == "field":
+        # A porosity like FIELD on a 100 x 100 x 50 grid: smooth trends in
+        # float32 with a little noise.
+        x, y, z = np.meshgrid(
+            np.linspace(0, 1, 100),
+            np.linspace(0, 1, 100),
+            np.linspace(0, 1, 50),
+            indexing="ij",
+        )
+        field = 0.2 + 0.05 * np.sin(6 * x) * np.cos(4 * y) - 0.02 * z
+        return (field + rng.normal(0, 0.002, field.shape)).astype(np.float32)
+
+    # 200 SUMMARY vectors with 2000 report steps each: cumulative rates,
+    # which are monotone and smooth.
+    rates = np.abs(rng.normal(1000, 100, (200, 2000)))
+    return np.cumsum(rates, axis=1)
+
+
+@pytest.mark.parametrize("codec", CODECS)
+def test_node_codec_encode(benchmark, payload, codec):
+    encoded = benchmark(node_codec.encode, payload, codec)
+    benchmark.extra_info["ratio"] = len(encoded) / payload.nbytes
+
+
+@pytest.mark.parametrize("codec", CODECS)
+def test_node_codec_decode(benchmark, payload, codec):
+    encoded = node_codec.encode(payload, codec)
+    result = np.empty_like(payload)
+    benchmark(node_codec.decode, encoded, result)
+    assert np.array_equal(result, payload)
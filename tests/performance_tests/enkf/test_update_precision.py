@@ -0,0 +1,52 @@
+import json
+import subprocess
+import sys
+
+import pytest
+
+# Runs in a fresh interpreter so that the peak RSS is that of one update
+UPDATE_SCRIPT = """
+import json, resource, sys, time
+import numpy as np
+from res._lib import update
+
+rows, reals, dtype = int(sys.argv[1]), int(sys.argv[2]), sys.argv[3]
+rng = np.random.default_rng(42)
+X = np.identity(reals) + rng.normal(0, 0.03, (reals, reals))
+A = np.empty((rows, reals), dtype=dtype, order="F")
+for column in range(reals):
+    A[:, column] = rng.normal(0.2, 0.02, rows)
+
+start = time.perf_counter()
+if A.dtype == np.float32:
+    update.multiply(A, X)
+else:
+    A = A @ X
+seconds = time.perf_counter() - start
+
+peak_rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss * 1024
+print(json.dumps({"seconds": seconds, "peak_rss": peak_rss}))
+"""
+
+
+@pytest.mark.parametrize(
+    "rows",
+    [
+        pytest.param(100_000, marks=pytest.mark.quick_only),
+        pytest.param(2_000_000, marks=pytest.mark.slow),
+    ],
+)
+@pytest.mark.parametrize("dtype", ["float64", "float32"])
+def test_update_precision(benchmark, rows, dtype):
+    def run_update():
+        output = subprocess.run(
+            [sys.executable, "-c", UPDATE_SCRIPT, str(rows), "100", dtype],
+            check=True,
+            capture_output=True,
+            text=True,
+        ).stdout
+        return json.loads(output)
+
+    result = benchmark.pedantic(run_update, rounds=3)
+    benchmark.extra_info["update_seconds"] = result["seconds"]
+    benchmark.extra_info["peak_rss_mb"] = result["peak_rss"] / 2**20